@@ -2,4 +2,5 @@ set(BJ2020_BIN_DIR bin)
 set(BJ2020_LIB_DIR libs)
 set(BJ2020_SOURCE_DIR src)
 set(BJ2020_INCLUDE_DIR include)
-set(BJ2020_TEST_DIR tests)
\ No newline at end of file
+set(BJ2020_TEST_DIR tests)
+set(BJ2020_MESSAGES_DIR messages)
\ No newline at end of file
@@ -1,12 +1,82 @@
 # Linking sources
-add_library(ABSTRACT_BLACKJACK_SOURCE ${BJ2020_SOURCE_DIR}/AbstractBlackjack.cpp)
-add_library(APPLICATION_SOURCE ${BJ2020_SOURCE_DIR}/Application.cpp)
+add_library(ABSTRACT_BLACKJACK_SOURCE
+        ${BJ2020_SOURCE_DIR}/AbstractBlackjack.cpp
+        ${BJ2020_SOURCE_DIR}/RankCountShoe.cpp
+        ${BJ2020_SOURCE_DIR}/ActionMenu.cpp)
+add_library(BLACKJACK_RULES_SOURCE ${BJ2020_SOURCE_DIR}/BlackjackRules.cpp)
+add_library(APPLICATION_SOURCE
+        ${BJ2020_SOURCE_DIR}/Application.cpp
+        ${BJ2020_SOURCE_DIR}/MessageCatalog.cpp)
 add_library(BOX_SOURCE ${BJ2020_SOURCE_DIR}/Box.cpp)
 add_library(CARD_SOURCE ${BJ2020_SOURCE_DIR}/Card.cpp)
 add_library(PLAYER_SOURCE ${BJ2020_SOURCE_DIR}/Player.cpp)
 add_library(DEALER_SOURCE ${BJ2020_SOURCE_DIR}/Dealer.cpp)
+add_library(SIMULATION_RESULT_SOURCE
+        ${BJ2020_SOURCE_DIR}/SimulationResult.cpp
+        ${BJ2020_SOURCE_DIR}/Snapshot.cpp)
+add_library(STRATEGY_TABLE_SOURCE
+        ${BJ2020_SOURCE_DIR}/StrategyTable.cpp
+        ${BJ2020_SOURCE_DIR}/StrategyTableFile.cpp)
+add_library(SIDE_BET_SOURCE
+        ${BJ2020_SOURCE_DIR}/ShoeComposition.cpp
+        ${BJ2020_SOURCE_DIR}/PerfectPairsSideBet.cpp
+        ${BJ2020_SOURCE_DIR}/TwentyOnePlusThreeSideBet.cpp
+        ${BJ2020_SOURCE_DIR}/LuckyLadiesSideBet.cpp)
+add_library(INPUT_LATENCY_SOURCE
+        ${BJ2020_SOURCE_DIR}/InputLatencyHistogram.cpp
+        ${BJ2020_SOURCE_DIR}/InputLatencyRecorder.cpp)
+add_library(METRICS_SOURCE
+        ${BJ2020_SOURCE_DIR}/MetricsRegistry.cpp
+        ${BJ2020_SOURCE_DIR}/MetricsServer.cpp)
+add_library(ACTION_SOURCE
+        ${BJ2020_SOURCE_DIR}/HitBlackjackAction.cpp
+        ${BJ2020_SOURCE_DIR}/StandBlackjackAction.cpp
+        ${BJ2020_SOURCE_DIR}/DoubleBlackjackAction.cpp
+        ${BJ2020_SOURCE_DIR}/InsuranceBlackjackAction.cpp
+        ${BJ2020_SOURCE_DIR}/SplitBlackjackAction.cpp
+        ${BJ2020_SOURCE_DIR}/SwitchHandBlackjackAction.cpp
+        ${BJ2020_SOURCE_DIR}/LateSurrenderBlackjackAction.cpp
+        ${BJ2020_SOURCE_DIR}/EarlySurrenderBlackjackAction.cpp)
+add_library(DEALER_BATCH_SOURCE ${BJ2020_SOURCE_DIR}/DealerBatch.cpp)
+add_library(DISPLAY_SOURCE
+        ${BJ2020_SOURCE_DIR}/StructuredDisplayHandler.cpp
+        ${BJ2020_SOURCE_DIR}/DisplayMessageParamDealerCards.cpp
+        ${BJ2020_SOURCE_DIR}/DisplayMessageParamPlayerCards.cpp)
+add_library(CONSOLE_DISPLAY_SOURCE
+        ${BJ2020_SOURCE_DIR}/ConsoleDisplayHandler.cpp
+        ${BJ2020_SOURCE_DIR}/ConsoleDisplayEntity.cpp)
+add_library(HAND_HISTORY_SOURCE
+        ${BJ2020_SOURCE_DIR}/HandHistory.cpp
+        ${BJ2020_SOURCE_DIR}/HandHistoryWriter.cpp
+        ${BJ2020_SOURCE_DIR}/HandHistoryReader.cpp)
+target_link_libraries(HAND_HISTORY_SOURCE BLACKJACK_RULES_SOURCE)
+add_library(REPLAY_SOURCE
+        ${BJ2020_SOURCE_DIR}/AmericanBlackjack.cpp
+        ${BJ2020_SOURCE_DIR}/SimulationBlackjack.cpp
+        ${BJ2020_SOURCE_DIR}/ReplayBlackjack.cpp
+        ${BJ2020_SOURCE_DIR}/BasicStrategy.cpp)
+add_library(SIMULATOR_SOURCE
+        ${BJ2020_SOURCE_DIR}/Simulator.cpp
+        ${BJ2020_SOURCE_DIR}/SimulationStatsWriter.cpp
+        ${BJ2020_SOURCE_DIR}/EuropeanBlackjack.cpp)
 
 # Including test sources
 include(cmake/tests/ApplicationUnitTest.cmake)
 include(cmake/tests/AbstractBlackjackUnitTest.cmake)
-include(cmake/tests/BoxUnitTest.cmake)
\ No newline at end of file
+include(cmake/tests/BoxUnitTest.cmake)
+include(cmake/tests/SpscRingBufferUnitTest.cmake)
+include(cmake/tests/ConsoleDisplayHandlerUnitTest.cmake)
+include(cmake/tests/SimulationResultUnitTest.cmake)
+include(cmake/tests/HandHistoryUnitTest.cmake)
+include(cmake/tests/ReplayBlackjackUnitTest.cmake)
+include(cmake/tests/SimulatorUnitTest.cmake)
+include(cmake/tests/StrategyTableUnitTest.cmake)
+include(cmake/tests/BlackjackRulesUnitTest.cmake)
+include(cmake/tests/SideBetUnitTest.cmake)
+include(cmake/tests/MetricsUnitTest.cmake)
+include(cmake/tests/InputLatencyUnitTest.cmake)
+include(cmake/tests/ShuffleQualityUnitTest.cmake)
+include(cmake/tests/RankCountShoeUnitTest.cmake)
+include(cmake/tests/DealerBatchUnitTest.cmake)
+include(cmake/tests/MessageCatalogUnitTest.cmake)
+include(cmake/tests/StructuredDisplayHandlerUnitTest.cmake)
\ No newline at end of file
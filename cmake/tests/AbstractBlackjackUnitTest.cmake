@@ -4,11 +4,16 @@ add_executable(ABSTRACT_BLACKJACK_UNIT_TEST ${BJ2020_TEST_DIR}/AbstractBlackjack
 # Adding array source
 target_link_libraries(ABSTRACT_BLACKJACK_UNIT_TEST
         APPLICATION_SOURCE
+        INPUT_LATENCY_SOURCE
         ABSTRACT_BLACKJACK_SOURCE
+        BLACKJACK_RULES_SOURCE
+        HAND_HISTORY_SOURCE
         PLAYER_SOURCE
         DEALER_SOURCE
         BOX_SOURCE
-        CARD_SOURCE)
+        CARD_SOURCE
+        ACTION_SOURCE
+        METRICS_SOURCE)
 
 # Standard linking to gtest stuff
 target_link_libraries(ABSTRACT_BLACKJACK_UNIT_TEST gmock gtest gtest_main)
\ No newline at end of file
@@ -0,0 +1,8 @@
+# Adding test case executable
+add_executable(BLACKJACK_RULES_UNIT_TEST ${BJ2020_TEST_DIR}/BlackjackRulesUnitTest.cpp)
+
+# Adding array source
+target_link_libraries(BLACKJACK_RULES_UNIT_TEST BLACKJACK_RULES_SOURCE)
+
+# Standard linking to gtest stuff
+target_link_libraries(BLACKJACK_RULES_UNIT_TEST gmock gtest gtest_main)
\ No newline at end of file
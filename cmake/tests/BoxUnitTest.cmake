@@ -4,7 +4,10 @@ add_executable(BOX_UNIT_TEST ${BJ2020_TEST_DIR}/BoxUnitTest.cpp)
 # Adding array source
 target_link_libraries(BOX_UNIT_TEST
         APPLICATION_SOURCE
+        INPUT_LATENCY_SOURCE
         ABSTRACT_BLACKJACK_SOURCE
+        BLACKJACK_RULES_SOURCE
+        HAND_HISTORY_SOURCE
         PLAYER_SOURCE
         DEALER_SOURCE
         BOX_SOURCE
@@ -0,0 +1,8 @@
+# Adding test case executable
+add_executable(CONSOLE_DISPLAY_HANDLER_UNIT_TEST ${BJ2020_TEST_DIR}/ConsoleDisplayHandlerUnitTest.cpp)
+
+# Adding array source
+target_link_libraries(CONSOLE_DISPLAY_HANDLER_UNIT_TEST CONSOLE_DISPLAY_SOURCE CARD_SOURCE)
+
+# Standard linking to gtest stuff
+target_link_libraries(CONSOLE_DISPLAY_HANDLER_UNIT_TEST gmock gtest gtest_main)
\ No newline at end of file
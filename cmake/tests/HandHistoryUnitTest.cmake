@@ -0,0 +1,10 @@
+# Adding test case executable
+add_executable(HAND_HISTORY_UNIT_TEST ${BJ2020_TEST_DIR}/HandHistoryUnitTest.cpp)
+
+# Adding array source
+target_link_libraries(HAND_HISTORY_UNIT_TEST
+        HAND_HISTORY_SOURCE
+        CARD_SOURCE)
+
+# Standard linking to gtest stuff
+target_link_libraries(HAND_HISTORY_UNIT_TEST gmock gtest gtest_main)
\ No newline at end of file
@@ -0,0 +1,8 @@
+# Adding test case executable
+add_executable(INPUT_LATENCY_UNIT_TEST ${BJ2020_TEST_DIR}/InputLatencyUnitTest.cpp)
+
+# Adding array source
+target_link_libraries(INPUT_LATENCY_UNIT_TEST INPUT_LATENCY_SOURCE)
+
+# Standard linking to gtest stuff
+target_link_libraries(INPUT_LATENCY_UNIT_TEST gmock gtest gtest_main)
\ No newline at end of file
@@ -0,0 +1,9 @@
+# Adding test case executable
+add_executable(METRICS_UNIT_TEST ${BJ2020_TEST_DIR}/MetricsUnitTest.cpp)
+
+# Adding array source
+find_package(Threads REQUIRED)
+target_link_libraries(METRICS_UNIT_TEST METRICS_SOURCE INPUT_LATENCY_SOURCE Threads::Threads)
+
+# Standard linking to gtest stuff
+target_link_libraries(METRICS_UNIT_TEST gmock gtest gtest_main)
\ No newline at end of file
@@ -0,0 +1,17 @@
+# Adding test case executable
+add_executable(RANK_COUNT_SHOE_UNIT_TEST ${BJ2020_TEST_DIR}/RankCountShoeUnitTest.cpp)
+
+# Adding array source
+target_link_libraries(RANK_COUNT_SHOE_UNIT_TEST
+        ABSTRACT_BLACKJACK_SOURCE
+        APPLICATION_SOURCE
+        PLAYER_SOURCE
+        INPUT_LATENCY_SOURCE
+        BLACKJACK_RULES_SOURCE
+        HAND_HISTORY_SOURCE
+        DEALER_SOURCE
+        BOX_SOURCE
+        CARD_SOURCE)
+
+# Standard linking to gtest stuff
+target_link_libraries(RANK_COUNT_SHOE_UNIT_TEST gmock gtest gtest_main)
\ No newline at end of file
@@ -0,0 +1,25 @@
+# Adding test case executable
+add_executable(REPLAY_BLACKJACK_UNIT_TEST ${BJ2020_TEST_DIR}/ReplayBlackjackUnitTest.cpp)
+
+# Adding array source
+target_link_libraries(REPLAY_BLACKJACK_UNIT_TEST
+        REPLAY_SOURCE
+        STRATEGY_TABLE_SOURCE
+        APPLICATION_SOURCE
+        INPUT_LATENCY_SOURCE
+        ABSTRACT_BLACKJACK_SOURCE
+        BLACKJACK_RULES_SOURCE
+        HAND_HISTORY_SOURCE
+        PLAYER_SOURCE
+        DEALER_SOURCE
+        BOX_SOURCE
+        CARD_SOURCE
+        ACTION_SOURCE
+        SIDE_BET_SOURCE
+        SIMULATION_RESULT_SOURCE
+        DEALER_BATCH_SOURCE
+        DISPLAY_SOURCE
+        METRICS_SOURCE)
+
+# Standard linking to gtest stuff
+target_link_libraries(REPLAY_BLACKJACK_UNIT_TEST gmock gtest gtest_main)
\ No newline at end of file
@@ -0,0 +1,8 @@
+# Adding test case executable
+add_executable(SIDE_BET_UNIT_TEST ${BJ2020_TEST_DIR}/SideBetUnitTest.cpp)
+
+# Adding array source
+target_link_libraries(SIDE_BET_UNIT_TEST SIDE_BET_SOURCE CARD_SOURCE)
+
+# Standard linking to gtest stuff
+target_link_libraries(SIDE_BET_UNIT_TEST gmock gtest gtest_main)
\ No newline at end of file
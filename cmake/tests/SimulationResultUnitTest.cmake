@@ -0,0 +1,8 @@
+# Adding test case executable
+add_executable(SIMULATION_RESULT_UNIT_TEST ${BJ2020_TEST_DIR}/SimulationResultUnitTest.cpp)
+
+# Adding array source
+target_link_libraries(SIMULATION_RESULT_UNIT_TEST SIMULATION_RESULT_SOURCE)
+
+# Standard linking to gtest stuff
+target_link_libraries(SIMULATION_RESULT_UNIT_TEST gmock gtest gtest_main)
\ No newline at end of file
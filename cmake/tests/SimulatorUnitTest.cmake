@@ -0,0 +1,26 @@
+# Adding test case executable
+add_executable(SIMULATOR_UNIT_TEST ${BJ2020_TEST_DIR}/SimulatorUnitTest.cpp)
+
+# Adding array source
+target_link_libraries(SIMULATOR_UNIT_TEST
+        SIMULATOR_SOURCE
+        REPLAY_SOURCE
+        STRATEGY_TABLE_SOURCE
+        APPLICATION_SOURCE
+        INPUT_LATENCY_SOURCE
+        ABSTRACT_BLACKJACK_SOURCE
+        BLACKJACK_RULES_SOURCE
+        HAND_HISTORY_SOURCE
+        PLAYER_SOURCE
+        DEALER_SOURCE
+        BOX_SOURCE
+        CARD_SOURCE
+        ACTION_SOURCE
+        SIDE_BET_SOURCE
+        SIMULATION_RESULT_SOURCE
+        DEALER_BATCH_SOURCE
+        DISPLAY_SOURCE
+        METRICS_SOURCE)
+
+# Standard linking to gtest stuff
+target_link_libraries(SIMULATOR_UNIT_TEST gmock gtest gtest_main)
\ No newline at end of file
@@ -0,0 +1,5 @@
+# Adding test case executable
+add_executable(SPSC_RING_BUFFER_UNIT_TEST ${BJ2020_TEST_DIR}/SpscRingBufferUnitTest.cpp)
+
+# Standard linking to gtest stuff
+target_link_libraries(SPSC_RING_BUFFER_UNIT_TEST gmock gtest gtest_main)
\ No newline at end of file
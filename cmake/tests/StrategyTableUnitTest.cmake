@@ -0,0 +1,8 @@
+# Adding test case executable
+add_executable(STRATEGY_TABLE_UNIT_TEST ${BJ2020_TEST_DIR}/StrategyTableUnitTest.cpp)
+
+# Adding array source
+target_link_libraries(STRATEGY_TABLE_UNIT_TEST STRATEGY_TABLE_SOURCE BLACKJACK_RULES_SOURCE)
+
+# Standard linking to gtest stuff
+target_link_libraries(STRATEGY_TABLE_UNIT_TEST gmock gtest gtest_main)
\ No newline at end of file
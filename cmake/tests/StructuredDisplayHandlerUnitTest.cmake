@@ -0,0 +1,18 @@
+# Adding test case executable
+add_executable(STRUCTURED_DISPLAY_HANDLER_UNIT_TEST ${BJ2020_TEST_DIR}/StructuredDisplayHandlerUnitTest.cpp)
+
+# Adding array source
+target_link_libraries(STRUCTURED_DISPLAY_HANDLER_UNIT_TEST
+        DISPLAY_SOURCE
+        APPLICATION_SOURCE
+        INPUT_LATENCY_SOURCE
+        ABSTRACT_BLACKJACK_SOURCE
+        BLACKJACK_RULES_SOURCE
+        HAND_HISTORY_SOURCE
+        PLAYER_SOURCE
+        DEALER_SOURCE
+        BOX_SOURCE
+        CARD_SOURCE)
+
+# Standard linking to gtest stuff
+target_link_libraries(STRUCTURED_DISPLAY_HANDLER_UNIT_TEST gmock gtest gtest_main)
\ No newline at end of file
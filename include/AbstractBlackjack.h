@@ -1,45 +1,127 @@
 #pragma once
 
 #include <vector>
+#include <map>
 #include <ctime>
 
 #include "AppTypes.h"
+#include "BlackjackRules.h"
+#include "RulesPolicy.h"
 #include "AbstractBlackjackAction.h"
+#include "ActionMenu.h"
 #include "Box.h"
 #include "Card.h"
 #include "Dealer.h"
 #include "Player.h"
 #include "PlayerBetInputValidator.h"
+#include "DecisionBatch.h"
+#include "PhiloxRng.h"
+#include "RankCountShoe.h"
+#include "HandHistory.h"
+#include "Snapshot.h"
 
 class Application;
 class AbstractBlackjackAction;
+class HandHistoryWriter;
+
+enum HandResult
+{
+    handLose = 1,
+    handTie = 2,
+    handWin = 3,
+    handBlackjack = 4,
+    handBlackjackTie = 5,
+    handBlackjackLose = 6,
+    handBlackjackInsured = 7,
+    handOvertake = 8,
+    handDealerOvertake = 9,
+    handSurrender = 10,
+    handEvenMoney = 11
+};
 
 class AbstractBlackjack
 {
 protected:
-    Application* app;
+    Application* app = nullptr;
 
     std::vector<AbstractBlackjackAction*> actions;
 
+    // BlackjackActionType of each action, AbstractBlackjackAction::customActionType for the others
+    std::vector<u8> actionTypes;
+
+    // Keyed by getAvailableActionMask(), actions are only ever appended so a menu never goes stale.
+    // The rows are rendered in the locale of the first request, clearActionMenus() after switching it.
+    std::map<u32, ActionMenu> actionMenus;
+
     std::vector<Box> boxes;
 
     std::vector<Card> shoe;
 
+    BlackjackRules rules;
+
     Dealer dealer;
 
-    Box* dealerBox;
+    Box* dealerBox = nullptr;
 
     u16 shoeIndex = 0;
 
+    u64 runSeed = AbstractBlackjack::createRunSeed();
+
+    u64 shoeNumber = 0;
+
+    u64 nextShoeNumber = 0;
+
     u8 deckCount = 0;
 
+    // Outside ShoeMode::shoeCards the shoe vector only keeps the dealt cards, they are drawn from rankCountShoe
+    ShoeMode shoeMode = ShoeMode::shoeCards;
+
+    RankCountShoe rankCountShoe;
+
     u8 allowedMaxValueForPlayer = 21;
 
     u8 allowedMaxValueForDealer= 17;
 
     std::vector<u8> insuredBoxIndexes;
 
+    std::vector<u8> surrenderedBoxIndexes;
+
+    // Optional log of played rounds, the round being played is collected in handHistoryRound
+    HandHistoryWriter* handHistoryWriter = nullptr;
+
+    HandHistoryRound handHistoryRound;
+
+    static constexpr u8 snapshotVersion = 2;
+
+    // Players the boxes are created for
+    virtual std::vector<Player>& getSeatedPlayers();
+
+    void addAction(AbstractBlackjackAction*);
+
+    std::vector<u8> getActionIndexes(u32 actionMask) const;
+
+    virtual HandResult resolveHand(Box*, u8 boxIndex, u32& winCash);
+
+    void recordRoundStart();
+
+    void recordAction(Box&, u8 actionIndex);
+
+    void recordInsuranceCollected();
+
+    void recordRoundHands();
+
+    void recordRoundFinish();
+
 public:
+    AbstractBlackjack() = default;
+
+    // The table owns its actions and the dealer box
+    AbstractBlackjack(const AbstractBlackjack&) = delete;
+
+    AbstractBlackjack& operator=(const AbstractBlackjack&) = delete;
+
+    virtual ~AbstractBlackjack();
+
     virtual void prepareGame() = 0;
 
     virtual void playGame() = 0;
@@ -48,10 +130,34 @@ public:
 
     void assignApp(Application*);
 
-    std::vector<u8> getAvailableActionIndexes(Box&); // untestable
+    // Availability of every action in one pass: built-in actions are read from getActionMask(),
+    // only custom ones are asked through isAvailable(). Bit i stands for the action of index i.
+    u32 getAvailableActionMask(Box&);
+
+    std::vector<u8> getAvailableActionIndexes(Box&);
 
     std::vector<std::string> getActionNames(const std::vector<u8>&); // untestable
 
+    // Menu of the actions available for the box, its option rows are rendered on the first request only
+    ActionMenu& getActionMenu(Box&);
+
+    void clearActionMenus();
+
+    HandFacts getHandFacts(Box&);
+
+    void appendToDecisionBatch(DecisionBatch&, Box&);
+
+    // Mask of the built-in actions available with the facts, bit i stands for BlackjackActionType i.
+    // Rules is a RulesPolicy or BlackjackRules.
+    template <typename Rules>
+    static u8 getActionMask(const HandFacts&, const Rules&);
+
+    static void evaluateActionMasks(DecisionBatch&);
+
+    // getActionMask() evaluated lane by lane
+    template <typename Rules>
+    static void evaluateActionMasks(DecisionBatch&, const Rules&);
+
     std::vector<Box>& getBoxes();
 
     u8 getBoxIndex(Box&) const;
@@ -62,6 +168,20 @@ public:
 
     std::vector<Card>& shuffleShoe();
 
+    void setShoeMode(ShoeMode);
+
+    ShoeMode getShoeMode() const;
+
+    static u64 createRunSeed();
+
+    void setRunSeed(u64);
+
+    u64 getRunSeed() const;
+
+    void setNextShoeNumber(u64);
+
+    u64 getShoeNumber() const;
+
     bool shouldShoeBeReassembled(u8 playerCount);
 
     Card* getNextCard();
@@ -76,15 +196,109 @@ public:
 
     std::vector<Card*>& getDealerCards();
 
+    virtual void drawDealerCards();
+
+    HandResult settleHand(Box*, u8 boxIndex, u32& winCash);
+
     virtual u32 payToPlayerForBlackjack(Box*);
 
     virtual u32 payToPlayerForCommonWin(Box*);
 
     virtual u32 returnToPlayerItsBet(Box*);
 
+    virtual u32 returnToPlayerHalfItsBet(Box*);
+
+    virtual void setRules(const BlackjackRules&);
+
+    const BlackjackRules& getRules() const;
+
+    // Cards the dealer gets before the players act: the upcard and the hole card, if the rules have one
+    u8 getInitialDealerCardCount() const;
+
+    void setHandHistoryWriter(HandHistoryWriter*);
+
+    // Complete state of the table: the shoe and its stream, players' cash, boxes with their cards and bets, insurances.
+    // Taken between rounds or in the middle of one, a restored table plays on exactly as the original would have.
+    virtual void writeSnapshot(SnapshotWriter&);
+
+    virtual void readSnapshot(SnapshotReader&);
+
+    // Insurance before the dealer checks for blackjack: the upcard is an ace and the box has its first two cards
+    bool canInsureBox(Box&);
+
+    // Executes and records the insurance action for the box
+    void insureBox(Box&);
+
+    // Takes the insurances of a round without dealer blackjack, insured boxes are left with their original bets
+    void collectInsurances();
+
+    // Original bet of a box whose stake holds an insurance of half of it
+    static u32 getUninsuredBet(u32 insuredBet);
+
     void addInsuredBoxIndex(u8);
 
     bool hasInsuredBoxIndex(u8) const;
 
+    void addSurrenderedBoxIndex(u8);
+
+    bool hasSurrenderedBoxIndex(u8) const;
+
     static void clearMessageParamList(std::vector<std::vector<ADisplayMessageParam*>>& messageParamList); // untestable
-};
\ No newline at end of file
+};
+
+template <typename Rules>
+u8 AbstractBlackjack::getActionMask(const HandFacts& facts, const Rules& rules)
+{
+    u8 isTwoCardHand = facts.cardCount == 2;
+    u8 isFirstDecision = (facts.handCount == 1) & isTwoCardHand;
+    u8 minDoubleValue = rules.doubleRule == DoubleRule::doubleTenToEleven ? 10 : 9;
+    u8 isDoubleValue = (rules.doubleRule == DoubleRule::doubleAnyTwo) |
+        ((facts.handValue >= minDoubleValue) & (facts.handValue <= 11));
+    u8 canDouble = (isFirstDecision | (rules.doubleAfterSplit & isTwoCardHand)) & isDoubleValue;
+    u8 canSplit = (facts.pairValue != 0) & (facts.handCount < rules.maxSplitHands) &
+        (rules.resplitAces | (facts.pairValue != 11) | (facts.handCount == 1));
+    u8 canLateSurrender = isFirstDecision & (rules.surrender == SurrenderRule::surrenderLate);
+    u8 canEarlySurrender = isFirstDecision & (rules.surrender == SurrenderRule::surrenderEarly);
+
+    return (1 << hitAction) | (1 << standAction) |
+        ((canDouble & facts.canAffordBet) << doubleAction) |
+        ((isFirstDecision & facts.insurableHand & facts.canAffordInsurance) << insuranceAction) |
+        ((canSplit & facts.canAffordBet) << splitAction) |
+        ((facts.playableHandCount > 1) << switchHandAction) |
+        (canLateSurrender << lateSurrenderAction) |
+        (canEarlySurrender << earlySurrenderAction);
+}
+
+template <typename Rules>
+void AbstractBlackjack::evaluateActionMasks(DecisionBatch& batch, const Rules& rules)
+{
+    u16 size = batch.size();
+
+    batch.actionMasks.resize(size);
+
+    const u8* handValues = batch.handValues.data();
+    const u8* cardCounts = batch.cardCounts.data();
+    const u8* handCounts = batch.handCounts.data();
+    const u8* playableHandCounts = batch.playableHandCounts.data();
+    const u8* pairValues = batch.pairValues.data();
+    const u8* insurableHands = batch.insurableHands.data();
+    const u8* canAffordBet = batch.canAffordBet.data();
+    const u8* canAffordInsurance = batch.canAffordInsurance.data();
+    u8* actionMasks = batch.actionMasks.data();
+
+    for (u16 index = 0; index < size; index++)
+    {
+        HandFacts facts;
+
+        facts.handValue = handValues[index];
+        facts.cardCount = cardCounts[index];
+        facts.handCount = handCounts[index];
+        facts.playableHandCount = playableHandCounts[index];
+        facts.pairValue = pairValues[index];
+        facts.insurableHand = insurableHands[index];
+        facts.canAffordBet = canAffordBet[index];
+        facts.canAffordInsurance = canAffordInsurance[index];
+
+        actionMasks[index] = AbstractBlackjack::getActionMask(facts, rules);
+    }
+}
\ No newline at end of file
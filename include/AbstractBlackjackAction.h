@@ -4,6 +4,7 @@
 
 #include "AbstractBlackjack.h"
 
+class AbstractBlackjack;
 class Box;
 
 class AbstractBlackjackAction
@@ -16,9 +17,20 @@ public:
         : blackjack{blackjack}
     {}
 
+    virtual ~AbstractBlackjackAction() = default;
+
 	virtual std::string	getName() = 0;
 
 	virtual bool execute(Box*) = 0;
 
     virtual bool isAvailable(Box*) = 0;
+
+    // Built-in actions return their BlackjackActionType, AbstractBlackjack then takes their availability from
+    // its action mask instead of calling isAvailable(). A subclass overriding isAvailable() returns customActionType.
+    virtual u8 getActionType()
+    {
+        return AbstractBlackjackAction::customActionType;
+    }
+
+    static constexpr u8 customActionType = 0xFF;
 };
\ No newline at end of file
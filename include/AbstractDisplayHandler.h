@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include <map>
 
 #include "AbstractDisplayEntity.h"
@@ -18,10 +19,12 @@ protected:
 //    std::map<std::string, u16> arrLastIndexes = {};
 
 public:
-    std::string processText(const std::string& text, const std::vector<ADisplayMessageParam*>& params) const
+    virtual ~AbstractDisplayHandler() = default;
+
+    std::string processText(std::string_view text, const std::vector<ADisplayMessageParam*>& params) const
     {
         unsigned int pos;
-        std::string _text = text, _strKey, _arrKey;
+        std::string _text(text), _strKey, _arrKey;
 
         // Searching for string vars
         for (const auto& kv : params)
@@ -81,6 +84,13 @@ public:
 	virtual void display(T*, std::vector<ADisplayMessageParam*>) const = 0;
     virtual void displayBatch(std::vector<T*>, std::vector<std::vector<ADisplayMessageParam*>>) const = 0;
 
+    // The text displayBatch() would show, for messages rendered once and displayed many times
+    virtual std::string renderBatch(std::vector<T*>, std::vector<std::vector<ADisplayMessageParam*>>) const = 0;
+
+    // Blocks until everything passed to display()/displayBatch() has reached the output
+    virtual void flush() const
+    {}
+
     virtual void transformCardListEntity(ADisplayMessageParam*, std::vector<Card*>&) = 0;
     virtual void transformCardListEntities(ADisplayMessageParam*, std::vector<std::vector<Card*>>&, u8 currentHand) = 0;
 };
\ No newline at end of file
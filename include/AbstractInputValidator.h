@@ -8,6 +8,16 @@
 #include "AppTypes.h"
 #include "AppAliasDisplayMessageParam.h"
 
+// What a validator asks the player for, input timings are kept apart per kind
+enum InputKind
+{
+    inputName = 0,
+    inputStartCash = 1,
+    inputBet = 2,
+    inputAction = 3,
+    inputOption = 4
+};
+
 class AbstractInputValidator
 {
 protected:
@@ -25,6 +35,8 @@ public:
         }
     }
 
+	virtual InputKind getInputKind() const = 0;
+
 	virtual std::vector<ADisplayMessageParam*> getErrorMessageParams() = 0;
 
 	virtual std::vector<ADisplayMessageParam*> getRequestMessageParams() = 0;
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+
+#include "AppTypes.h"
+#include "Card.h"
+#include "ShoeComposition.h"
+
+// Side bet placed before the deal and decided by the player's first two cards and the dealer's first two.
+// Under a rule without a hole card the dealer's second card is the one drawn after the players have acted.
+class AbstractSideBet
+{
+public:
+    virtual ~AbstractSideBet() = default;
+
+    virtual std::string getName() const = 0;
+
+    // Winnings per unit staked, 0 when the stake is lost
+    virtual u16 getPayout(const Card& playerCard1, const Card& playerCard2,
+        const Card& dealerUpcard, const Card& dealerSecondCard) const = 0;
+
+    // Exact expected value per unit staked of a bet placed before the next deal from the given cards.
+    // Cards going to other boxes first are unseen, so the bet's cards are as good as the next ones drawn.
+    virtual f64 getExpectedValue(const ShoeComposition&) const = 0;
+};
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "AppTypes.h"
+#include "AppAliasDisplayMessageParam.h"
+
+// What the action prompt shows whatever the cards are: the legal actions, their option rows rendered into one
+// message, the request and the error message. AbstractBlackjack::getActionMenu() builds one per distinct set of
+// legal actions, so a decision only builds and renders the card rows.
+class ActionMenu
+{
+protected:
+    std::vector<u8> actionIndexes;
+
+    std::vector<std::string> actionNames;
+
+    std::vector<ADisplayMessageParam*> optionParams;
+
+    std::vector<ADisplayMessageParam*> requestParams;
+
+    std::vector<ADisplayMessageParam*> errorParams;
+
+public:
+    ActionMenu(std::vector<u8> actionIndexes, std::vector<std::string> actionNames, const std::string& optionName,
+               std::string renderedOptions);
+    ~ActionMenu();
+
+    ActionMenu(const ActionMenu&) = delete;
+    ActionMenu& operator=(const ActionMenu&) = delete;
+
+    ActionMenu(ActionMenu&&) = default;
+
+    const std::vector<u8>& getActionIndexes() const;
+
+    std::vector<std::string>& getActionNames();
+
+    // The params are owned by the menu, they live as long as the AbstractBlackjack it belongs to
+    const std::vector<ADisplayMessageParam*>& getOptionParams() const;
+
+    const std::vector<ADisplayMessageParam*>& getRequestParams() const;
+
+    const std::vector<ADisplayMessageParam*>& getErrorParams() const;
+};
\ No newline at end of file
@@ -3,25 +3,53 @@
 #include <string>
 
 #include "OptionInputValidator.h"
+#include "ActionMenu.h"
 #include "DisplayMessageParamDealerCards.h"
 #include "DisplayMessageParamPlayerCards.h"
 #include "Card.h"
 
 class ActionSelectInputValidator: public OptionInputValidator
 {
+protected:
+    ActionMenu& menu;
+
 public:
-    ActionSelectInputValidator(u8 optionCount, std::string optionName, std::vector<std::string>& options,
-                               Box& dealerBox, Box& playerBox, bool hideSecondDealerCard = true)
-        : OptionInputValidator(optionCount, optionName, options)
+    // Only the card rows are created here, the option rows and the prompts come rendered from the menu
+    ActionSelectInputValidator(ActionMenu& menu, Box& dealerBox, Box& playerBox, bool hideSecondDealerCard = true)
+        : OptionInputValidator("Action", menu.getActionNames()), menu{menu}
+    {
+        this->additionalMessageParams = {
+            {
+                new ADisplayMessageParam("id", "mes_id_info_dealer_cards"),
+                new DisplayMessageParamDealerCards("cards", "", dealerBox.getHandCards(), hideSecondDealerCard)
+            },
+            {
+                new ADisplayMessageParam("id", "mes_id_info_player_cards"),
+                new ADisplayMessageParam("name", playerBox.getPlayer().getName()),
+                new DisplayMessageParamPlayerCards("cards", "", playerBox.getAllCards(), playerBox.getCurrentHandNumber())
+            },
+            menu.getOptionParams()
+        };
+    }
+
+    ~ActionSelectInputValidator()
+    {
+        // The option rows belong to the menu, the base destructor deletes the card rows only
+        this->additionalMessageParams.pop_back();
+    }
+
+    InputKind getInputKind() const override
+    {
+        return InputKind::inputAction;
+    }
+
+    std::vector<ADisplayMessageParam*> getErrorMessageParams() override
+    {
+        return this->menu.getErrorParams();
+    }
+
+    std::vector<ADisplayMessageParam*> getRequestMessageParams() override
     {
-        this->additionalMessageParams.insert(this->additionalMessageParams.begin(), {
-            new ADisplayMessageParam("id", "mes_id_info_dealer_cards"),
-            new DisplayMessageParamDealerCards("cards", "", dealerBox.getHandCards(), hideSecondDealerCard)
-        });
-        this->additionalMessageParams.insert(this->additionalMessageParams.begin() + 1, {
-            new ADisplayMessageParam("id", "mes_id_info_player_cards"),
-            new ADisplayMessageParam("name", playerBox.getPlayer().getName()),
-            new DisplayMessageParamPlayerCards("cards", "", playerBox.getAllCards(), playerBox.getCurrentHandNumber())
-        });
+        return this->menu.getRequestParams();
     }
 };
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "AppTypes.h"
+
+// Heap allocations made by the calling thread.
+// Counting is done by the global operator new replacement in AllocationCounter.cpp, which is only compiled
+// with BJ2020_PROFILE_ALLOCATIONS; otherwise both counters stay zero.
+class AllocationCounter
+{
+public:
+    static u64 getCount();
+
+    static u64 getBytes();
+
+    static void add(u64 bytes);
+};
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <map>
 #include <numeric>
+#include <string>
 
 #include "AbstractBlackjack.h"
 #include "OptionInputValidator.h"
@@ -11,11 +12,23 @@
 #include "InsuranceBlackjackAction.h"
 #include "SplitBlackjackAction.h"
 #include "SwitchHandBlackjackAction.h"
+#include "LateSurrenderBlackjackAction.h"
+#include "EarlySurrenderBlackjackAction.h"
 
 class AmericanBlackjack: public AbstractBlackjack
 {
 protected:
-    const u8 deckCount = 6;
+    // Written after every round while the game goes on and removed when it's over
+    std::string checkpointPath;
+
+    SnapshotWriter checkpointWriter;
+
+    bool isRestored = false;
+
+    void writeCheckpoint();
+
+    // Asks every box that can insure before the dealer peeks, players with a blackjack are offered even money
+    void offerInsurances();
 
 public:
     AmericanBlackjack();
@@ -25,4 +38,9 @@ public:
     void playGame() override;
 
     void finishGame() override;
+
+    void setCheckpointPath(const std::string&);
+
+    // Restores the players and the table saved in the checkpoint file, returns false when there is none
+    bool restoreCheckpoint();
 };
\ No newline at end of file
@@ -13,6 +13,7 @@ class AbstractBlackjack;
 #include "PlayerNameInputValidator.h"
 #include "PlayerStartCashInputValidator.h"
 #include "CardsDisplayEntity.h"
+#include "MessageCatalog.h"
 
 #include "AppAliases.h"
 
@@ -23,23 +24,44 @@ protected:
 
     AInputHandler inputHandler;
 
-    ADisplayHandler displayHandler;
+    AbstractDisplayHandler<ADisplayEntity>& displayHandler;
 
     std::map<std::string, ADisplayEntity*> displayEntityList;
 
+    const MessageCatalog* messageCatalog = nullptr;
+
+    // Entities over the catalog templates, locale after locale in the order of the catalog's messages
+    std::vector<ADisplayEntity> catalogEntities;
+
+    u16 localeIndex = 0;
+
     std::vector<Player> players;
 
+    // Entities of the messages, the param values transformed for display
+    std::vector<ADisplayEntity*> prepareMessages(std::vector<std::vector<ADisplayMessageParam*>>& messageParamList) const;
+
 public:
-    Application(AbstractBlackjack& game, AInputHandler& inputHandler, ADisplayHandler& displayHandler);
+    Application(AbstractBlackjack& game, AInputHandler& inputHandler, AbstractDisplayHandler<ADisplayEntity>& displayHandler);
 
-    ADisplayHandler& getDisplayHandler();
+    AbstractDisplayHandler<ADisplayEntity>& getDisplayHandler();
 
     void addMessageEntity(const std::string& key, ADisplayEntity* entity);
 
+    // Messages of the catalog take precedence over the added entities, the catalog must outlive the application
+    void setMessageCatalog(const MessageCatalog*);
+
+    // Switching only selects another row of entities, the templates are never copied; rendered action menus are dropped
+    void setLocale(const std::string& locale);
+
+    ADisplayEntity* getMessageEntity(const std::string& messageId) const;
+
     void displayMessage(std::vector<ADisplayMessageParam*> params) const;
 
     void displayMessages(std::vector<std::vector<ADisplayMessageParam*>> messageParamList) const;
 
+    // The text displayMessages() would show, without showing it
+    std::string renderMessages(std::vector<std::vector<ADisplayMessageParam*>> messageParamList) const;
+
     template <typename TType>
     TType requestInput(AbstractInputValidator& validator)
     {
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "AppTypes.h"
+#include "DecisionBatch.h"
+#include "StrategyTable.h"
+
+// Basic strategy chart for the American game (multi-deck, dealer stands on 17, no double after split)
+class BasicStrategy
+{
+protected:
+    // Low nibble is the preferred action, high nibble is the fallback when the preferred one is not available
+    u8 handTable[2][22][12] = {};
+
+    // 1 if the pair of the given card value should be split against the given upcard
+    u8 pairTable[12][12] = {};
+
+    void setHandRow(bool soft, u8 value, const char* row);
+
+    void setPairRow(u8 cardValue, const char* row);
+
+public:
+    BasicStrategy();
+
+    // Strategy derived from precomputed expected values, e.g. a mapped StrategyTableFile
+    explicit BasicStrategy(const StrategyTableData&);
+
+    u8 decide(u8 handValue, bool soft, u8 pairValue, u8 dealerUpcard, u8 actionMask) const;
+
+    void decideBatch(DecisionBatch& batch) const;
+
+    // Identifies the chart, e.g. in simulation checkpoints
+    u64 getHash() const;
+};
+
+inline u8 BasicStrategy::decide(u8 handValue, bool soft, u8 pairValue, u8 dealerUpcard, u8 actionMask) const
+{
+    u8 entry = this->handTable[soft][handValue > 21 ? 21 : handValue][dealerUpcard];
+    u8 preferred = entry & 0x0F;
+    u8 choice = (actionMask >> preferred) & 1 ? preferred : entry >> 4;
+    u8 split = this->pairTable[pairValue][dealerUpcard] & (actionMask >> splitAction) & 1;
+
+    return split ? (u8) splitAction : choice;
+}
\ No newline at end of file
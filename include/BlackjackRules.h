@@ -0,0 +1,77 @@
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "AppTypes.h"
+
+enum DoubleRule
+{
+    doubleAnyTwo = 0,
+    doubleNineToEleven = 1,
+    doubleTenToEleven = 2
+};
+
+enum SurrenderRule
+{
+    surrenderNone = 0,
+    surrenderLate = 1,      // after the dealer has checked for blackjack, void against one the dealer didn't check for
+    surrenderEarly = 2      // before the dealer checks, against a blackjack too
+};
+
+// Rule configuration of a table, read at run time.
+// Hot paths that are compiled for a fixed rule set take a RulesPolicy instead, see RulesPolicy.h.
+// getHash() identifies a configuration in precomputed table files.
+//
+// A rules file has one "key = value" per line, '#' starts a comment and keys left out keep their defaults:
+//   deck_count = 6                 blackjack_payout = 3:2          double = any | 9-11 | 10-11
+//   dealer_hits_soft_17 = false    double_after_split = false      max_split_hands = 4
+//   resplit_aces = true            surrender = none | late | early dealer_peeks = false
+//   hole_card = true               penetration = 0.75
+struct BlackjackRules
+{
+    u8 deckCount = 6;
+
+    bool dealerHitsSoft17 = false;
+
+    // Blackjack pays blackjackPayoutNumerator to blackjackPayoutDenominator
+    u8 blackjackPayoutNumerator = 3;
+
+    u8 blackjackPayoutDenominator = 2;
+
+    DoubleRule doubleRule = DoubleRule::doubleAnyTwo;
+
+    bool doubleAfterSplit = false;
+
+    // Most hands a box can be split into, the hand history has room for 16
+    u8 maxSplitHands = 16;
+
+    bool resplitAces = true;
+
+    SurrenderRule surrender = SurrenderRule::surrenderNone;
+
+    // Without a hole card check, doubled and split stakes are lost to a dealer blackjack as well
+    bool dealerPeeks = false;
+
+    // Without a hole card the dealer takes the second card only after the players have acted, as in the European game
+    bool dealerHoleCard = true;
+
+    // Share of the shoe dealt before it is reassembled, it doesn't change the strategy and is left out of the hash
+    f32 penetration = 0.75;
+
+    u64 getHash() const;
+
+    bool isDoubleAllowed(u8 handValue) const;
+
+    // Parsed once at startup, throws std::invalid_argument naming the line of a bad entry
+    static BlackjackRules readFromFile(const std::string& path);
+
+    static BlackjackRules read(std::istream&);
+
+    void write(std::ostream&) const;
+
+    bool operator==(const BlackjackRules&) const;
+
+    bool operator!=(const BlackjackRules&) const;
+};
\ No newline at end of file
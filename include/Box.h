@@ -2,17 +2,25 @@
 
 #include <vector>
 #include <algorithm>
+#include <stdexcept>
 
 #include "Player.h"
 #include "Card.h"
+#include "HandState.h"
+#include "Snapshot.h"
 
 class Box
 {
 protected:
+    static constexpr u8 maxHandValue = 21;
+
     Player* player;
 
 	std::vector<std::vector<Card*>> hands = {};
 
+    // HandState of every hand, advanced as the cards are given
+    std::vector<u8> handStates = {};
+
     std::vector<u32> bets = {0};
 
     u8 allowedMaxValue = 21;
@@ -30,6 +38,10 @@ public:
 
     void giveCard(Card*);
 
+    // Takes back the last card of the active hand. Cards must be added and removed through the box,
+    // not through getHandCards(), to keep the hand state in step
+    void removeLastCard();
+
     std::vector<std::vector<Card*>>& getAllCards();
 
     std::vector<Card*>& getHandCards();
@@ -40,8 +52,13 @@ public:
 
     u8 getHandCardsCount();
 
+    u8 getHandState() const;
+
+    // Best total of the active hand, 22 for any bust
     u8 getHandCardsValue();
 
+    bool isHandSoft();
+
     bool isAllowedMaxValueReached();
 
     void switchHand(u8);
@@ -56,9 +73,17 @@ public:
 
     std::vector<u8> getPlayableHandNumbers();
 
+    // Size of getPlayableHandNumbers(), without building the list
+    u8 getPlayableHandCount() const;
+
     bool isBoxInSplit();
 
     bool hasBlackjack();
 
     bool hasOvertake(bool = false);
+
+    // Cards are written as their positions in the shoe they were dealt from
+    void writeSnapshot(SnapshotWriter&, const Card* shoe) const;
+
+    void readSnapshot(SnapshotReader&, Card* shoe, u16 shoeSize);
 };
\ No newline at end of file
@@ -40,9 +40,11 @@ public:
 
 	u8 getCardValue();
 
+	u8 getCardNumber() const;
+
 	CardFace getCardFace();
 
-    CardSuit getCardSuit();
+    CardSuit getCardSuit() const;
 
     static u8 getMinAceCardValue();
 
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "AppAliases.h"
 
@@ -13,8 +14,8 @@ protected:
     std::vector<Card*> cards;
 
 public:
-    CardsDisplayEntity(std::string value)
-        : ADisplayEntity(std::move(value))
+    CardsDisplayEntity(std::string_view value)
+        : ADisplayEntity(value)
     {}
 
     void setCardsToDisplay(ADisplayHandler& displayHandler, const std::vector<Card*> cards);
@@ -1,11 +1,11 @@
 #pragma once
 
-#include <string>
-#include <utility>
+#include <string_view>
 
 #include "AbstractDisplayEntity.h"
 
-class ConsoleDisplayEntity: public AbstractDisplayEntity<std::string>
+// The text is not copied, it must outlive the entity: a literal or a template of a MessageCatalog
+class ConsoleDisplayEntity: public AbstractDisplayEntity<std::string_view>
 {
 protected:
     bool endLine;
@@ -13,13 +13,13 @@ protected:
     bool pause;
 
 public:
-    ConsoleDisplayEntity(std::string value, bool endLine = true, bool pause = false)
-        : AbstractDisplayEntity(std::move(value)), endLine{endLine}, pause{pause}
+    ConsoleDisplayEntity(std::string_view value, bool endLine = true, bool pause = false)
+        : AbstractDisplayEntity(value), endLine{endLine}, pause{pause}
     {}
 
-    std::string& getDisplayEntity() override;
+    std::string_view& getDisplayEntity() override;
 
-    void setDisplayEntity(std::string) override;
+    void setDisplayEntity(std::string_view) override;
 
     bool hasEndLine() const;
 
@@ -3,22 +3,58 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <atomic>
+#include <thread>
 
 #include "AbstractDisplayHandler.h"
 #include "ConsoleDisplayEntity.h"
+#include "ConsoleRenderEvent.h"
+#include "SpscRingBuffer.h"
 #include "AppAliasDisplayMessageParam.h"
 
 class ConsoleDisplayHandler: public AbstractDisplayHandler<ConsoleDisplayEntity>
 {
 protected:
+    static const u16 renderQueueCapacity = 64;
+
+    bool asyncRendering;
+
+    RenderBackpressure backpressure;
+
+    mutable SpscRingBuffer<ConsoleRenderEvent, renderQueueCapacity> renderQueue;
+
+    mutable ConsoleRenderEvent coalescedEvent;
+
+    mutable bool hasCoalescedEvent = false;
+
+    mutable u32 droppedEventCount = 0;
+
+    std::atomic<bool> rendering{false};
+
+    std::thread renderThread;
+
     void clearConsole() const;
     void pauseConsole() const;
 
+    void render(const ConsoleRenderEvent&) const;
+    void publish(std::string& text, bool pause) const;
+    bool tryPublish(std::string& text, bool pause) const;
+    void renderLoop();
+
 public:
-    ConsoleDisplayHandler();
+    explicit ConsoleDisplayHandler(bool asyncRendering = false, RenderBackpressure backpressure = RenderBackpressure::block);
+    ~ConsoleDisplayHandler();
+
+    ConsoleDisplayHandler(const ConsoleDisplayHandler&) = delete;
+    ConsoleDisplayHandler& operator=(const ConsoleDisplayHandler&) = delete;
 
     void display(ConsoleDisplayEntity*, std::vector<ADisplayMessageParam*>) const override;
     void displayBatch(std::vector<ConsoleDisplayEntity*>, std::vector<std::vector<ADisplayMessageParam*>>) const override;
+    std::string renderBatch(std::vector<ConsoleDisplayEntity*>, std::vector<std::vector<ADisplayMessageParam*>>) const override;
+
+    void flush() const override;
+
+    u32 getDroppedEventCount() const;
 
     void transformCardListEntity(ADisplayMessageParam*, std::vector<Card*>&) override;
     void transformCardListEntities(ADisplayMessageParam*, std::vector<std::vector<Card*>>&, u8 currentHand) override;
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+// What the game thread does when the render queue is full
+enum RenderBackpressure
+{
+    block = 1,      // wait for the renderer to free a slot
+    drop = 2,       // discard the new frame
+    coalesce = 3    // keep only the newest pending frame until a slot is free
+};
+
+struct ConsoleRenderEvent
+{
+    std::string text;
+
+    bool pause = false;
+};
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+
+#include "AppTypes.h"
+
+enum DealerKernel
+{
+    dealerKernelScalar = 0,
+    dealerKernelAvx2 = 1,       // 8 lanes
+    dealerKernelAvx512 = 2      // 16 lanes
+};
+
+// Structure-of-arrays dealer hands of independent tables, played out together once the players are done.
+// A lane holds the dealer's hand state and the ranks of the cards next in its table's shoe; drawing out
+// counts how many of them the dealer takes, exactly as the scalar AbstractBlackjack::drawDealerCards() loop would.
+class DealerBatch
+{
+protected:
+    std::vector<u8> states;
+
+    // Lane after lane, maxDrawCount upcoming ranks each, padded for the 4-byte gathers of the last lane
+    std::vector<u8> upcomingRanks;
+
+    std::vector<u8> drawCounts;
+
+    static void drawOutScalar(DealerBatch&, bool hitsSoft17, u16 fromLane);
+
+    static u16 drawOutAvx2(DealerBatch&, bool hitsSoft17);
+
+    static u16 drawOutAvx512(DealerBatch&, bool hitsSoft17);
+
+public:
+    // A dealer hand can't take more cards than this: from one card on, drawing to 17 with the smallest ones
+    static constexpr u8 maxDrawCount = 24;
+
+    static constexpr u8 gatherPadding = 3;
+
+    void reserve(u16 laneCount);
+
+    void clear();
+
+    // Ranks as in HandState, only the first maxDrawCount are looked at. A shoe that ends earlier is padded with
+    // 10-valued cards; the cards are then taken with AbstractBlackjack::getNextCard(), which throws at the end of the shoe.
+    void appendLane(u8 state, const u8* ranks, u16 rankCount);
+
+    u16 size() const;
+
+    u8 getState(u16 lane) const;
+
+    u8 getDrawCount(u16 lane) const;
+
+    // Fastest kernel the CPU runs
+    static DealerKernel getBestKernel();
+
+    static bool isKernelSupported(DealerKernel);
+
+    static void drawOut(DealerBatch&, bool hitsSoft17);
+
+    static void drawOut(DealerBatch&, bool hitsSoft17, DealerKernel);
+};
\ No newline at end of file
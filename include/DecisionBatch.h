@@ -0,0 +1,131 @@
+#pragma once
+
+#include <vector>
+
+#include "AppTypes.h"
+
+class Box;
+
+// Indexes of the built-in actions, in the order AmericanBlackjack registers them
+enum BlackjackActionType
+{
+    hitAction = 0,
+    standAction = 1,
+    doubleAction = 2,
+    insuranceAction = 3,
+    splitAction = 4,
+    switchHandAction = 5,
+    lateSurrenderAction = 6,
+    earlySurrenderAction = 7
+};
+
+// Everything the built-in actions' availability depends on, gathered in one pass over a box and the dealer.
+// A lane of DecisionBatch holds the same facts.
+struct HandFacts
+{
+    u8 handValue = 0;
+
+    u8 softHand = 0;
+
+    u8 pairValue = 0;       // card value of a splittable pair, 0 otherwise
+
+    u8 cardCount = 0;
+
+    u8 handCount = 0;
+
+    u8 playableHandCount = 0;
+
+    u8 dealerUpcard = 0;
+
+    u8 insurableHand = 0;
+
+    u8 canAffordBet = 0;
+
+    u8 canAffordInsurance = 0;
+};
+
+// Structure-of-arrays state of pending hands, filled by AbstractBlackjack::appendToDecisionBatch().
+// One lane per hand waiting for a decision, possibly from several tables at once.
+class DecisionBatch
+{
+public:
+    std::vector<Box*> boxes;
+
+    std::vector<u8> handValues;
+
+    std::vector<u8> softHands;
+
+    std::vector<u8> pairValues; // card value of a splittable pair, 0 otherwise
+
+    std::vector<u8> cardCounts;
+
+    std::vector<u8> handCounts;
+
+    std::vector<u8> playableHandCounts;
+
+    std::vector<u8> dealerUpcards;
+
+    std::vector<u8> insurableHands;
+
+    std::vector<u8> canAffordBet;
+
+    std::vector<u8> canAffordInsurance;
+
+    std::vector<u8> actionMasks;
+
+    std::vector<u8> decisions;
+
+    void reserve(u16 size)
+    {
+        this->boxes.reserve(size);
+        this->handValues.reserve(size);
+        this->softHands.reserve(size);
+        this->pairValues.reserve(size);
+        this->cardCounts.reserve(size);
+        this->handCounts.reserve(size);
+        this->playableHandCounts.reserve(size);
+        this->dealerUpcards.reserve(size);
+        this->insurableHands.reserve(size);
+        this->canAffordBet.reserve(size);
+        this->canAffordInsurance.reserve(size);
+        this->actionMasks.reserve(size);
+        this->decisions.reserve(size);
+    }
+
+    void append(Box* box, const HandFacts& facts)
+    {
+        this->boxes.push_back(box);
+        this->handValues.push_back(facts.handValue);
+        this->softHands.push_back(facts.softHand);
+        this->pairValues.push_back(facts.pairValue);
+        this->cardCounts.push_back(facts.cardCount);
+        this->handCounts.push_back(facts.handCount);
+        this->playableHandCounts.push_back(facts.playableHandCount);
+        this->dealerUpcards.push_back(facts.dealerUpcard);
+        this->insurableHands.push_back(facts.insurableHand);
+        this->canAffordBet.push_back(facts.canAffordBet);
+        this->canAffordInsurance.push_back(facts.canAffordInsurance);
+    }
+
+    void clear()
+    {
+        this->boxes.clear();
+        this->handValues.clear();
+        this->softHands.clear();
+        this->pairValues.clear();
+        this->cardCounts.clear();
+        this->handCounts.clear();
+        this->playableHandCounts.clear();
+        this->dealerUpcards.clear();
+        this->insurableHands.clear();
+        this->canAffordBet.clear();
+        this->canAffordInsurance.clear();
+        this->actionMasks.clear();
+        this->decisions.clear();
+    }
+
+    u16 size() const
+    {
+        return this->boxes.size();
+    }
+};
\ No newline at end of file
@@ -24,4 +24,7 @@ public:
     {}
 
     void transformValue(Application*) override;
+
+    // With the second card hidden once the value is transformed
+    const std::vector<Card*>& getCards() const;
 };
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <utility>
+#include <string>
+#include <vector>
+
+#include "AppAliasDisplayMessageParam.h"
+
+// Option rows rendered into the value, the option names are kept for handlers that don't show text
+class DisplayMessageParamOptions: public ADisplayMessageParam
+{
+protected:
+    std::vector<std::string> options;
+
+public:
+    DisplayMessageParamOptions(std::string key, std::string value, std::vector<std::string> options)
+        : ADisplayMessageParam(std::move(key), std::move(value)), options{std::move(options)}
+    {}
+
+    const std::vector<std::string>& getOptions() const
+    {
+        return this->options;
+    }
+};
\ No newline at end of file
@@ -22,4 +22,8 @@ public:
     {}
 
     void transformValue(Application*) override;
+
+    const std::vector<std::vector<Card*>>& getCards() const;
+
+    u8 getCurrentHand() const;
 };
\ No newline at end of file
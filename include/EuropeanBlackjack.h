@@ -0,0 +1,17 @@
+#pragma once
+
+#include "AmericanBlackjack.h"
+
+// European table: the dealer has no hole card and takes the second card only after all players have acted,
+// so doubled and split stakes are lost to a dealer blackjack and no insurance is offered.
+// The round itself is the American one, the rules decide how many cards the dealer starts with.
+class EuropeanBlackjack: public AmericanBlackjack
+{
+public:
+    EuropeanBlackjack();
+
+    void setRules(const BlackjackRules&) override;
+
+    // Any rule set played without a hole card
+    static BlackjackRules toEuropeanRules(BlackjackRules);
+};
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <vector>
+
+#include "AppTypes.h"
+#include "Card.h"
+
+// Pseudo-action of a round's action list: the insurances of a round without dealer blackjack were collected
+constexpr u8 handHistoryInsuranceCollected = 0xFF;
+
+// Round flag: the dealer had no hole card and took the second card after the players
+constexpr u8 handHistoryNoHoleCard = 0x01;
+
+// Round flag: surrender was early, so it held against a dealer blackjack
+constexpr u8 handHistoryEarlySurrender = 0x02;
+
+struct HandHistoryAction
+{
+    u8 boxIndex = 0;
+
+    u8 handNumber = 1;
+
+    u8 action = 0;
+
+    bool operator==(const HandHistoryAction& other) const
+    {
+        return this->boxIndex == other.boxIndex && this->handNumber == other.handNumber && this->action == other.action;
+    }
+};
+
+struct HandHistoryHand
+{
+    u8 boxIndex = 0;
+
+    u8 handNumber = 1;
+
+    u8 result = 0;
+
+    u32 bet = 0;
+
+    // Cash returned to the player when the hand was settled, stake included
+    u32 payout = 0;
+
+    std::vector<u8> cards;
+};
+
+// One round of one table, as collected by AbstractBlackjack while it is played.
+// The shoe is identified by (seed, shoeNumber), shoeIndex is the position of the round's first card in it.
+struct HandHistoryRound
+{
+    u64 seed = 0;
+
+    u64 shoeNumber = 0;
+
+    u16 shoeIndex = 0;
+
+    u8 insuredBoxMask = 0;
+
+    u8 flags = 0;
+
+    std::vector<u32> initialBets;
+
+    // In the order they were played
+    std::vector<HandHistoryAction> actions;
+
+    std::vector<u8> dealerCards;
+
+    std::vector<HandHistoryHand> hands;
+
+    void clear();
+};
+
+// Zero-copy view of one encoded round.
+// Layout, little-endian and unaligned:
+//   u16 size, u8 boxCount, u8 handCount, u8 dealerCardCount, u8 actionCount, u8 insuredBoxMask, u8 flags,
+//   u64 seed, u32 shoeNumber, u16 shoeIndex, u16 reserved,
+//   u32 initialBets[boxCount], u8 dealerCards[dealerCardCount],
+//   actionCount x {u8 boxIndex << 4 | (handNumber - 1), u8 action},
+//   handCount x {u8 boxIndex, u8 handNumber, u8 result, u8 cardCount, u32 bet, u32 payout, u8 cards[cardCount]}
+class HandHistoryRecord
+{
+public:
+    static constexpr u16 headerSize = 24;
+
+    static constexpr u16 handHeaderSize = 12;
+
+protected:
+    const u8* data = nullptr;
+
+    template <typename T>
+    T readField(u32 offset) const;
+
+    u32 getHandsOffset() const;
+
+public:
+    HandHistoryRecord() = default;
+
+    explicit HandHistoryRecord(const u8* data);
+
+    static u8 encodeCard(Card&);
+
+    static Card decodeCard(u8);
+
+    static void encode(const HandHistoryRound&, std::vector<u8>& output);
+
+    void decode(HandHistoryRound&) const;
+
+    u16 getSize() const;
+
+    u8 getBoxCount() const;
+
+    u8 getHandCount() const;
+
+    u8 getDealerCardCount() const;
+
+    u8 getActionCount() const;
+
+    u8 getInsuredBoxMask() const;
+
+    u8 getFlags() const;
+
+    u64 getSeed() const;
+
+    u64 getShoeNumber() const;
+
+    u16 getShoeIndex() const;
+
+    u32 getInitialBet(u8 boxIndex) const;
+
+    u8 getDealerCard(u8 index) const;
+
+    HandHistoryAction getAction(u8 index) const;
+
+    // Sum of stakes and payouts of all hands
+    u64 getTotalBet() const;
+
+    u64 getTotalPayout() const;
+};
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "AppTypes.h"
+#include "BlackjackRules.h"
+#include "HandHistory.h"
+
+// Maps a hand history log into memory and iterates its records in place.
+// Platforms without mmap read the whole file into a buffer instead.
+class HandHistoryReader
+{
+protected:
+    const u8* data = nullptr;
+
+    u64 size = 0;
+
+    u64 offset = 0;
+
+    std::vector<u8> fallbackBuffer;
+
+    bool isMapped = false;
+
+    BlackjackRules rules;
+
+    void unmap();
+
+public:
+    explicit HandHistoryReader(const std::string& path);
+
+    HandHistoryReader(const HandHistoryReader&) = delete;
+
+    HandHistoryReader& operator=(const HandHistoryReader&) = delete;
+
+    ~HandHistoryReader();
+
+    // Points the record at the next entry, returns false at the end of the log
+    bool next(HandHistoryRecord&);
+
+    void rewind();
+
+    u64 getFileSize() const;
+
+    // Rules the rounds of the log were played under
+    const BlackjackRules& getRules() const;
+};
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "AppTypes.h"
+#include "BlackjackRules.h"
+#include "HandHistory.h"
+
+// Append-only hand history log: a file header followed by HandHistoryRecord entries.
+// The header holds the magic, the version, u32 size of the rules, u64 rules hash and the rules the rounds were played
+// under, so a log is always replayed under its own rules. Records are encoded into a buffer and written out in large blocks.
+class HandHistoryWriter
+{
+public:
+    static constexpr char fileMagic[8] = {'B', 'J', '2', '0', 'H', 'H', 'L', '\0'};
+
+    static constexpr u32 fileVersion = 3;
+
+    static constexpr u16 rulesOffset = 24;
+
+    static constexpr u16 fileHeaderSize = HandHistoryWriter::rulesOffset + sizeof(BlackjackRules);
+
+protected:
+    static constexpr u32 flushThreshold = 1 << 16;
+
+    std::FILE* file = nullptr;
+
+    std::vector<u8> buffer;
+
+    u64 recordCount = 0;
+
+public:
+    // Appending to an existing log recorded under other rules throws std::runtime_error
+    HandHistoryWriter(const std::string& path, const BlackjackRules& rules);
+
+    HandHistoryWriter(const HandHistoryWriter&) = delete;
+
+    HandHistoryWriter& operator=(const HandHistoryWriter&) = delete;
+
+    ~HandHistoryWriter();
+
+    void write(const HandHistoryRound&);
+
+    void flush();
+
+    u64 getRecordCount() const;
+};
\ No newline at end of file
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "AppTypes.h"
+
+// Facts about one hand state, what the rules and the strategy need without looking at the cards
+struct HandStateInfo
+{
+    u8 total = 0;           // best total, 22 for any bust
+
+    bool isSoft = false;
+
+    bool isBlackjack = false;
+
+    bool isBusted = false;
+
+    bool dealerMustDraw = false;         // below 17
+
+    bool dealerMustDrawH17 = false;      // below 17, or soft 17
+};
+
+// States and the compile time construction of their table, see HandState
+class HandStateTableBuilder
+{
+public:
+    static constexpr u8 empty = 0;
+
+    static constexpr u8 firstSingle = 1;    // a single 2, ..., 10, ace
+
+    // Two 2s, ..., two 10-valued cards, two aces. Ranks carry no face, so these states don't tell whether the hand
+    // can be split; pairs are split by face, see AbstractBlackjack::getHandFacts().
+    static constexpr u8 firstPair = 11;
+
+    static constexpr u8 blackjack = 21;
+
+    static constexpr u8 firstHard = 22;     // hard 4 to 21
+
+    static constexpr u8 firstSoft = 40;     // soft 12 to 21
+
+    static constexpr u8 bust = 50;
+
+    static constexpr u8 stateCount = 51;
+
+    // Cards by value: 2, ..., 10, then the ace
+    static constexpr u8 rankCount = 10;
+
+    static constexpr u8 aceRank = 9;
+
+    struct Table
+    {
+        u8 next[stateCount][rankCount] = {};
+
+        HandStateInfo info[stateCount] = {};
+    };
+
+protected:
+    static constexpr u8 getHardState(u8 total)
+    {
+        return HandStateTableBuilder::firstHard + total - 4;
+    }
+
+    static constexpr u8 getSoftState(u8 total)
+    {
+        return HandStateTableBuilder::firstSoft + total - 12;
+    }
+
+    // State of two or more cards that are neither a pair nor blackjack
+    static constexpr u8 getTotalState(u8 hardTotal, bool hasAce)
+    {
+        if (hasAce && hardTotal + 10 <= 21)
+        {
+            return HandStateTableBuilder::getSoftState(hardTotal + 10);
+        }
+
+        return hardTotal > 21 ? HandStateTableBuilder::bust : HandStateTableBuilder::getHardState(hardTotal);
+    }
+
+    static constexpr u8 getRankValue(u8 rank)
+    {
+        return rank == HandStateTableBuilder::aceRank ? 1 : rank + 2;
+    }
+
+    static constexpr Table buildTable()
+    {
+        Table table;
+
+        for (u8 rank = 0; rank < HandStateTableBuilder::rankCount; rank++)
+        {
+            table.next[HandStateTableBuilder::empty][rank] = HandStateTableBuilder::firstSingle + rank;
+            table.next[HandStateTableBuilder::bust][rank] = HandStateTableBuilder::bust;
+        }
+
+        for (u8 first = 0; first < HandStateTableBuilder::rankCount; first++)
+        {
+            u8 single = HandStateTableBuilder::firstSingle + first;
+            u8 pair = HandStateTableBuilder::firstPair + first;
+
+            for (u8 rank = 0; rank < HandStateTableBuilder::rankCount; rank++)
+            {
+                bool hasAce = first == HandStateTableBuilder::aceRank || rank == HandStateTableBuilder::aceRank;
+                bool isBlackjack = hasAce && (first == 8 || rank == 8);
+
+                table.next[single][rank] = first == rank ? pair : isBlackjack ? HandStateTableBuilder::blackjack :
+                    HandStateTableBuilder::getTotalState(HandStateTableBuilder::getRankValue(first) + HandStateTableBuilder::getRankValue(rank), hasAce);
+                table.next[pair][rank] = HandStateTableBuilder::getTotalState(2 * HandStateTableBuilder::getRankValue(first) +
+                    HandStateTableBuilder::getRankValue(rank), hasAce);
+            }
+
+            table.info[single].total = first == HandStateTableBuilder::aceRank ? 11 : first + 2;
+            table.info[single].isSoft = first == HandStateTableBuilder::aceRank;
+
+            table.info[pair].total = first == HandStateTableBuilder::aceRank ? 12 : 2 * (first + 2);
+            table.info[pair].isSoft = first == HandStateTableBuilder::aceRank;
+        }
+
+        for (u8 rank = 0; rank < HandStateTableBuilder::rankCount; rank++)
+        {
+            table.next[HandStateTableBuilder::blackjack][rank] = HandStateTableBuilder::getTotalState(11 + HandStateTableBuilder::getRankValue(rank), true);
+
+            for (u8 total = 4; total <= 21; total++)
+            {
+                // A hard hand holding an ace is at least hard 12, another ace can't make it soft either
+                table.next[HandStateTableBuilder::getHardState(total)][rank] = HandStateTableBuilder::getTotalState(
+                    total + HandStateTableBuilder::getRankValue(rank), rank == HandStateTableBuilder::aceRank);
+            }
+
+            for (u8 total = 12; total <= 21; total++)
+            {
+                table.next[HandStateTableBuilder::getSoftState(total)][rank] = HandStateTableBuilder::getTotalState(
+                    total - 10 + HandStateTableBuilder::getRankValue(rank), true);
+            }
+        }
+
+        table.info[HandStateTableBuilder::blackjack].total = 21;
+        table.info[HandStateTableBuilder::blackjack].isSoft = true;
+        table.info[HandStateTableBuilder::blackjack].isBlackjack = true;
+
+        for (u8 total = 4; total <= 21; total++)
+        {
+            table.info[HandStateTableBuilder::getHardState(total)].total = total;
+        }
+
+        for (u8 total = 12; total <= 21; total++)
+        {
+            table.info[HandStateTableBuilder::getSoftState(total)].total = total;
+            table.info[HandStateTableBuilder::getSoftState(total)].isSoft = true;
+        }
+
+        table.info[HandStateTableBuilder::bust].total = 22;
+        table.info[HandStateTableBuilder::bust].isBusted = true;
+
+        for (u8 state = HandStateTableBuilder::empty; state < HandStateTableBuilder::stateCount; state++)
+        {
+            HandStateInfo& info = table.info[state];
+
+            info.dealerMustDraw = !info.isBlackjack && !info.isBusted && info.total < 17;
+            info.dealerMustDrawH17 = info.dealerMustDraw || (info.isSoft && info.total == 17);
+        }
+
+        return table;
+    }
+
+};
+
+// Every hand a player or the dealer can hold as one small integer: no card, one card, a pair, blackjack,
+// hard 4-21, soft 12-21 and bust. A hand moves to its next state with one load of the transition table
+// per card, the ace logic is only run once, at compile time, to build the table.
+class HandState: public HandStateTableBuilder
+{
+public:
+    static constexpr Table table = HandStateTableBuilder::buildTable();
+
+    // Rank of a card from its blackjack value, the ace may come as 11 or 1
+    static constexpr u8 getRank(u8 cardValue)
+    {
+        return cardValue == 11 || cardValue == 1 ? HandState::aceRank : cardValue - 2;
+    }
+
+    static constexpr u8 getNext(u8 state, u8 rank)
+    {
+        return HandState::table.next[state][rank];
+    }
+
+    static constexpr const HandStateInfo& getInfo(u8 state)
+    {
+        return HandState::table.info[state];
+    }
+
+    static constexpr bool mustDealerDraw(u8 state, bool hitsSoft17)
+    {
+        return hitsSoft17 ? HandState::table.info[state].dealerMustDrawH17 : HandState::table.info[state].dealerMustDraw;
+    }
+};
+
+static_assert(HandState::getNext(HandState::getNext(HandState::empty, HandState::aceRank), 8) == HandState::blackjack,
+    "HandState: ace and ten make blackjack");
+static_assert(HandState::getInfo(HandState::getNext(HandState::getNext(HandState::getNext(HandState::empty,
+    HandState::aceRank), HandState::aceRank), 7)).total == 21, "HandState: A-A-9 is soft 21");
+static_assert(HandState::getInfo(HandState::getNext(HandState::getNext(HandState::empty, 8), 8)).total == 20 &&
+    !HandState::getInfo(HandState::getNext(HandState::getNext(HandState::empty, 8), 8)).isSoft,
+    "HandState: two 10-valued cards are hard 20");
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+
+#include "AppTypes.h"
+
+// Log-linear histogram in the manner of HdrHistogram: values below 32 have a bucket each, above that every
+// power of two is split into 16 buckets, so any recorded value is known within 1/16 of itself.
+// One thread records, others may read at the same time.
+class InputLatencyHistogram
+{
+public:
+    static constexpr u8 subBucketBits = 5;
+
+    static constexpr u8 halfSubBucketCount = 1 << (subBucketBits - 1);
+
+    // Larger values are clamped, in nanoseconds that is over an hour
+    static constexpr u64 maxValue = ((u64) 1 << 42) - 1;
+
+    static constexpr u16 bucketCount = (1 << subBucketBits) + (42 - subBucketBits) * halfSubBucketCount;
+
+protected:
+    std::atomic<u64> buckets[bucketCount] = {};
+
+    std::atomic<u64> count{0};
+
+    std::atomic<u64> sum{0};
+
+    std::atomic<u64> max{0};
+
+    static u16 getBucketIndex(u64 value);
+
+    // The highest value that falls into the bucket
+    static u64 getBucketValue(u16 index);
+
+public:
+    void record(u64 value);
+
+    u64 getCount() const;
+
+    u64 getMax() const;
+
+    f64 getMean() const;
+
+    // Value at or below which the given percent of the recorded values are
+    u64 getValueAtPercentile(f64 percent) const;
+
+    void reset();
+};
\ No newline at end of file
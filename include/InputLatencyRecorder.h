@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <ostream>
+
+#include "AppTypes.h"
+#include "AbstractInputValidator.h"
+#include "InputLatencyHistogram.h"
+
+// Parts of one TemplateInputHandler::requestInput() call
+enum InputPhase
+{
+    inputPhasePrompt = 0,       // rendering the request messages, up to the first read
+    inputPhaseWait = 1,         // inside the adapter, waiting for the player, over all attempts
+    inputPhaseProcessing = 2,   // validation and the error messages after the first read
+    inputPhaseRetries = 3       // rejected values, a count rather than nanoseconds
+};
+
+// Splits every input request into the player's think time and the engine's own time, per input kind.
+// Recorded by the game thread and readable live from any other one.
+class InputLatencyRecorder
+{
+public:
+    static constexpr u8 kindCount = 5;
+
+    static constexpr u8 phaseCount = 4;
+
+protected:
+    InputLatencyHistogram histograms[kindCount][phaseCount];
+
+public:
+    static InputLatencyRecorder& getInstance();
+
+    static const char* getKindName(InputKind);
+
+    static const char* getPhaseName(InputPhase);
+
+    static u64 getDurationNs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+    }
+
+    void record(InputKind kind, InputPhase phase, u64 value)
+    {
+        this->histograms[kind][phase].record(value);
+    }
+
+    const InputLatencyHistogram& getHistogram(InputKind, InputPhase) const;
+
+    void reset();
+
+    // Percentiles of every kind that has been requested, durations in milliseconds
+    void printSummary(std::ostream&) const;
+};
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+
+#include "AbstractBlackjackAction.h"
+
+class LateSurrenderBlackjackAction: public AbstractBlackjackAction
+{
+public:
+    using AbstractBlackjackAction::AbstractBlackjackAction;
+
+	std::string	getName() override;
+
+	bool execute(Box*) override;
+
+	bool isAvailable(Box*) override;
+
+	u8 getActionType() override;
+};
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+
+#include "AbstractSideBet.h"
+
+// Pays on a player's first two cards totalling 20: 1000:1 a pair of queens of hearts against a dealer blackjack,
+// 125:1 a pair of queens of hearts, 19:1 matched (same rank and suit), 9:1 suited, 4:1 any other 20
+class LuckyLadiesSideBet: public AbstractSideBet
+{
+protected:
+    static constexpr u16 queenPairDealerBlackjackPayout = 1000;
+
+    static constexpr u16 queenPairPayout = 125;
+
+    static constexpr u16 matchedPayout = 19;
+
+    static constexpr u16 suitedPayout = 9;
+
+    static constexpr u16 unsuitedPayout = 4;
+
+    static u8 getValue(u8 cardNumber);
+
+    static bool isQueenOfHearts(const Card&);
+
+public:
+    std::string getName() const override;
+
+    u16 getPayout(const Card& playerCard1, const Card& playerCard2,
+        const Card& dealerUpcard, const Card& dealerSecondCard) const override;
+
+    f64 getExpectedValue(const ShoeComposition&) const override;
+};
\ No newline at end of file
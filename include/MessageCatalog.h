@@ -0,0 +1,124 @@
+#pragma once
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "AppTypes.h"
+
+// How a message ends on the console
+enum MessageLayout
+{
+    messageLine = 0,        // ends its line
+    messageInline = 1,      // continued by the next message or the input
+    messagePause = 2        // ends its line and waits for the player
+};
+
+struct MessageCatalogHeader
+{
+    char magic[8];
+
+    u32 version;
+
+    u32 size;
+
+    u16 localeCount;
+
+    u16 messageCount;
+
+    u32 textOffset;
+};
+
+// A string of the text pool: a locale name, a message id or a template
+struct MessageCatalogEntry
+{
+    u32 offset;
+
+    u16 length;
+
+    u8 layout;
+
+    u8 reserved;
+};
+
+static_assert(std::is_trivially_copyable<MessageCatalogHeader>::value, "MessageCatalogHeader must be mappable");
+static_assert(sizeof(MessageCatalogHeader) == 24 && sizeof(MessageCatalogEntry) == 8, "Unexpected catalog layout");
+
+// Message templates of every locale, compiled from a text catalog into one contiguous table.
+// A compiled file holds the header, the locale names, the message ids in sorted order, the templates locale
+// after locale in the order of the ids, then the text pool. It is mapped as is; a text catalog is compiled into memory.
+//
+// The text catalog has a [locale] line before the messages of each locale and a line per message:
+//     <message id> <line|inline|pause> = <template>
+// Every locale defines the same messages, lines starting with # are comments.
+class MessageCatalog
+{
+protected:
+    const u8* data = nullptr;
+
+    u64 size = 0;
+
+    std::vector<u8> fallbackBuffer;
+
+    bool isMapped = false;
+
+    const MessageCatalogHeader* header = nullptr;
+
+    const MessageCatalogEntry* locales = nullptr;
+
+    const MessageCatalogEntry* messageIds = nullptr;
+
+    const MessageCatalogEntry* templates = nullptr;
+
+    MessageCatalog() = default;
+
+    void unmap();
+
+    // Checks the layout of data and points the tables into it
+    void attach(const std::string& name);
+
+    std::string_view getString(const MessageCatalogEntry&) const;
+
+public:
+    static constexpr char fileMagic[8] = {'B', 'J', '2', '0', 'M', 'S', 'G', '\0'};
+
+    static constexpr u32 fileVersion = 1;
+
+    // Maps a compiled catalog
+    explicit MessageCatalog(const std::string& path);
+
+    MessageCatalog(const MessageCatalog&) = delete;
+
+    MessageCatalog& operator=(const MessageCatalog&) = delete;
+
+    ~MessageCatalog();
+
+    // A compiled catalog or a text one, told apart by the file magic
+    static std::unique_ptr<MessageCatalog> open(const std::string& path);
+
+    static std::vector<u8> compile(std::istream& source);
+
+    static std::unique_ptr<MessageCatalog> compileToMemory(std::istream& source);
+
+    static void write(const std::string& path, const std::vector<u8>& compiledData);
+
+    u16 getLocaleCount() const;
+
+    u16 getMessageCount() const;
+
+    std::string_view getLocaleName(u16 localeIndex) const;
+
+    // Index of the locale or the message, -1 when the catalog has none
+    s32 findLocale(std::string_view locale) const;
+
+    s32 findMessage(std::string_view messageId) const;
+
+    std::string_view getMessageId(u16 messageIndex) const;
+
+    std::string_view getTemplate(u16 localeIndex, u16 messageIndex) const;
+
+    MessageLayout getLayout(u16 localeIndex, u16 messageIndex) const;
+};
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "AppTypes.h"
+
+enum MetricCounter
+{
+    metricRounds = 0,
+    metricHands = 1,
+    metricSplits = 2,
+    metricDoubles = 3,
+    metricBusts = 4,
+    metricBlackjacks = 5,
+    metricReshuffles = 6,
+    metricEliminatedPlayers = 7
+};
+
+enum MetricHistogram
+{
+    metricDecisionLatency = 0,
+    metricRoundDuration = 1
+};
+
+// Counters and histograms of one thread. Only the owning thread writes them, so recording is a plain
+// relaxed load and store, the scraping thread reads them with relaxed loads as well.
+struct alignas(64) MetricsShard
+{
+    static constexpr u8 counterCount = 8;
+
+    static constexpr u8 histogramCount = 2;
+
+    // Bucket i holds durations up to 2^i microseconds (1024 ns units), the last one everything above
+    static constexpr u8 bucketCount = 28;
+
+    std::atomic<u64> counters[counterCount] = {};
+
+    std::atomic<u64> buckets[histogramCount][bucketCount] = {};
+
+    std::atomic<u64> sumsNs[histogramCount] = {};
+};
+
+// Process wide metrics. Every thread records into its own shard, shards are summed up when rendered.
+class MetricsRegistry
+{
+protected:
+    static inline thread_local MetricsShard* localShard = nullptr;
+
+    // Shards outlive their threads, a finished thread's counts stay in the totals
+    std::vector<std::unique_ptr<MetricsShard>> shards;
+
+    mutable std::mutex shardsMutex;
+
+    MetricsShard& registerShard();
+
+    static void add(std::atomic<u64>& value, u64 amount)
+    {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    static u8 getBucketIndex(u64 durationNs)
+    {
+        u8 index = 0;
+
+        for (u64 bound = 1 << 10; index < MetricsShard::bucketCount - 1 && durationNs > bound; bound <<= 1)
+        {
+            index++;
+        }
+
+        return index;
+    }
+
+public:
+    static MetricsRegistry& getInstance();
+
+    static const char* getCounterName(MetricCounter);
+
+    static const char* getHistogramName(MetricHistogram);
+
+    void increment(MetricCounter counter, u64 amount = 1)
+    {
+        MetricsShard& shard = localShard ? *localShard : this->registerShard();
+
+        MetricsRegistry::add(shard.counters[counter], amount);
+    }
+
+    void observe(MetricHistogram histogram, u64 durationNs)
+    {
+        MetricsShard& shard = localShard ? *localShard : this->registerShard();
+
+        MetricsRegistry::add(shard.buckets[histogram][MetricsRegistry::getBucketIndex(durationNs)], 1);
+        MetricsRegistry::add(shard.sumsNs[histogram], durationNs);
+    }
+
+    u64 getCounter(MetricCounter) const;
+
+    u64 getHistogramCount(MetricHistogram) const;
+
+    // Prometheus text exposition format 0.0.4
+    void writePrometheus(std::ostream&) const;
+};
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "AppTypes.h"
+#include "MetricsRegistry.h"
+
+// Serves the registry as Prometheus text over HTTP on 127.0.0.1, from its own thread.
+// Every request gets the current values, a collector on the same host scrapes /metrics.
+// /input-latency shows the input latency summary of the game so far.
+class MetricsServer
+{
+protected:
+    MetricsRegistry& registry;
+
+    u16 port;
+
+    int listenSocket = -1;
+
+    std::atomic<bool> serving{false};
+
+    std::thread serveThread;
+
+    void serveLoop();
+
+    void serveClient(int clientSocket);
+
+public:
+    explicit MetricsServer(u16 port, MetricsRegistry& registry = MetricsRegistry::getInstance());
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    // Binds the port and starts serving, throws std::runtime_error when the port can't be bound
+    void start();
+
+    void stop();
+
+    // The bound port, the one picked by the system when constructed with port 0
+    u16 getPort() const;
+};
\ No newline at end of file
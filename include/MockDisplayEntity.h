@@ -1,9 +1,25 @@
 #pragma once
 
+#include <string>
+#include <string_view>
+
 #include "AbstractDisplayEntity.h"
 
 class MockDisplayEntity: public AbstractDisplayEntity<std::string>
 {
 public:
-    using AbstractDisplayEntity::AbstractDisplayEntity;
+    // Takes the arguments of ConsoleDisplayEntity, the text is copied
+    MockDisplayEntity(std::string_view value, bool endLine = true, bool pause = false)
+        : AbstractDisplayEntity(std::string(value))
+    {}
+
+    std::string& getDisplayEntity() override
+    {
+        return this->entity;
+    }
+
+    void setDisplayEntity(std::string value) override
+    {
+        this->entity = value;
+    }
 };
\ No newline at end of file
@@ -12,6 +12,18 @@ public:
     void displayBatch(std::vector<MockDisplayEntity*>, std::vector<std::vector<ADisplayMessageParam*>>) const override
     {}
 
+    std::string renderBatch(std::vector<MockDisplayEntity*> entities, std::vector<std::vector<ADisplayMessageParam*>> params) const override
+    {
+        std::string text;
+
+        for (u16 index = 0; index < entities.size(); index++)
+        {
+            text += this->processText(entities[index]->getDisplayEntity(), params[index]) + "\n";
+        }
+
+        return text;
+    }
+
     void transformCardListEntity(ADisplayMessageParam*, std::vector<Card*>&) override
     {}
 
@@ -14,6 +14,11 @@ protected:
 
     std::vector<std::string>& options;
 
+    // For options whose rows are built by the derived validator
+    OptionInputValidator(std::string optionName, std::vector<std::string>& options)
+        : optionCount(options.size()), optionName{optionName}, options{options}
+    {}
+
 public:
     OptionInputValidator(u16 optionCount, std::string optionName, std::vector<std::string>& options)
         : optionCount{optionCount}, optionName{optionName}, options{options}
@@ -43,6 +48,11 @@ public:
         return this->value;
     }
 
+    InputKind getInputKind() const override
+    {
+        return InputKind::inputOption;
+    }
+
     std::vector<ADisplayMessageParam*> getErrorMessageParams() override
     {
         return {
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+
+#include "AbstractSideBet.h"
+
+// Pays on a pair in the player's first two cards: 25:1 perfect (same suit), 12:1 colored, 6:1 mixed
+class PerfectPairsSideBet: public AbstractSideBet
+{
+protected:
+    static constexpr u16 perfectPairPayout = 25;
+
+    static constexpr u16 coloredPairPayout = 12;
+
+    static constexpr u16 mixedPairPayout = 6;
+
+    static bool isRed(u8 suit);
+
+public:
+    std::string getName() const override;
+
+    u16 getPayout(const Card& playerCard1, const Card& playerCard2,
+        const Card& dealerUpcard, const Card& dealerSecondCard) const override;
+
+    f64 getExpectedValue(const ShoeComposition&) const override;
+};
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "AppTypes.h"
+
+// Counter-based Philox4x32-10 generator (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+// Output is a pure function of (key, counter): the key is the run seed, the upper half of the counter is
+// the stream number (e.g. shoe number) and the lower half counts blocks within the stream.
+// Any stream can therefore be regenerated on its own without replaying the previous ones.
+class PhiloxRng
+{
+protected:
+    static constexpr u32 multiplier0 = 0xD2511F53;
+    static constexpr u32 multiplier1 = 0xCD9E8D57;
+    static constexpr u32 weyl0 = 0x9E3779B9;
+    static constexpr u32 weyl1 = 0xBB67AE85;
+
+    u32 key[2];
+
+    u32 counter[4];
+
+    u32 block[4] = {};
+
+    u8 blockIndex = 4;
+
+public:
+    PhiloxRng(u64 seed, u64 stream)
+        : key{(u32) seed, (u32) (seed >> 32)}, counter{0, 0, (u32) stream, (u32) (stream >> 32)}
+    {}
+
+    static void generateBlock(const u32 counter[4], const u32 key[2], u32 result[4])
+    {
+        u32 ctr[4] = {counter[0], counter[1], counter[2], counter[3]};
+        u32 k0 = key[0], k1 = key[1];
+
+        for (u8 round = 0; round < 10; round++)
+        {
+            u64 product0 = (u64) PhiloxRng::multiplier0 * ctr[0];
+            u64 product1 = (u64) PhiloxRng::multiplier1 * ctr[2];
+
+            ctr[0] = (u32) (product1 >> 32) ^ ctr[1] ^ k0;
+            ctr[1] = (u32) product1;
+            ctr[2] = (u32) (product0 >> 32) ^ ctr[3] ^ k1;
+            ctr[3] = (u32) product0;
+
+            k0 += PhiloxRng::weyl0;
+            k1 += PhiloxRng::weyl1;
+        }
+
+        result[0] = ctr[0];
+        result[1] = ctr[1];
+        result[2] = ctr[2];
+        result[3] = ctr[3];
+    }
+
+    u32 next()
+    {
+        if (this->blockIndex == 4)
+        {
+            PhiloxRng::generateBlock(this->counter, this->key, this->block);
+
+            if (++this->counter[0] == 0)
+            {
+                this->counter[1]++;
+            }
+
+            this->blockIndex = 0;
+        }
+
+        return this->block[this->blockIndex++];
+    }
+
+    // Unbiased number in [0, bound) (Lemire's multiply-and-reject method)
+    u32 nextBounded(u32 bound)
+    {
+        u64 product = (u64) this->next() * bound;
+        u32 low = (u32) product;
+
+        if (low < bound)
+        {
+            u32 threshold = -bound % bound;
+
+            while (low < threshold)
+            {
+                product = (u64) this->next() * bound;
+                low = (u32) product;
+            }
+        }
+
+        return product >> 32;
+    }
+};
\ No newline at end of file
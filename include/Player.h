@@ -26,6 +26,8 @@ public:
 
 	void decreaseCash(u32 amount);
 
+	void setCash(u32 amount);
+
     std::string getName() const;
 
     u32 getCash() const;
@@ -23,6 +23,11 @@ public:
         return this->value;
     }
 
+    InputKind getInputKind() const override
+    {
+        return InputKind::inputBet;
+    }
+
     std::vector<ADisplayMessageParam*> getErrorMessageParams() override
     {
         return {
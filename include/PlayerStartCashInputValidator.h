@@ -17,6 +17,11 @@ public:
 	    return this->value;
     }
 
+    InputKind getInputKind() const override
+    {
+        return InputKind::inputStartCash;
+    }
+
     std::vector<ADisplayMessageParam*> getErrorMessageParams() override
     {
         return {
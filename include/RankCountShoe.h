@@ -0,0 +1,47 @@
+#pragma once
+
+#include "AppTypes.h"
+#include "Card.h"
+#include "HandState.h"
+#include "PhiloxRng.h"
+
+enum ShoeMode
+{
+    shoeCards = 0,          // every card of the shoe in a shuffled vector
+    shoeRankCounts = 1,     // ten rank counters of a finite shoe
+    shoeInfiniteDeck = 2    // fixed rank probabilities, as if the shoe had infinitely many decks
+};
+
+// Shoe without suits: what is left of it is ten counters, one per rank (2, ..., 9, 10-valued, ace),
+// and a card is drawn with the probability of its rank's share of the remaining cards.
+// Nothing is shuffled up front, the draw costs the same whether the shoe is fresh or nearly dealt.
+// In the infinite-deck mode the counters never run down and every draw has the probabilities of a full deck.
+class RankCountShoe
+{
+protected:
+    PhiloxRng rng{0, 0};
+
+    u16 rankCounts[HandState::rankCount] = {};
+
+    u16 remainingCount = 0;
+
+    bool isInfinite = false;
+
+public:
+    // Fresh shoe of deckCount decks, drawn from the stream (seed, stream) of the PhiloxRng
+    void reset(u8 deckCount, bool isInfinite, u64 seed, u64 stream);
+
+    // Rank as in HandState: 0 to 7 for 2 to 9, 8 for any 10-valued card, HandState::aceRank for the ace
+    u8 drawRank();
+
+    // Card standing for the drawn rank: 10-valued cards come as a 10 and every card as a club
+    Card drawCard();
+
+    u16 getRankCount(u8 rank) const;
+
+    u16 getRemainingCount() const;
+
+    bool isInfiniteDeck() const;
+
+    static Card getRankCard(u8 rank);
+};
\ No newline at end of file
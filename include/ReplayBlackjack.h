@@ -0,0 +1,80 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "AmericanBlackjack.h"
+#include "HandHistory.h"
+#include "HandHistoryReader.h"
+
+// Headless American table that re-plays a hand history log through the real actions and settlement.
+// Every round is rebuilt from its shoe (seed, shoe number and position) and recorded actions,
+// then the dealt cards, stakes and payouts are compared with the recorded ones.
+class ReplayBlackjack: public AmericanBlackjack
+{
+protected:
+    static constexpr u32 bankroll = 1000000000;
+
+    static constexpr u8 maxBoxCount = 16;
+
+    static constexpr u16 shoeCacheSize = 256;
+
+    static constexpr u8 maxReportedMismatchCount = 20;
+
+    // Tables of a simulation log interleave their rounds, so recently used shoes are kept shuffled
+    struct CachedShoe
+    {
+        u64 seed = 0;
+
+        u64 shoeNumber = 0;
+
+        bool isValid = false;
+
+        std::vector<Card> cards;
+    };
+
+    std::vector<CachedShoe> shoeCache;
+
+    std::vector<Player> players;
+
+    HandHistoryRound round;
+
+    u64 roundCount = 0;
+
+    u64 handCount = 0;
+
+    u64 mismatchCount = 0;
+
+    std::vector<std::string> mismatches;
+
+    void loadShoe(u64 seed, u64 shoeNumber, u16 shoeIndex);
+
+    void prepareBoxes(u8 boxCount);
+
+    bool compareCards(const std::vector<Card*>&, const std::vector<u8>&);
+
+    void reportMismatch(const std::string&);
+
+    void resetRound();
+
+public:
+    ReplayBlackjack();
+
+    void prepareGame() override;
+
+    void playGame() override;
+
+    void finishGame() override;
+
+    void replay(HandHistoryReader&);
+
+    bool replayRound(const HandHistoryRecord&);
+
+    u64 getRoundCount() const;
+
+    u64 getHandCount() const;
+
+    u64 getMismatchCount() const;
+
+    const std::vector<std::string>& getMismatches() const;
+};
\ No newline at end of file
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "AppTypes.h"
+#include "AllocationCounter.h"
+
+// Phases of one round of AbstractBlackjack::playGame()
+enum ProfilePhase
+{
+    phaseBet = 0,
+    phaseDeal = 1,
+    phasePlayerActions = 2,
+    phaseDealerDraw = 3,
+    phaseSettlement = 4
+};
+
+struct ProfileEvent
+{
+    ProfilePhase phase;
+
+    u64 startNs;
+
+    u64 durationNs;
+
+    u64 allocationCount;
+
+    u64 allocationBytes;
+};
+
+struct ProfilePhaseSummary
+{
+    u64 count = 0;
+
+    u64 totalNs = 0;
+
+    u64 maxNs = 0;
+
+    u64 allocationCount = 0;
+
+    u64 allocationBytes = 0;
+};
+
+// Collects phase timings of the round loop of the game thread.
+// Every event is aggregated per phase; the first maxEventCount events are also kept for the trace export.
+class RoundProfiler
+{
+public:
+    static constexpr u8 phaseCount = 5;
+
+    static constexpr u32 maxEventCount = 1 << 20;
+
+protected:
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    std::vector<ProfileEvent> events;
+
+    ProfilePhaseSummary summaries[phaseCount];
+
+public:
+    static RoundProfiler& getInstance();
+
+    static const char* getPhaseName(ProfilePhase);
+
+    u64 getNowNs() const;
+
+    void record(ProfilePhase, u64 startNs, u64 durationNs, u64 allocationCount, u64 allocationBytes);
+
+    void reset();
+
+    const std::vector<ProfileEvent>& getEvents() const;
+
+    const ProfilePhaseSummary& getSummary(ProfilePhase) const;
+
+    void writeChromeTrace(std::ostream&) const;
+
+    void printSummary(std::ostream&) const;
+};
+
+// Records the enclosing scope, or the part of it up to stop(), as one event of a phase
+class ScopedPhaseTimer
+{
+protected:
+    ProfilePhase phase;
+
+    u64 startNs;
+
+    u64 startAllocationCount;
+
+    u64 startAllocationBytes;
+
+    bool stopped = false;
+
+public:
+    explicit ScopedPhaseTimer(ProfilePhase phase)
+        : phase{phase}, startNs{RoundProfiler::getInstance().getNowNs()},
+          startAllocationCount{AllocationCounter::getCount()}, startAllocationBytes{AllocationCounter::getBytes()}
+    {}
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+    ~ScopedPhaseTimer()
+    {
+        this->stop();
+    }
+
+    void stop()
+    {
+        if (this->stopped)
+        {
+            return;
+        }
+
+        RoundProfiler& profiler = RoundProfiler::getInstance();
+
+        this->stopped = true;
+
+        profiler.record(this->phase, this->startNs, profiler.getNowNs() - this->startNs,
+            AllocationCounter::getCount() - this->startAllocationCount,
+            AllocationCounter::getBytes() - this->startAllocationBytes);
+    }
+};
+
+// Timers cost nothing unless the build defines BJ2020_PROFILE
+#ifdef BJ2020_PROFILE
+    #define BJ2020_PROFILE_SCOPE(name, phase) ScopedPhaseTimer name(phase)
+    #define BJ2020_PROFILE_STOP(name) name.stop()
+#else
+    #define BJ2020_PROFILE_SCOPE(name, phase)
+    #define BJ2020_PROFILE_STOP(name)
+#endif
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "AppTypes.h"
+#include "BlackjackRules.h"
+
+// Rule set fixed at compile time.
+// Hot paths are templates over a rules type and read every rule as rules.field: instantiated with a policy
+// each field is a constant and the checks it decides fold away, instantiated with BlackjackRules they stay loads.
+template <u8 DeckCount, bool DealerHitsSoft17, u8 BlackjackPayoutNumerator, u8 BlackjackPayoutDenominator,
+    DoubleRule Double, bool DoubleAfterSplit, u8 MaxSplitHands, bool ResplitAces, SurrenderRule Surrender, bool DealerPeeks,
+    bool DealerHoleCard>
+struct RulesPolicy
+{
+    static_assert(DeckCount > 0, "RulesPolicy: a shoe needs at least one deck");
+    static_assert(BlackjackPayoutDenominator > 0, "RulesPolicy: blackjack payout denominator can't be zero");
+    static_assert(MaxSplitHands >= 1 && MaxSplitHands <= 16, "RulesPolicy: a box holds 1 to 16 hands");
+    static_assert(DealerHoleCard || !DealerPeeks, "RulesPolicy: a dealer without a hole card can't peek");
+    static_assert(Surrender != SurrenderRule::surrenderEarly || !DealerPeeks, "RulesPolicy: early surrender comes before any peek");
+
+    static constexpr u8 deckCount = DeckCount;
+
+    static constexpr bool dealerHitsSoft17 = DealerHitsSoft17;
+
+    static constexpr u8 blackjackPayoutNumerator = BlackjackPayoutNumerator;
+
+    static constexpr u8 blackjackPayoutDenominator = BlackjackPayoutDenominator;
+
+    static constexpr DoubleRule doubleRule = Double;
+
+    static constexpr bool doubleAfterSplit = DoubleAfterSplit;
+
+    static constexpr u8 maxSplitHands = MaxSplitHands;
+
+    static constexpr bool resplitAces = ResplitAces;
+
+    static constexpr SurrenderRule surrender = Surrender;
+
+    static constexpr bool dealerPeeks = DealerPeeks;
+
+    static constexpr bool dealerHoleCard = DealerHoleCard;
+
+    static BlackjackRules toRules()
+    {
+        BlackjackRules rules;
+
+        rules.deckCount = DeckCount;
+        rules.dealerHitsSoft17 = DealerHitsSoft17;
+        rules.blackjackPayoutNumerator = BlackjackPayoutNumerator;
+        rules.blackjackPayoutDenominator = BlackjackPayoutDenominator;
+        rules.doubleRule = Double;
+        rules.doubleAfterSplit = DoubleAfterSplit;
+        rules.maxSplitHands = MaxSplitHands;
+        rules.resplitAces = ResplitAces;
+        rules.surrender = Surrender;
+        rules.dealerPeeks = DealerPeeks;
+        rules.dealerHoleCard = DealerHoleCard;
+
+        return rules;
+    }
+};
+
+// Rules AmericanBlackjack has always been played with, the same as a default BlackjackRules
+using AmericanRules = RulesPolicy<6, false, 3, 2, DoubleRule::doubleAnyTwo, false, 16, true, SurrenderRule::surrenderNone, false, true>;
+
+// The same rules without a hole card, as EuropeanBlackjack plays them
+using EuropeanRules = RulesPolicy<6, false, 3, 2, DoubleRule::doubleAnyTwo, false, 16, true, SurrenderRule::surrenderNone, false, false>;
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "AppTypes.h"
+#include "Card.h"
+
+// Counts of the cards left in a shoe by rank (card number 2..14) and suit (1..4), with per rank and per suit sums.
+// Exact probabilities of anything decided by the next cards follow from these counts alone.
+class ShoeComposition
+{
+protected:
+    u16 cardCounts[15][5] = {};
+
+    u16 rankCounts[15] = {};
+
+    u16 suitCounts[5] = {};
+
+    u16 totalCount = 0;
+
+public:
+    // Full shoe of the given number of decks
+    void reset(u8 deckCount);
+
+    void remove(const Card&);
+
+    // Defined here, they are read in the inner loops of the side bet calculators
+    u16 getCount(u8 cardNumber, u8 suit) const
+    {
+        return this->cardCounts[cardNumber][suit];
+    }
+
+    u16 getRankCount(u8 cardNumber) const
+    {
+        return this->rankCounts[cardNumber];
+    }
+
+    u16 getSuitCount(u8 suit) const
+    {
+        return this->suitCounts[suit];
+    }
+
+    u16 getTotalCount() const
+    {
+        return this->totalCount;
+    }
+};
\ No newline at end of file
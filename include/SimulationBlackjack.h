@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vector>
+
+#include "AmericanBlackjack.h"
+#include "AbstractSideBet.h"
+#include "BasicStrategy.h"
+#include "DecisionBatch.h"
+#include "DealerBatch.h"
+#include "SimulationResult.h"
+
+// Headless American table played by bots: no Application, no messages, flat bets and an unlimited bankroll.
+// A round is split into phases so that a driver can batch decisions over many tables.
+class SimulationBlackjack: public AmericanBlackjack
+{
+protected:
+    static constexpr u32 bankroll = 1000000;
+
+    std::vector<Player> players;
+
+    std::vector<u8> boxFinished;
+
+    u8 boxCount;
+
+    u32 flatBet;
+
+    u64 roundLimit = 0;
+
+    SimulationResult result;
+
+    // Hi-Lo running count of the cards dealt from the current shoe up to countedShoeIndex
+    s16 runningCount = 0;
+
+    u16 countedShoeIndex = 0;
+
+    // True count at the moment the bets of the current round were placed
+    s8 trueCount = 0;
+
+    // Cards left in the shoe as far as it has been counted
+    ShoeComposition composition;
+
+    // Every box stakes the flat bet on each side bet, their expected values are those of the current round
+    std::vector<AbstractSideBet*> sideBets;
+
+    std::vector<f64> sideBetEvs;
+
+    u16 roundShoeIndex = 0;
+
+    // HandState rank of every card of a shoe of cards, read by the dealer kernels of DealerBatch
+    std::vector<u8> shoeRanks;
+
+    u16 dealerLane = 0;
+
+    void updateShoeRanks();
+
+    void settleSideBets();
+
+    void finishHand(Box&);
+
+    s8 updateTrueCount();
+
+    std::vector<Player>& getSeatedPlayers() override;
+
+public:
+    SimulationBlackjack(u8 boxCount, u32 flatBet);
+
+    void prepareGame() override;
+
+    void playGame() override;
+
+    void finishGame() override;
+
+    void requestBets() override;
+
+    void writeSnapshot(SnapshotWriter&) override;
+
+    void readSnapshot(SnapshotReader&) override;
+
+    void setRoundLimit(u64);
+
+    // Side bets are not owned and may be shared between tables
+    void addSideBet(AbstractSideBet*);
+
+    bool needsNewShoe();
+
+    void startShoe();
+
+    void beginRound();
+
+    void appendPendingHands(DecisionBatch&);
+
+    void applyDecisions(DecisionBatch&, u16 fromIndex, u16 toIndex);
+
+    void applyDecision(Box&, u8 action);
+
+    // The dealer hand of a shoe of cards is played out in a DealerBatch, rank count shoes draw theirs in finishRound()
+    void appendDealerHand(DealerBatch&);
+
+    void takeDealerCards(const DealerBatch&);
+
+    void finishRound();
+
+    const SimulationResult& getResult() const;
+};
\ No newline at end of file
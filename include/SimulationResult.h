@@ -0,0 +1,137 @@
+#pragma once
+
+#include <string>
+#include <ostream>
+
+#include "AppTypes.h"
+#include "Snapshot.h"
+
+// Sufficient statistics of a simulation run over a range of shoes.
+// Every field is an exact integer sum, so results of any set of disjoint shards merge into exactly
+// the result of one run over all of their shoes.
+class SimulationResult
+{
+public:
+    static constexpr s8 minTrueCount = -10;
+
+    static constexpr s8 maxTrueCount = 10;
+
+    static constexpr u8 trueCountBucketCount = maxTrueCount - minTrueCount + 1;
+
+    // Counted action indexes, with room for actions registered after the built-in ones
+    static constexpr u8 actionTypeCount = 8;
+
+    // Side bets are counted by the order they were added to the tables,
+    // and by their exact expected value when placed, in whole percent
+    static constexpr u8 maxSideBetCount = 4;
+
+    static constexpr s8 minSideBetEv = -40;
+
+    static constexpr s8 maxSideBetEv = 40;
+
+    static constexpr u8 sideBetEvBucketCount = maxSideBetEv - minSideBetEv + 1;
+
+protected:
+    static constexpr char fileMagic[8] = {'B', 'J', '2', '0', 'S', 'I', 'M', '\0'};
+
+    static constexpr u32 fileVersion = 3;
+
+    u64 seed = 0;
+
+    u64 firstShoe = 0;
+
+    u64 shoeCount = 0;
+
+    u64 roundCount = 0;
+
+    u64 handCount = 0;
+
+    u64 totalBet = 0;
+
+    // One observation is the net result of one box in one round
+    u64 boxRoundCount = 0;
+
+    s64 netResult = 0;
+
+    u64 netResultSquares = 0;
+
+    u64 bucketBoxRoundCounts[trueCountBucketCount] = {};
+
+    s64 bucketNetResults[trueCountBucketCount] = {};
+
+    u64 bucketNetResultSquares[trueCountBucketCount] = {};
+
+    u64 actionCounts[actionTypeCount] = {};
+
+    u64 sideBetCounts[maxSideBetCount][sideBetEvBucketCount] = {};
+
+    u64 sideBetStakes[maxSideBetCount][sideBetEvBucketCount] = {};
+
+    s64 sideBetNetResults[maxSideBetCount][sideBetEvBucketCount] = {};
+
+    static u8 getBucketIndex(s8 trueCount);
+
+    static u8 getSideBetBucketIndex(f64 expectedValue);
+
+    static f64 getMean(s64 sum, u64 count);
+
+    static f64 getConfidenceHalfWidth(s64 sum, u64 squares, u64 count);
+
+public:
+    void setShoeRange(u64 seed, u64 firstShoe, u64 shoeCount);
+
+    void addRound();
+
+    void addHands(u8 handCount, u32 bet);
+
+    void addBoxRound(s8 trueCount, s32 netResult);
+
+    void addAction(u8 action);
+
+    void addSideBet(u8 sideBetIndex, f64 expectedValue, u32 stake, s32 netResult);
+
+    void merge(const SimulationResult&);
+
+    // Removes an earlier state of the same run, leaving the statistics of what happened since
+    void subtract(const SimulationResult&);
+
+    void writeToFile(const std::string& path) const;
+
+    void readFromFile(const std::string& path);
+
+    void writeSnapshot(SnapshotWriter&) const;
+
+    void readSnapshot(SnapshotReader&);
+
+    void printSummary(std::ostream&) const;
+
+    static void writeCsvHeader(std::ostream&);
+
+    void writeCsvRow(std::ostream&) const;
+
+    u64 getSeed() const;
+
+    u64 getFirstShoe() const;
+
+    u64 getShoeCount() const;
+
+    u64 getRoundCount() const;
+
+    u64 getHandCount() const;
+
+    u64 getTotalBet() const;
+
+    s64 getNetResult() const;
+
+    u64 getBoxRoundCount() const;
+
+    f64 getMeanNetResult() const;
+
+    f64 getMeanNetResultHalfWidth() const;
+
+    u64 getSideBetCount(u8 sideBetIndex) const;
+
+    u64 getSideBetStake(u8 sideBetIndex) const;
+
+    s64 getSideBetNetResult(u8 sideBetIndex) const;
+};
\ No newline at end of file
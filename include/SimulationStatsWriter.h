@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include <string>
+
+#include "AppTypes.h"
+#include "SimulationResult.h"
+
+// Streams the statistics of a running simulation: one CSV row per interval of rounds, plus a small progress
+// file that is replaced atomically so that other processes can read it at any time.
+// Only the previous cumulative state is kept, memory use doesn't grow with the length of the run.
+class SimulationStatsWriter
+{
+protected:
+    std::ofstream csvFile;
+
+    std::string progressPath;
+
+    u64 roundInterval;
+
+    u64 nextRoundCount;
+
+    u64 intervalNumber = 0;
+
+    u64 shoeCount = 0;
+
+    SimulationResult previousResult;
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    void writeProgress(const SimulationResult& result, u64 finishedShoeCount, bool isFinished);
+
+public:
+    SimulationStatsWriter(const std::string& csvPath, const std::string& progressPath, u64 roundInterval);
+
+    // A resumed run passes the cumulative result it starts from
+    void start(u64 shoeCount, const SimulationResult& resumedResult);
+
+    bool isDue(u64 roundCount) const;
+
+    // Takes the cumulative result of the run so far
+    void write(const SimulationResult&, u64 finishedShoeCount, bool isFinished = false);
+};
\ No newline at end of file
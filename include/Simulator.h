@@ -0,0 +1,130 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "SimulationBlackjack.h"
+#include "SimulationResult.h"
+#include "SimulationStatsWriter.h"
+#include "BasicStrategy.h"
+#include "DecisionBatch.h"
+#include "DealerBatch.h"
+#include "Snapshot.h"
+
+// Plays many bot tables in lockstep: every step gathers the pending hands of all tables
+// into one DecisionBatch, evaluates masks and strategy for all of them, then applies the decisions.
+// The unit of work is a whole shoe: shoe N of a seed is always dealt and played the same way whatever table
+// picks it up, so any partition of a shoe range into shards adds up to exactly the same result.
+// A checkpoint holds the snapshots of all tables and the cursor in the shoe range, a resumed run ends with
+// exactly the result the uninterrupted one would have had.
+class Simulator
+{
+protected:
+    static constexpr char checkpointMagic[8] = {'B', 'J', '2', '0', 'C', 'K', 'P', '\0'};
+
+    static constexpr u32 checkpointVersion = 3;
+
+    std::vector<SimulationBlackjack*> tables;
+
+    std::vector<SimulationBlackjack*> activeTables;
+
+    std::vector<u16> batchOffsets;
+
+    BasicStrategy strategy;
+
+    BlackjackRules rules;
+
+    using MaskKernel = void (*)(DecisionBatch&, const BlackjackRules&);
+
+    // Rules that match a policy run the action mask kernel compiled for it, any others the runtime one
+    MaskKernel maskKernel = &Simulator::evaluatePolicyMasks<AmericanRules>;
+
+    template <typename Rules>
+    static void evaluatePolicyMasks(DecisionBatch& batch, const BlackjackRules&)
+    {
+        AbstractBlackjack::evaluateActionMasks(batch, Rules());
+    }
+
+    static void evaluateRuntimeMasks(DecisionBatch&, const BlackjackRules&);
+
+    DecisionBatch batch;
+
+    DealerBatch dealerBatch;
+
+    SimulationResult result;
+
+    u64 seed;
+
+    ShoeMode shoeMode = ShoeMode::shoeCards;
+
+    // Names of the side bets in the order they were added, a resumed run must stake the same ones
+    std::vector<std::string> sideBetNames;
+
+    SimulationStatsWriter* statsWriter = nullptr;
+
+    // Cursor of the run in the shoe range
+    u64 firstShoe = 0;
+
+    u64 shoeCount = 0;
+
+    u64 nextShoeNumber = 0;
+
+    u64 endShoeNumber = 0;
+
+    u64 roundCount = 0;
+
+    u64 finishedShoeCount = 0;
+
+    std::string checkpointPath;
+
+    std::chrono::milliseconds checkpointInterval{5000};
+
+    std::chrono::steady_clock::time_point lastCheckpointTime;
+
+    // Reused between checkpoints
+    SnapshotWriter checkpointWriter;
+
+    void play();
+
+    void playRound();
+
+    void writeCheckpoint();
+
+    void readCheckpoint(SnapshotReader&);
+
+    void collectResult(SimulationResult&) const;
+
+    // Strategy, shoe and side bets of the run; the rules, the variant included, are checked on their own
+    u64 getConfigHash() const;
+
+public:
+    Simulator(u16 tableCount, u8 boxCount, u32 flatBet, u64 seed);
+
+    ~Simulator();
+
+    void run(u64 firstShoe, u64 shoeCount);
+
+    // Continues the run saved in a checkpoint file. The simulator must have the same number of tables, rules, strategy,
+    // shoe and side bets, otherwise std::invalid_argument is thrown
+    void resume(const std::string& checkpointPath);
+
+    void setHandHistoryWriter(HandHistoryWriter*);
+
+    void setStrategy(const BasicStrategy&);
+
+    void addSideBet(AbstractSideBet*);
+
+    void setShoeMode(ShoeMode);
+
+    void setRules(const BlackjackRules&);
+
+    void setStatsWriter(SimulationStatsWriter*);
+
+    // Writes a checkpoint at most once per interval, replacing the previous one
+    void setCheckpoint(const std::string& path, std::chrono::milliseconds interval);
+
+    const SimulationResult& getResult() const;
+
+    u64 getSeed() const;
+};
\ No newline at end of file
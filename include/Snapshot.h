@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "AppTypes.h"
+
+// Byte buffer a snapshot of the engine state is written into.
+// Fields are appended in host byte order without padding, all supported platforms are little-endian.
+// The buffer keeps its capacity between snapshots, so taking one doesn't allocate once it is warm.
+class SnapshotWriter
+{
+protected:
+    std::vector<u8> data;
+
+public:
+    template <typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "SnapshotWriter: only trivially copyable fields can be written");
+
+        this->writeBytes(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void writeVector(const std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "SnapshotWriter: only trivially copyable fields can be written");
+
+        this->write<u32>(values.size());
+        this->writeBytes(values.data(), values.size() * sizeof(T));
+    }
+
+    void writeString(const std::string& value)
+    {
+        this->write<u32>(value.size());
+        this->writeBytes(value.data(), value.size());
+    }
+
+    void writeBytes(const void* bytes, u64 size)
+    {
+        const u8* begin = static_cast<const u8*>(bytes);
+
+        this->data.insert(this->data.end(), begin, begin + size);
+    }
+
+    void clear()
+    {
+        this->data.clear();
+    }
+
+    const std::vector<u8>& getData() const
+    {
+        return this->data;
+    }
+
+    // Replaces the file atomically: readers and a crash in the middle of writing see the previous snapshot
+    void writeToFile(const std::string& path) const;
+};
+
+// Reads fields back in the order SnapshotWriter wrote them, a read past the end throws std::runtime_error
+class SnapshotReader
+{
+protected:
+    std::vector<u8> data;
+
+    u64 offset = 0;
+
+    void require(u64 size) const
+    {
+        if (this->data.size() - this->offset < size)
+        {
+            throw std::runtime_error("SnapshotReader - snapshot is truncated");
+        }
+    }
+
+public:
+    SnapshotReader() = default;
+
+    explicit SnapshotReader(std::vector<u8> data)
+        : data{std::move(data)}
+    {}
+
+    template <typename T>
+    T read()
+    {
+        T value;
+
+        this->readBytes(&value, sizeof(T));
+
+        return value;
+    }
+
+    template <typename T>
+    void readVector(std::vector<T>& values)
+    {
+        u32 size = this->read<u32>();
+
+        this->require((u64) size * sizeof(T));
+
+        values.resize(size);
+        this->readBytes(values.data(), size * sizeof(T));
+    }
+
+    std::string readString()
+    {
+        u32 size = this->read<u32>();
+
+        this->require(size);
+
+        std::string value(reinterpret_cast<const char*>(this->data.data() + this->offset), size);
+
+        this->offset += size;
+
+        return value;
+    }
+
+    void readBytes(void* bytes, u64 size)
+    {
+        this->require(size);
+
+        std::memcpy(bytes, this->data.data() + this->offset, size);
+
+        this->offset += size;
+    }
+
+    bool isFinished() const
+    {
+        return this->offset == this->data.size();
+    }
+
+    void readFromFile(const std::string& path);
+};
\ No newline at end of file
@@ -14,4 +14,6 @@ public:
 	bool execute(Box*) override;
 
 	bool isAvailable(Box*) override;
+
+	u8 getActionType() override;
 };
\ No newline at end of file
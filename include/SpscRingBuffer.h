@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include "AppTypes.h"
+
+// Single-producer/single-consumer lock-free ring buffer.
+// Slots are preallocated once and reused: the producer fills the slot returned by acquireSlot()
+// and publishes it with commitSlot(), the consumer reads front() and releases it with pop().
+template <typename T, u16 Capacity>
+class SpscRingBuffer
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscRingBuffer: capacity must be a power of two");
+
+protected:
+    std::array<T, Capacity> slots;
+
+    alignas(64) std::atomic<u32> head{0};
+
+    alignas(64) std::atomic<u32> tail{0};
+
+public:
+    T* acquireSlot()
+    {
+        u32 _tail = this->tail.load(std::memory_order_relaxed);
+
+        if (_tail - this->head.load(std::memory_order_acquire) == Capacity)
+        {
+            return nullptr;
+        }
+
+        return &this->slots[_tail & (Capacity - 1)];
+    }
+
+    void commitSlot()
+    {
+        this->tail.store(this->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    T* front()
+    {
+        u32 _head = this->head.load(std::memory_order_relaxed);
+
+        if (_head == this->tail.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+
+        return &this->slots[_head & (Capacity - 1)];
+    }
+
+    void pop()
+    {
+        this->head.store(this->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool empty() const
+    {
+        return this->head.load(std::memory_order_acquire) == this->tail.load(std::memory_order_acquire);
+    }
+
+    u16 size() const
+    {
+        return this->tail.load(std::memory_order_acquire) - this->head.load(std::memory_order_acquire);
+    }
+
+    static constexpr u16 capacity()
+    {
+        return Capacity;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <type_traits>
+
+#include "AppTypes.h"
+#include "BlackjackRules.h"
+
+// Precomputed strategy and expected values of one rule configuration, in the exact layout of a table file.
+// Hand tables are indexed [soft][player total][dealer upcard value 2..11], pair tables [pair card value][upcard].
+// Expected values are per unit of the initial bet and include the dealer blackjack cases.
+struct StrategyTableData
+{
+    char magic[8];
+
+    u32 version;
+
+    u32 size;
+
+    u64 rulesHash;
+
+    BlackjackRules rules;
+
+    // Expected value of a new round played with this strategy
+    f32 gameEv;
+
+    f32 standEv[2][22][12];
+
+    f32 hitEv[2][22][12];
+
+    f32 doubleEv[2][22][12];
+
+    f32 splitEv[12][12];
+
+    // Giving up half of the initial bet on the first two cards, by upcard, -1 when the rules offer no surrender
+    f32 surrenderEv[12];
+
+    // Same encoding as BasicStrategy: preferred action in the low nibble, fallback in the high one
+    u8 handTable[2][22][12];
+
+    u8 pairTable[12][12];
+};
+
+static_assert(std::is_trivially_copyable<StrategyTableData>::value, "StrategyTableData must be mappable");
+
+// Infinite-deck expected value engine: every card value is drawn with the same chance whatever was dealt before.
+// Splits are valued as two independent hands without resplitting.
+class StrategyTableBuilder
+{
+public:
+    static constexpr char fileMagic[8] = {'B', 'J', '2', '0', 'S', 'T', 'B', '\0'};
+
+    static constexpr u32 fileVersion = 3;
+
+protected:
+    // Dealer final totals 17..21 take outcome indexes 0..4
+    static constexpr u8 dealerBust = 5;
+
+    static constexpr u8 dealerOutcomeCount = 6;
+
+    BlackjackRules rules;
+
+    // Outcomes of a dealer hand of two or more cards by [total][soft], filled on demand
+    f64 dealerOutcomeMemo[32][2][dealerOutcomeCount] = {};
+
+    bool dealerOutcomeKnown[32][2] = {};
+
+    // Per upcard: final dealer outcomes given no dealer blackjack, and the chance of a dealer blackjack
+    f64 dealerOutcomes[12][dealerOutcomeCount] = {};
+
+    f64 dealerBlackjackChance[12] = {};
+
+    // Player values against the current upcard, given no dealer blackjack, by [soft][total]
+    f64 standEv[2][32] = {};
+
+    f64 hitEv[2][32] = {};
+
+    f64 doubleEv[2][32] = {};
+
+    static f64 getCardChance(u8 cardValue);
+
+    static void addCard(u8& total, bool& soft, u8 cardValue);
+
+    const f64* getDealerOutcomes(u8 total, bool soft);
+
+    void computeDealerOutcomes(u8 upcard);
+
+    void computePlayerEv(u8 upcard);
+
+    f64 getHitEv(u8 total, bool soft) const;
+
+    f64 getBestEv(u8 total, bool soft, bool canDouble) const;
+
+    f64 getSplitEv(u8 cardValue) const;
+
+    // Turns a value given no dealer blackjack into the overall one, losing the stake to a dealer blackjack
+    f64 getFinalEv(f64 ev, u8 stake, u8 upcard) const;
+
+    // Overall value of surrendering, late surrender is lost in full to a blackjack the dealer didn't check for
+    f64 getSurrenderEv(u8 upcard) const;
+
+    // Best play of the first two cards, surrender included
+    f64 getBestFinalEv(u8 total, bool soft, u8 upcard) const;
+
+public:
+    explicit StrategyTableBuilder(const BlackjackRules&);
+
+    void build(StrategyTableData&);
+};
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "AppTypes.h"
+#include "BlackjackRules.h"
+#include "StrategyTable.h"
+
+// Read-only view of a strategy table file.
+// The file is mapped shared, so every process using the same rules reads the same physical pages;
+// platforms without mmap copy it into memory instead.
+class StrategyTableFile
+{
+protected:
+    const StrategyTableData* data = nullptr;
+
+    std::unique_ptr<StrategyTableData> fallbackData;
+
+    bool isMapped = false;
+
+    void unmap();
+
+public:
+    StrategyTableFile(const std::string& path, const BlackjackRules&);
+
+    StrategyTableFile(const StrategyTableFile&) = delete;
+
+    StrategyTableFile& operator=(const StrategyTableFile&) = delete;
+
+    ~StrategyTableFile();
+
+    static std::string getPath(const std::string& directory, const BlackjackRules&);
+
+    static void write(const std::string& path, const StrategyTableData&);
+
+    // Maps the table of the rules from the directory, building and writing it first if it isn't there yet
+    static std::unique_ptr<StrategyTableFile> open(const std::string& directory, const BlackjackRules&);
+
+    const StrategyTableData& getData() const;
+};
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "AbstractDisplayHandler.h"
+#include "AppAliasDisplayMessageParam.h"
+#include "AppAliases.h"
+#include "Card.h"
+
+enum StructuredFormat
+{
+    structuredJson = 1,     // a JSON object per line
+    structuredBinary = 2    // length-prefixed frames
+};
+
+// Field types of the binary frames
+enum StructuredFieldType
+{
+    fieldString = 0,        // u16 length, bytes
+    fieldInteger = 1,       // s64
+    fieldCards = 2,         // u8 count, then u8 rank and u8 suit per card
+    fieldHands = 3,         // u8 current hand, u8 count, then a card list per hand
+    fieldOptions = 4        // u8 count, then a string per option
+};
+
+// Writes every displayed batch as one event for bots and dashboards instead of console text.
+// A message is its id and its params as typed fields: whole numbers as integers, card lists as rank/suit pairs
+// (rank 2..14 as CardFace, suit as CardSuit, the hidden dealer card as rank 0), option lists as arrays.
+// The params are serialized as they are, templates and processText() are never involved, and nothing pauses.
+//
+// JSON: {"event":1,"messages":[{"id":"mes_id_info_dealer_cards","fields":{"cards":[{"rank":9,"suit":"club"},null]}}]}
+// Binary frame: u32 size of the rest, u64 event number, u16 message count, then per message the id string,
+// u8 field count and per field the key string, u8 StructuredFieldType and the value. Strings are u16 length
+// and bytes, numbers little-endian.
+class StructuredDisplayHandler: public AbstractDisplayHandler<ADisplayEntity>
+{
+protected:
+    std::ostream& stream;
+
+    StructuredFormat format;
+
+    mutable u64 eventNumber = 0;
+
+    // Reused for every event, stops allocating once warmed up
+    mutable std::string buffer;
+
+    void writeEvent(const std::vector<std::vector<ADisplayMessageParam*>>&) const;
+
+    void appendJsonMessage(std::string&, const std::vector<ADisplayMessageParam*>&) const;
+    void appendBinaryMessage(std::string&, const std::vector<ADisplayMessageParam*>&) const;
+
+    static void appendJsonString(std::string&, const std::string&);
+    static void appendJsonCards(std::string&, const std::vector<Card*>&);
+
+    static void appendBinaryString(std::string&, const std::string&);
+    static void appendBinaryCards(std::string&, const std::vector<Card*>&);
+
+    template <typename T>
+    static void appendBinaryValue(std::string& text, T value)
+    {
+        text.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    // Digits only and no leading zero, so that numeric names and ids keep their exact text
+    static bool isInteger(const std::string&);
+
+public:
+    StructuredDisplayHandler(std::ostream& stream, StructuredFormat format);
+
+    void display(ADisplayEntity*, std::vector<ADisplayMessageParam*>) const override;
+    void displayBatch(std::vector<ADisplayEntity*>, std::vector<std::vector<ADisplayMessageParam*>>) const override;
+
+    // The serialized messages of the batch, without the event envelope
+    std::string renderBatch(std::vector<ADisplayEntity*>, std::vector<std::vector<ADisplayMessageParam*>>) const override;
+
+    void flush() const override;
+
+    u64 getEventCount() const;
+
+    static const char* getSuitName(CardSuit);
+
+    // Card lists are read from the params when the batch is written
+    void transformCardListEntity(ADisplayMessageParam*, std::vector<Card*>&) override;
+    void transformCardListEntities(ADisplayMessageParam*, std::vector<std::vector<Card*>>&, u8 currentHand) override;
+};
\ No newline at end of file
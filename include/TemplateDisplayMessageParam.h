@@ -20,6 +20,9 @@ public:
         : key{std::move(key)}, value{std::move(value)}
     {}
 
+    // Params are deleted through ADisplayMessageParam*
+    virtual ~TemplateDisplayMessageParam() = default;
+
     virtual TKey getKey() const = 0;
 
     virtual void setValue(TValue) = 0;
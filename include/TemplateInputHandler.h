@@ -1,11 +1,13 @@
 #pragma once
 
+#include <chrono>
 #include <vector>
 #include <string>
 #include <map>
 
 #include "TemplateInputValidator.h"
 #include "TemplateDisplayMessageParam.h"
+#include "InputLatencyRecorder.h"
 
 class Application;
 
@@ -28,6 +30,8 @@ public:
         TInputAdapter<TType> adapter;
         auto& castedValidator = dynamic_cast<TemplateInputValidator<TType>&>(validator);
 
+        auto startTime = std::chrono::steady_clock::now();
+
         auto errMesParams = castedValidator.getErrorMessageParams();
         auto reqMesParams = castedValidator.getRequestMessageParams();
         auto addMesParams = castedValidator.getAdditionalMessageParams();
@@ -49,17 +53,42 @@ public:
             this->app->displayMessage(reqMesParams);
         }
 
+        this->app->getDisplayHandler().flush();
+
+        auto inputStartTime = std::chrono::steady_clock::now();
+
         value = adapter.input();
 
+        auto inputEndTime = std::chrono::steady_clock::now();
+        u64 retryWaitNs = 0;
+        u32 retryCount = 0;
+
         messageIds.insert(messageIds.begin(), errMesParams);
 
         while (!castedValidator.validateValue(value))
         {
             this->app->displayMessages(messageIds);
+            this->app->getDisplayHandler().flush();
+
+            auto retryStartTime = std::chrono::steady_clock::now();
 
             value = adapter.input();
+
+            retryWaitNs += InputLatencyRecorder::getDurationNs(retryStartTime, std::chrono::steady_clock::now());
+            retryCount++;
         }
 
+        auto endTime = std::chrono::steady_clock::now();
+        InputLatencyRecorder& recorder = InputLatencyRecorder::getInstance();
+        InputKind kind = castedValidator.getInputKind();
+        u64 firstWaitNs = InputLatencyRecorder::getDurationNs(inputStartTime, inputEndTime);
+
+        recorder.record(kind, InputPhase::inputPhasePrompt, InputLatencyRecorder::getDurationNs(startTime, inputStartTime));
+        recorder.record(kind, InputPhase::inputPhaseWait, firstWaitNs + retryWaitNs);
+        recorder.record(kind, InputPhase::inputPhaseProcessing,
+            InputLatencyRecorder::getDurationNs(inputEndTime, endTime) - retryWaitNs);
+        recorder.record(kind, InputPhase::inputPhaseRetries, retryCount);
+
         return value;
     }
 };
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+
+#include "AbstractSideBet.h"
+
+// Three-card poker hand of the player's first two cards and the dealer's upcard:
+// 100:1 suited trips, 40:1 straight flush, 30:1 three of a kind, 10:1 straight, 5:1 flush.
+// Aces play high and low, A-2-3 and Q-K-A are straights.
+class TwentyOnePlusThreeSideBet: public AbstractSideBet
+{
+protected:
+    static constexpr u16 suitedTripsPayout = 100;
+
+    static constexpr u16 straightFlushPayout = 40;
+
+    static constexpr u16 threeOfAKindPayout = 30;
+
+    static constexpr u16 straightPayout = 10;
+
+    static constexpr u16 flushPayout = 5;
+
+    // Lowest card number of each straight, the ace counts 1 in A-2-3
+    static constexpr u8 straightCount = 12;
+
+    static void getStraightNumbers(u8 straightIndex, u8 cardNumbers[3]);
+
+public:
+    std::string getName() const override;
+
+    u16 getPayout(const Card& playerCard1, const Card& playerCard2,
+        const Card& dealerUpcard, const Card& dealerSecondCard) const override;
+
+    f64 getExpectedValue(const ShoeComposition&) const override;
+};
\ No newline at end of file
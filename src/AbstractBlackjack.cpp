@@ -1,31 +1,93 @@
 #include <algorithm>
 #include <random>
+#include <tuple>
 
 #include "Application.h"
 #include "AppTypes.h"
 #include "AbstractBlackjack.h"
+#include "HandHistoryWriter.h"
+#include "OptionInputValidator.h"
+
+AbstractBlackjack::~AbstractBlackjack()
+{
+    for (auto action : this->actions)
+    {
+        delete action;
+    }
+
+    delete this->dealerBox;
+}
 
 void AbstractBlackjack::assignApp(Application* _app)
 {
     this->app = _app;
 }
 
+void AbstractBlackjack::addAction(AbstractBlackjackAction* action)
+{
+    this->actions.push_back(action);
+    this->actionTypes.push_back(action->getActionType());
+}
+
+u32 AbstractBlackjack::getAvailableActionMask(Box& currentBox)
+{
+    u8 builtinMask = AbstractBlackjack::getActionMask(this->getHandFacts(currentBox), this->rules);
+    u32 availableMask = 0;
+
+    for (u8 index = 0; index < this->actions.size(); index++)
+    {
+        u8 actionType = this->actionTypes[index];
+        bool isAvailable = actionType == AbstractBlackjackAction::customActionType ?
+            this->actions[index]->isAvailable(&currentBox) : builtinMask >> actionType & 1;
+
+        availableMask |= (u32) isAvailable << index;
+    }
+
+    return availableMask;
+}
+
 std::vector<u8> AbstractBlackjack::getAvailableActionIndexes(Box& currentBox)
 {
-    std::vector<u8> availableActionIndexes;
-    u8 index = 0;
+    return this->getActionIndexes(this->getAvailableActionMask(currentBox));
+}
+
+std::vector<u8> AbstractBlackjack::getActionIndexes(u32 actionMask) const
+{
+    std::vector<u8> actionIndexes;
 
-    for (auto& action : this->actions)
+    for (u8 index = 0; index < this->actions.size(); index++)
     {
-        if (action->isAvailable(&currentBox))
+        if (actionMask >> index & 1)
         {
-            availableActionIndexes.push_back(index);
+            actionIndexes.push_back(index);
         }
+    }
+
+    return actionIndexes;
+}
+
+ActionMenu& AbstractBlackjack::getActionMenu(Box& currentBox)
+{
+    u32 availableMask = this->getAvailableActionMask(currentBox);
+    auto it = this->actionMenus.find(availableMask);
 
-        index++;
+    if (it != this->actionMenus.end())
+    {
+        return it->second;
     }
 
-    return availableActionIndexes;
+    std::vector<u8> actionIndexes = this->getActionIndexes(availableMask);
+    std::vector<std::string> actionNames = this->getActionNames(actionIndexes);
+    OptionInputValidator optionValidator(actionIndexes.size(), "Action", actionNames);
+    std::string renderedOptions = this->app->renderMessages(optionValidator.getAdditionalMessageParams());
+
+    return this->actionMenus.emplace(std::piecewise_construct, std::forward_as_tuple(availableMask),
+        std::forward_as_tuple(std::move(actionIndexes), std::move(actionNames), "Action", std::move(renderedOptions))).first->second;
+}
+
+void AbstractBlackjack::clearActionMenus()
+{
+    this->actionMenus.clear();
 }
 
 std::vector<std::string> AbstractBlackjack::getActionNames(const std::vector<u8>& actionIndexes)
@@ -41,6 +103,46 @@ std::vector<std::string> AbstractBlackjack::getActionNames(const std::vector<u8>
     return actionNames;
 }
 
+HandFacts AbstractBlackjack::getHandFacts(Box& currentBox)
+{
+    auto& handCards = currentBox.getHandCards();
+    auto& dealerCards = this->dealerBox->getHandCards();
+    u32 cash = currentBox.getPlayer().getCash();
+    u32 bet = currentBox.getBet();
+    const HandStateInfo& handInfo = HandState::getInfo(currentBox.getHandState());
+    HandFacts facts;
+
+    facts.handValue = handInfo.total;
+    facts.softHand = handInfo.isSoft;
+    facts.cardCount = handCards.size();
+    facts.handCount = currentBox.getHandCount();
+    facts.playableHandCount = currentBox.isBoxInSplit() ? currentBox.getPlayableHandCount() : 1;
+    facts.dealerUpcard = dealerCards.empty() ? 0 : dealerCards[0]->getCardValue();
+    // A dealer who peeks offers insurance before the check, see canInsureBox()
+    facts.insurableHand = !this->rules.dealerPeeks && dealerCards.size() == 2 &&
+        dealerCards[0]->getCardFace() == CardFace::ace && !this->hasInsuredBoxIndex(this->getBoxIndex(currentBox));
+    facts.canAffordBet = cash >= bet;
+    facts.canAffordInsurance = cash >= bet / 2;
+
+    // Pairs are split by face, so 10 and K are not a pair
+    if (handCards.size() == 2 && handCards[0]->getCardNumber() == handCards[1]->getCardNumber())
+    {
+        facts.pairValue = handCards[0]->getCardValue();
+    }
+
+    return facts;
+}
+
+void AbstractBlackjack::appendToDecisionBatch(DecisionBatch& batch, Box& currentBox)
+{
+    batch.append(&currentBox, this->getHandFacts(currentBox));
+}
+
+void AbstractBlackjack::evaluateActionMasks(DecisionBatch& batch)
+{
+    AbstractBlackjack::evaluateActionMasks(batch, AmericanRules());
+}
+
 std::vector<Box>& AbstractBlackjack::getBoxes()
 {
     return this->boxes;
@@ -64,6 +166,14 @@ std::vector<Card>& AbstractBlackjack::createShoe(u8 _deckCount)
     this->deckCount = _deckCount;
     this->shoeIndex = 0;
 
+    if (this->shoeMode != ShoeMode::shoeCards)
+    {
+        // Placeholders, overwritten by the drawn cards as they are dealt
+        this->shoe.resize(_deckCount * 52, RankCountShoe::getRankCard(0));
+
+        return this->shoe;
+    }
+
 	while (deckCount > 0)
 	{
 		for (u8 suitNumber = 1; suitNumber <= 4; suitNumber++)
@@ -84,27 +194,64 @@ std::vector<Card>& AbstractBlackjack::createShoe(u8 _deckCount)
 
 std::vector<Card>& AbstractBlackjack::shuffleShoe()
 {
-//    auto rng = std::default_random_engine(std::random_device{}());
-//    std::shuffle(std::begin(this->shoe), std::end(this->shoe), rng);
-
-//    std::random_device rd;
-//    std::mt19937 e{rd()}; // or std::default_random_engine e{rd()};
-//    std::shuffle(std::begin(this->shoe), std::end(this->shoe), e);
+    // Every shoe gets its own stream, so shoe k of a run is reproducible from (runSeed, k) alone
+    this->shoeNumber = this->nextShoeNumber++;
 
-    std::srand(time(nullptr));
+    if (this->shoeMode != ShoeMode::shoeCards)
+    {
+        this->rankCountShoe.reset(this->shoe.size() / 52, this->shoeMode == ShoeMode::shoeInfiniteDeck,
+            this->runSeed, this->shoeNumber);
 
-    u16 firstIdx, secondIdx, size = this->shoe.size();
+        return this->shoe;
+    }
 
-    for (u16 idx = 0; idx < size; idx++) {
-        firstIdx = std::rand() % size;
-        secondIdx = std::rand() % size;
+    PhiloxRng rng(this->runSeed, this->shoeNumber);
+    u16 size = this->shoe.size();
 
-        std::swap(this->shoe[firstIdx], this->shoe[secondIdx]);
+    // Fisher-Yates: std::shuffle is not used because its output differs between standard libraries
+    for (u16 idx = size - 1; idx > 0; idx--)
+    {
+        std::swap(this->shoe[idx], this->shoe[rng.nextBounded(idx + 1)]);
     }
 
     return this->shoe;
 }
 
+void AbstractBlackjack::setShoeMode(ShoeMode mode)
+{
+    this->shoeMode = mode;
+}
+
+ShoeMode AbstractBlackjack::getShoeMode() const
+{
+    return this->shoeMode;
+}
+
+u64 AbstractBlackjack::createRunSeed()
+{
+    return ((u64) std::random_device{}() << 32) ^ (u64) time(nullptr);
+}
+
+void AbstractBlackjack::setRunSeed(u64 seed)
+{
+    this->runSeed = seed;
+}
+
+u64 AbstractBlackjack::getRunSeed() const
+{
+    return this->runSeed;
+}
+
+void AbstractBlackjack::setNextShoeNumber(u64 number)
+{
+    this->nextShoeNumber = number;
+}
+
+u64 AbstractBlackjack::getShoeNumber() const
+{
+    return this->shoeNumber;
+}
+
 bool AbstractBlackjack::shouldShoeBeReassembled(u8 playerCount)
 {
     u8 cardSumValue = 0;
@@ -137,6 +284,11 @@ Card* AbstractBlackjack::getNextCard()
         throw std::out_of_range("AbstractBlackjack::getNextCard() - shoeIndex is out of range");
     }
 
+    if (this->shoeMode != ShoeMode::shoeCards)
+    {
+        this->shoe[this->shoeIndex] = this->rankCountShoe.drawCard();
+    }
+
     return &this->shoe[this->shoeIndex++];
 }
 
@@ -153,6 +305,8 @@ std::vector<Box>& AbstractBlackjack::createBoxes(std::vector<Player>& players, u
         this->boxes.push_back(box);
     }
 
+    delete this->dealerBox;
+
     this->dealerBox = new Box(&this->dealer, this->allowedMaxValueForDealer);
 
     return this->boxes;
@@ -201,9 +355,139 @@ std::vector<Card*>& AbstractBlackjack::getDealerCards()
     return this->dealerBox->getHandCards();
 }
 
+void AbstractBlackjack::drawDealerCards()
+{
+    // Soft 17 is hit only under H17
+    while (HandState::mustDealerDraw(this->dealerBox->getHandState(), this->rules.dealerHitsSoft17))
+    {
+        this->dealerBox->giveCard(this->getNextCard());
+    }
+}
+
+HandResult AbstractBlackjack::settleHand(Box* box, u8 boxIndex, u32& winCash)
+{
+    u32 cash = box->getPlayer().getCash();
+    HandResult result = this->resolveHand(box, boxIndex, winCash);
+
+    if (this->handHistoryWriter != nullptr)
+    {
+        for (auto& hand : this->handHistoryRound.hands)
+        {
+            if (hand.boxIndex == boxIndex && hand.handNumber == box->getCurrentHandNumber())
+            {
+                hand.result = result;
+                hand.payout = box->getPlayer().getCash() - cash;
+            }
+        }
+    }
+
+    return result;
+}
+
+HandResult AbstractBlackjack::resolveHand(Box* box, u8 boxIndex, u32& winCash)
+{
+    u8 dealerBoxValue = this->dealerBox->getHandCardsValue();
+    u8 boxValue = box->getHandCardsValue();
+    bool dealerHasBlackjack = this->dealerBox->hasBlackjack();
+    bool dealerHasOvertake = dealerBoxValue > this->allowedMaxValueForPlayer;
+    bool playerHasBlackjack = box->hasBlackjack();
+
+    winCash = 0;
+
+    if (this->hasSurrenderedBoxIndex(boxIndex))
+    {
+        // Late surrender doesn't hold against a blackjack the dealer hasn't checked for before
+        if (dealerHasBlackjack && this->rules.surrender != SurrenderRule::surrenderEarly)
+        {
+            return HandResult::handBlackjackLose;
+        }
+
+        this->returnToPlayerHalfItsBet(box);
+
+        return HandResult::handSurrender;
+    }
+
+    if (box->isBoxInSplit())
+    {
+        if (dealerHasBlackjack)
+        {
+            return HandResult::handBlackjackLose;
+        }
+
+        if (box->hasOvertake())
+        {
+            return HandResult::handOvertake;
+        }
+    }
+    else if (box->hasOvertake())
+    {
+        return HandResult::handOvertake;
+    }
+
+    if (dealerHasBlackjack && playerHasBlackjack)
+    {
+        // An insured blackjack is even money: the bet pushes and the insurance pays 2 to 1
+        if (this->hasInsuredBoxIndex(boxIndex))
+        {
+            winCash = 2 * (box->getBet() - AbstractBlackjack::getUninsuredBet(box->getBet()));
+
+            box->getPlayer().increaseCash(box->getBet() + winCash);
+
+            return HandResult::handEvenMoney;
+        }
+
+        this->returnToPlayerItsBet(box);
+
+        return HandResult::handBlackjackTie;
+    }
+
+    if (dealerHasBlackjack)
+    {
+        if (this->hasInsuredBoxIndex(boxIndex))
+        {
+            this->returnToPlayerItsBet(box);
+
+            return HandResult::handBlackjackInsured;
+        }
+
+        return HandResult::handBlackjackLose;
+    }
+
+    // A natural is paid as a blackjack even against a dealer who draws to a bust
+    if (playerHasBlackjack)
+    {
+        winCash = this->payToPlayerForBlackjack(box);
+
+        return HandResult::handBlackjack;
+    }
+
+    if (dealerHasOvertake)
+    {
+        winCash = this->payToPlayerForCommonWin(box);
+
+        return HandResult::handDealerOvertake;
+    }
+
+    if (boxValue == dealerBoxValue)
+    {
+        this->returnToPlayerItsBet(box);
+
+        return HandResult::handTie;
+    }
+
+    if (boxValue > dealerBoxValue)
+    {
+        winCash = this->payToPlayerForCommonWin(box);
+
+        return HandResult::handWin;
+    }
+
+    return HandResult::handLose;
+}
+
 u32 AbstractBlackjack::payToPlayerForBlackjack(Box* box)
 {
-    u32 winCash = box->getBet() * 1.5;
+    u32 winCash = box->getBet() * this->rules.blackjackPayoutNumerator / this->rules.blackjackPayoutDenominator;
 
     box->getPlayer().increaseCash(box->getBet() + winCash);
 
@@ -226,6 +510,298 @@ u32 AbstractBlackjack::returnToPlayerItsBet(Box* box)
     return 0;
 }
 
+u32 AbstractBlackjack::returnToPlayerHalfItsBet(Box* box)
+{
+    box->getPlayer().increaseCash(box->getBet() / 2);
+
+    return 0;
+}
+
+void AbstractBlackjack::setRules(const BlackjackRules& _rules)
+{
+    this->rules = _rules;
+}
+
+const BlackjackRules& AbstractBlackjack::getRules() const
+{
+    return this->rules;
+}
+
+u8 AbstractBlackjack::getInitialDealerCardCount() const
+{
+    return this->rules.dealerHoleCard ? 2 : 1;
+}
+
+void AbstractBlackjack::setHandHistoryWriter(HandHistoryWriter* writer)
+{
+    this->handHistoryWriter = writer;
+}
+
+std::vector<Player>& AbstractBlackjack::getSeatedPlayers()
+{
+    return this->app->getPlayers();
+}
+
+void AbstractBlackjack::writeSnapshot(SnapshotWriter& writer)
+{
+    std::vector<Player>& players = this->getSeatedPlayers();
+
+    // The undealt part of a rank count shoe is not in the shoe vector
+    if (this->shoeMode != ShoeMode::shoeCards)
+    {
+        throw std::runtime_error("AbstractBlackjack::writeSnapshot(writer) - only a shoe of cards can be saved");
+    }
+
+    writer.write(AbstractBlackjack::snapshotVersion);
+    writer.write(this->runSeed);
+    writer.write(this->shoeNumber);
+    writer.write(this->nextShoeNumber);
+    writer.write(this->shoeIndex);
+    writer.write(this->deckCount);
+
+    writer.write<u16>(this->shoe.size());
+
+    for (auto& card : this->shoe)
+    {
+        writer.write(HandHistoryRecord::encodeCard(card));
+    }
+
+    writer.write<u8>(players.size());
+
+    for (auto& player : players)
+    {
+        writer.writeString(player.getName());
+        writer.write(player.getCash());
+    }
+
+    writer.write<u8>(this->boxes.size());
+
+    for (auto& box : this->boxes)
+    {
+        writer.write<u8>(&box.getPlayer() - players.data());
+        box.writeSnapshot(writer, this->shoe.data());
+    }
+
+    this->dealerBox->writeSnapshot(writer, this->shoe.data());
+
+    writer.writeVector(this->insuredBoxIndexes);
+    writer.writeVector(this->surrenderedBoxIndexes);
+}
+
+void AbstractBlackjack::readSnapshot(SnapshotReader& reader)
+{
+    std::vector<Player>& players = this->getSeatedPlayers();
+
+    if (reader.read<u8>() != AbstractBlackjack::snapshotVersion)
+    {
+        throw std::runtime_error("AbstractBlackjack::readSnapshot(reader) - unsupported snapshot version");
+    }
+
+    this->runSeed = reader.read<u64>();
+    this->shoeNumber = reader.read<u64>();
+    this->nextShoeNumber = reader.read<u64>();
+    this->shoeIndex = reader.read<u16>();
+    this->deckCount = reader.read<u8>();
+
+    this->shoe.clear();
+
+    for (u16 cardCount = reader.read<u16>(); cardCount > 0; cardCount--)
+    {
+        this->shoe.push_back(HandHistoryRecord::decodeCard(reader.read<u8>()));
+    }
+
+    // Players are updated in place when the table already seats them, so boxes of other tables keep their pointers
+    u8 playerCount = reader.read<u8>();
+
+    if (players.size() != playerCount)
+    {
+        players.clear();
+        players.reserve(playerCount);
+    }
+
+    for (u8 playerIndex = 0; playerIndex < playerCount; playerIndex++)
+    {
+        std::string name = reader.readString();
+        u32 cash = reader.read<u32>();
+
+        if (playerIndex < players.size())
+        {
+            players[playerIndex].setCash(cash);
+        }
+        else
+        {
+            players.emplace_back(this->app, name, cash);
+        }
+    }
+
+    this->boxes.clear();
+
+    for (u8 boxCount = reader.read<u8>(); boxCount > 0; boxCount--)
+    {
+        u8 playerIndex = reader.read<u8>();
+
+        if (playerIndex >= players.size())
+        {
+            throw std::runtime_error("AbstractBlackjack::readSnapshot(reader) - box player is out of range");
+        }
+
+        this->boxes.emplace_back(&players[playerIndex], this->allowedMaxValueForPlayer);
+        this->boxes.back().readSnapshot(reader, this->shoe.data(), this->shoe.size());
+    }
+
+    if (this->dealerBox == nullptr)
+    {
+        this->dealerBox = new Box(&this->dealer, this->allowedMaxValueForDealer);
+    }
+
+    this->dealerBox->readSnapshot(reader, this->shoe.data(), this->shoe.size());
+
+    reader.readVector(this->insuredBoxIndexes);
+    reader.readVector(this->surrenderedBoxIndexes);
+}
+
+void AbstractBlackjack::recordRoundStart()
+{
+    if (this->handHistoryWriter == nullptr)
+    {
+        return;
+    }
+
+    this->handHistoryRound.clear();
+
+    this->handHistoryRound.seed = this->runSeed;
+    this->handHistoryRound.shoeNumber = this->shoeNumber;
+    this->handHistoryRound.shoeIndex = this->shoeIndex;
+    this->handHistoryRound.flags = (this->rules.dealerHoleCard ? 0 : handHistoryNoHoleCard) |
+        (this->rules.surrender == SurrenderRule::surrenderEarly ? handHistoryEarlySurrender : 0);
+
+    for (auto& box : this->boxes)
+    {
+        this->handHistoryRound.initialBets.push_back(box.getBet());
+    }
+}
+
+void AbstractBlackjack::recordAction(Box& box, u8 actionIndex)
+{
+    if (this->handHistoryWriter != nullptr)
+    {
+        HandHistoryAction action;
+
+        action.boxIndex = this->getBoxIndex(box);
+        action.handNumber = box.getCurrentHandNumber();
+        action.action = actionIndex;
+
+        this->handHistoryRound.actions.push_back(action);
+    }
+}
+
+void AbstractBlackjack::recordInsuranceCollected()
+{
+    if (this->handHistoryWriter != nullptr)
+    {
+        HandHistoryAction action;
+
+        action.action = handHistoryInsuranceCollected;
+
+        this->handHistoryRound.actions.push_back(action);
+    }
+}
+
+void AbstractBlackjack::recordRoundHands()
+{
+    if (this->handHistoryWriter == nullptr)
+    {
+        return;
+    }
+
+    for (auto card : this->dealerBox->getHandCards())
+    {
+        this->handHistoryRound.dealerCards.push_back(HandHistoryRecord::encodeCard(*card));
+    }
+
+    for (auto boxIndex : this->insuredBoxIndexes)
+    {
+        this->handHistoryRound.insuredBoxMask |= 1 << boxIndex;
+    }
+
+    for (auto& box : this->boxes)
+    {
+        u8 currentHandNumber = box.getCurrentHandNumber();
+
+        for (u8 handNumber = 1; handNumber <= box.getHandCount(); handNumber++)
+        {
+            box.switchHand(handNumber);
+
+            HandHistoryHand hand;
+
+            hand.boxIndex = this->getBoxIndex(box);
+            hand.handNumber = handNumber;
+            // Busted hands may never reach settleHand()
+            hand.result = box.getHandCardsValue() > this->allowedMaxValueForPlayer ? HandResult::handOvertake : HandResult::handLose;
+            hand.bet = box.getBet();
+
+            for (auto card : box.getHandCards())
+            {
+                hand.cards.push_back(HandHistoryRecord::encodeCard(*card));
+            }
+
+            this->handHistoryRound.hands.push_back(std::move(hand));
+        }
+
+        box.switchHand(currentHandNumber);
+    }
+}
+
+void AbstractBlackjack::recordRoundFinish()
+{
+    if (this->handHistoryWriter != nullptr)
+    {
+        this->handHistoryWriter->write(this->handHistoryRound);
+    }
+}
+
+bool AbstractBlackjack::canInsureBox(Box& box)
+{
+    auto& dealerCards = this->dealerBox->getHandCards();
+
+    return dealerCards.size() == 2 && dealerCards[0]->getCardFace() == CardFace::ace &&
+        box.getHandCount() == 1 && box.getHandCardsCount() == 2 &&
+        !this->hasInsuredBoxIndex(this->getBoxIndex(box)) &&
+        box.getPlayer().getCash() >= box.getBet() / 2;
+}
+
+void AbstractBlackjack::insureBox(Box& box)
+{
+    for (u8 index = 0; index < this->actions.size(); index++)
+    {
+        if (this->actionTypes[index] == BlackjackActionType::insuranceAction)
+        {
+            this->recordAction(box, index);
+            this->actions[index]->execute(&box);
+
+            return;
+        }
+    }
+}
+
+void AbstractBlackjack::collectInsurances()
+{
+    for (u8 boxIndex : this->insuredBoxIndexes)
+    {
+        Box& box = this->boxes[boxIndex];
+
+        box.updateBet(AbstractBlackjack::getUninsuredBet(box.getBet()));
+    }
+
+    this->recordInsuranceCollected();
+}
+
+u32 AbstractBlackjack::getUninsuredBet(u32 insuredBet)
+{
+    // Insurance adds bet / 2 rounded down, so an insured stake is 3k for a bet of 2k and 3k + 1 for 2k + 1
+    return (insuredBet * 2 + 2) / 3;
+}
+
 void AbstractBlackjack::addInsuredBoxIndex(u8 index)
 {
     if (!this->hasInsuredBoxIndex(index))
@@ -247,6 +823,27 @@ bool AbstractBlackjack::hasInsuredBoxIndex(u8 index) const
     return false;
 }
 
+void AbstractBlackjack::addSurrenderedBoxIndex(u8 index)
+{
+    if (!this->hasSurrenderedBoxIndex(index))
+    {
+        this->surrenderedBoxIndexes.push_back(index);
+    }
+}
+
+bool AbstractBlackjack::hasSurrenderedBoxIndex(u8 index) const
+{
+    for (auto _index : this->surrenderedBoxIndexes)
+    {
+        if (index == _index)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void AbstractBlackjack::clearMessageParamList(std::vector<std::vector<ADisplayMessageParam*>>& messageParamList)
 {
     for (auto& params : messageParamList)
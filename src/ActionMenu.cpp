@@ -0,0 +1,60 @@
+#include <utility>
+
+#include "ActionMenu.h"
+#include "DisplayMessageParamOptions.h"
+
+ActionMenu::ActionMenu(std::vector<u8> actionIndexes, std::vector<std::string> actionNames, const std::string& optionName,
+                       std::string renderedOptions)
+    : actionIndexes{std::move(actionIndexes)}, actionNames{std::move(actionNames)}
+{
+    this->optionParams = {
+        new ADisplayMessageParam("id", "mes_id_info_action_menu"),
+        new DisplayMessageParamOptions("options", std::move(renderedOptions), this->actionNames)
+    };
+    this->requestParams = {
+        new ADisplayMessageParam("id", "mes_id_info_choose_option"),
+        new ADisplayMessageParam("min", std::to_string(1)),
+        new ADisplayMessageParam("max", std::to_string(this->actionIndexes.size())),
+        new ADisplayMessageParam("optionName", optionName)
+    };
+    this->errorParams = {
+        new ADisplayMessageParam("id", "mes_id_error_invalid_choice"),
+        new ADisplayMessageParam("optionName", optionName)
+    };
+}
+
+ActionMenu::~ActionMenu()
+{
+    for (auto params : {&this->optionParams, &this->requestParams, &this->errorParams})
+    {
+        for (auto param : *params)
+        {
+            delete param;
+        }
+    }
+}
+
+const std::vector<u8>& ActionMenu::getActionIndexes() const
+{
+    return this->actionIndexes;
+}
+
+std::vector<std::string>& ActionMenu::getActionNames()
+{
+    return this->actionNames;
+}
+
+const std::vector<ADisplayMessageParam*>& ActionMenu::getOptionParams() const
+{
+    return this->optionParams;
+}
+
+const std::vector<ADisplayMessageParam*>& ActionMenu::getRequestParams() const
+{
+    return this->requestParams;
+}
+
+const std::vector<ADisplayMessageParam*>& ActionMenu::getErrorParams() const
+{
+    return this->errorParams;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.h"
+
+namespace
+{
+    // Per thread, so that the render thread doesn't show up in the game thread's phases
+    thread_local u64 allocationCount = 0;
+
+    thread_local u64 allocationBytes = 0;
+}
+
+u64 AllocationCounter::getCount()
+{
+    return allocationCount;
+}
+
+u64 AllocationCounter::getBytes()
+{
+    return allocationBytes;
+}
+
+void AllocationCounter::add(u64 bytes)
+{
+    allocationCount++;
+    allocationBytes += bytes;
+}
+
+#ifdef BJ2020_PROFILE_ALLOCATIONS
+
+void* operator new(std::size_t size)
+{
+    AllocationCounter::add(size);
+
+    if (void* pointer = std::malloc(size ? size : 1))
+    {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+#endif
\ No newline at end of file
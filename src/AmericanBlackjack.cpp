@@ -1,21 +1,34 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
 #include "Application.h"
 #include "AppTypes.h"
 #include "AmericanBlackjack.h"
 #include "ActionSelectInputValidator.h"
+#include "RoundProfiler.h"
+#include "MetricsRegistry.h"
 
 AmericanBlackjack::AmericanBlackjack()
 {
-    this->actions.push_back(new HitBlackjackAction(this));
-    this->actions.push_back(new StandBlackjackAction(this));
-    this->actions.push_back(new DoubleBlackjackAction(this));
-    this->actions.push_back(new InsuranceBlackjackAction(this));
-    this->actions.push_back(new SplitBlackjackAction(this));
-    this->actions.push_back(new SwitchHandBlackjackAction(this));
+    this->addAction(new HitBlackjackAction(this));
+    this->addAction(new StandBlackjackAction(this));
+    this->addAction(new DoubleBlackjackAction(this));
+    this->addAction(new InsuranceBlackjackAction(this));
+    this->addAction(new SplitBlackjackAction(this));
+    this->addAction(new SwitchHandBlackjackAction(this));
+    this->addAction(new LateSurrenderBlackjackAction(this));
+    this->addAction(new EarlySurrenderBlackjackAction(this));
 }
 
 void AmericanBlackjack::prepareGame()
 {
-    this->createShoe(this->deckCount);
+    if (this->isRestored)
+    {
+        return;
+    }
+
+    this->createShoe(this->rules.deckCount);
     this->shuffleShoe();
     this->createBoxes(this->app->getPlayers(), 4);
 }
@@ -23,38 +36,34 @@ void AmericanBlackjack::prepareGame()
 void AmericanBlackjack::playGame()
 {
     bool continueGame = true;
-    bool dealerHasBlackjack = false;
-    bool dealerHasOvertake = false;
-    bool playerHasBlackjack = false;
     bool isInsurancePlayed = false;
     bool isBoxInSplit = false;
-    u8 dealerBoxValue = 0;
-    u8 currBoxValue = 0;
     u16 actionNumber = 0;
     u32 winCash = 0;
 
     std::vector<std::vector<ADisplayMessageParam*>> messageParamList;
+    MetricsRegistry& metrics = MetricsRegistry::getInstance();
 
     while (!this->boxes.empty())
     {
         continueGame = true;
-        dealerHasBlackjack = false;
-        dealerHasOvertake = false;
-        playerHasBlackjack = false;
         isInsurancePlayed = false;
         isBoxInSplit = false;
-        dealerBoxValue = 0;
-        currBoxValue = 0;
         actionNumber = 0;
         winCash = 0;
 
+        auto roundStartTime = std::chrono::steady_clock::now();
+
         AbstractBlackjack::clearMessageParamList(messageParamList);
 
-        if (this->shouldShoeBeReassembled(this->app->getPlayers().size()))
+        if (this->shoeIndex >= this->shoe.size() * this->rules.penetration ||
+            this->shouldShoeBeReassembled(this->app->getPlayers().size()))
         {
-            this->createShoe(this->deckCount);
+            this->createShoe(this->rules.deckCount);
             this->shuffleShoe();
 
+            metrics.increment(MetricCounter::metricReshuffles);
+
             messageParamList.push_back({
                 new ADisplayMessageParam("id", "mes_id_info_shoe_is_reassembled"),
             });
@@ -63,21 +72,56 @@ void AmericanBlackjack::playGame()
             AbstractBlackjack::clearMessageParamList(messageParamList);
         }
 
+        BJ2020_PROFILE_SCOPE(betTimer, ProfilePhase::phaseBet);
         this->requestBets();
+        this->recordRoundStart();
+        BJ2020_PROFILE_STOP(betTimer);
+
+        BJ2020_PROFILE_SCOPE(dealTimer, ProfilePhase::phaseDeal);
         this->dealCardsToBoxes(2);
-        this->dealCardsToDealer(2);
+        this->dealCardsToDealer(this->getInitialDealerCardCount());
+        BJ2020_PROFILE_STOP(dealTimer);
+
+        // Includes the time players take to answer, the insurance pass jumps back into this phase
+        BJ2020_PROFILE_SCOPE(playerActionsTimer, ProfilePhase::phasePlayerActions);
 
         auto& boxes = this->getBoxes();
         std::vector<u8> boxIndexes(boxes.size());
         std::iota(std::begin(boxIndexes), std::end(boxIndexes), 0);
 
+        bool isRoundDecided = false;
+
+        // Under a hole card check insurance and even money are offered first, then a dealer blackjack ends the round
+        // before anybody acts and without one the insurances are lost at once
+        if (this->rules.dealerPeeks)
+        {
+            this->offerInsurances();
+
+            isRoundDecided = this->dealerBox->hasBlackjack();
+            isInsurancePlayed = true;
+
+            if (!isRoundDecided && !this->insuredBoxIndexes.empty())
+            {
+                this->collectInsurances();
+
+                messageParamList.push_back({
+                    new ADisplayMessageParam("id", "mes_id_info_game_result_insurance_lose")
+                });
+                this->app->displayMessages(messageParamList);
+
+                AbstractBlackjack::clearMessageParamList(messageParamList);
+            }
+        }
+
         loopBoxes:
-        for (auto it = boxIndexes.begin(); it != boxIndexes.end(); it++)
+        for (auto it = boxIndexes.begin(); !isRoundDecided && it != boxIndexes.end(); it++)
         {
             auto& currBox = boxes[*it];
 
             if (currBox.hasBlackjack())
             {
+                metrics.increment(MetricCounter::metricBlackjacks);
+
                 messageParamList.push_back({
                     new ADisplayMessageParam("id", "mes_id_info_player_cards"),
                     new ADisplayMessageParam("name", currBox.getPlayer().getName()),
@@ -96,13 +140,18 @@ void AmericanBlackjack::playGame()
 
             while (continueGame)
             {
-                auto actionIndexes = this->getAvailableActionIndexes(currBox);
-                auto actionNames = this->getActionNames(actionIndexes);
-                auto validator = ActionSelectInputValidator(actionIndexes.size(), "Action", actionNames,
-                                                            this->getDealerBox(), currBox);
+                auto& actionMenu = this->getActionMenu(currBox);
+                auto& actionIndexes = actionMenu.getActionIndexes();
+                ActionSelectInputValidator validator(actionMenu, this->getDealerBox(), currBox);
+                auto decisionStartTime = std::chrono::steady_clock::now();
+
                 actionNumber = this->app->requestInput<u16>(validator);
                 actionNumber--;
 
+                metrics.observe(MetricHistogram::metricDecisionLatency, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - decisionStartTime).count());
+
+                this->recordAction(currBox, actionIndexes[actionNumber]);
                 continueGame = this->actions[actionIndexes[actionNumber]]->execute(&currBox);
 
                 if (continueGame)
@@ -140,12 +189,7 @@ void AmericanBlackjack::playGame()
             boxIndexes.assign(this->insuredBoxIndexes.begin(), this->insuredBoxIndexes.end());
 
             // Grab user's insurances
-            for (u8 boxIndex : boxIndexes)
-            {
-                auto& currBox = boxes[boxIndex];
-
-                currBox.updateBet(currBox.getBet() / 3 * 2);
-            }
+            this->collectInsurances();
 
             messageParamList.push_back({
                 new ADisplayMessageParam("id", "mes_id_info_game_result_insurance_lose")
@@ -160,18 +204,22 @@ void AmericanBlackjack::playGame()
             goto loopBoxes; // I know it's awful but it fits perfectly in this case.
         }
 
-        while (!this->dealerBox->hasBlackjack() && !this->dealerBox->isAllowedMaxValueReached())
-        {
-            this->dealerBox->giveCard(this->getNextCard());
-        }
+        BJ2020_PROFILE_STOP(playerActionsTimer);
+
+        BJ2020_PROFILE_SCOPE(dealerDrawTimer, ProfilePhase::phaseDealerDraw);
+        this->drawDealerCards();
+        this->recordRoundHands();
+        BJ2020_PROFILE_STOP(dealerDrawTimer);
+
+        BJ2020_PROFILE_SCOPE(settlementTimer, ProfilePhase::phaseSettlement);
 
-        dealerBoxValue = this->dealerBox->getHandCardsValue();
-        dealerHasBlackjack = this->dealerBox->hasBlackjack();
-        dealerHasOvertake = this->dealerBox->getHandCardsValue() > 21;
+        // Boxes of broke players are erased on the way, so indexes are counted from the start of the round
+        u8 nextBoxIndex = 0;
 
         for (auto boxIt = boxes.begin(); boxIt != boxes.end();)
         {
             auto boxPtr = &(*boxIt);
+            u8 boxIndex = nextBoxIndex++;
 
             messageParamList.push_back({
                 new ADisplayMessageParam("id", "mes_id_info_dealer_cards"),
@@ -184,8 +232,8 @@ void AmericanBlackjack::playGame()
             });
 
             isBoxInSplit = boxIt->isBoxInSplit();
-            currBoxValue = boxIt->getHandCardsValue();
-            playerHasBlackjack = boxIt->hasBlackjack();
+
+            metrics.increment(MetricCounter::metricHands, boxIt->getHandCount());
 
             if (!boxIt->hasOvertake(isBoxInSplit))
             {
@@ -200,141 +248,132 @@ void AmericanBlackjack::playGame()
                     {
                         boxIt->switchHand(handNumber);
 
-                        if (dealerHasBlackjack)
+                        switch (this->settleHand(boxPtr, boxIndex, winCash))
                         {
-                            messageParamList.push_back({
-                                new ADisplayMessageParam("id", "mes_id_info_game_result_blackjack_lose"),
-                                new ADisplayMessageParam("name", boxIt->getPlayer().getName()),
-                            });
-
-                            continue;
+                            case HandResult::handBlackjackLose:
+                                messageParamList.push_back({
+                                    new ADisplayMessageParam("id", "mes_id_info_game_result_blackjack_lose"),
+                                    new ADisplayMessageParam("name", boxIt->getPlayer().getName()),
+                                });
+                                break;
+
+                            case HandResult::handDealerOvertake:
+                                messageParamList.push_back({
+                                    new ADisplayMessageParam("id", "mes_id_info_game_result_dealer_overtake")
+                                });
+                                messageParamList.push_back({
+                                    new ADisplayMessageParam("id", "mes_id_info_game_result_split_hand_win"),
+                                    new ADisplayMessageParam("number", std::to_string(handNumber)),
+                                    new ADisplayMessageParam("winCash", std::to_string(winCash))
+                                });
+                                break;
+
+                            case HandResult::handTie:
+                                messageParamList.push_back({
+                                    new ADisplayMessageParam("id", "mes_id_info_game_result_split_hand_tie"),
+                                    new ADisplayMessageParam("number", std::to_string(handNumber))
+                                });
+                                break;
+
+                            case HandResult::handWin:
+                                messageParamList.push_back({
+                                    new ADisplayMessageParam("id", "mes_id_info_game_result_split_hand_win"),
+                                    new ADisplayMessageParam("number", std::to_string(handNumber)),
+                                    new ADisplayMessageParam("winCash", std::to_string(winCash))
+                                });
+                                break;
+
+                            default:
+                                messageParamList.push_back({
+                                    new ADisplayMessageParam("id", "mes_id_info_game_result_split_hand_lose"),
+                                    new ADisplayMessageParam("number", std::to_string(handNumber)),
+                                    new ADisplayMessageParam("lostCash", std::to_string(boxIt->getBet()))
+                                });
+                                break;
                         }
-                        else if (dealerHasOvertake && !boxIt->hasOvertake())
-                        {
-                            winCash = this->payToPlayerForCommonWin(boxPtr);
-
+                    }
+                }
+                else
+                {
+                    switch (this->settleHand(boxPtr, boxIndex, winCash))
+                    {
+                        case HandResult::handDealerOvertake:
                             messageParamList.push_back({
                                 new ADisplayMessageParam("id", "mes_id_info_game_result_dealer_overtake")
                             });
                             messageParamList.push_back({
-                                new ADisplayMessageParam("id", "mes_id_info_game_result_split_hand_win"),
-                                new ADisplayMessageParam("number", std::to_string(handNumber)),
+                                new ADisplayMessageParam("id", "mes_id_info_game_result_win"),
+                                new ADisplayMessageParam("name", boxIt->getPlayer().getName()),
                                 new ADisplayMessageParam("winCash", std::to_string(winCash))
                             });
+                            break;
 
-                            continue;
-                        }
-
-                        if (currBoxValue == dealerBoxValue)
-                        {
-                            this->returnToPlayerItsBet(boxPtr);
-
+                        case HandResult::handBlackjackTie:
                             messageParamList.push_back({
-                                new ADisplayMessageParam("id", "mes_id_info_game_result_split_hand_tie"),
-                                new ADisplayMessageParam("number", std::to_string(handNumber))
+                                new ADisplayMessageParam("id", "mes_id_info_game_result_blackjack_tie"),
+                                new ADisplayMessageParam("name", boxIt->getPlayer().getName())
                             });
-                        }
-                        else if (currBoxValue > dealerBoxValue)
-                        {
-                            winCash = this->payToPlayerForCommonWin(boxPtr);
+                            break;
 
+                        case HandResult::handEvenMoney:
                             messageParamList.push_back({
-                                new ADisplayMessageParam("id", "mes_id_info_game_result_split_hand_win"),
-                                new ADisplayMessageParam("number", std::to_string(handNumber)),
+                                new ADisplayMessageParam("id", "mes_id_info_game_result_even_money"),
+                                new ADisplayMessageParam("name", boxIt->getPlayer().getName()),
                                 new ADisplayMessageParam("winCash", std::to_string(winCash))
                             });
-                        }
-                        else if (currBoxValue < dealerBoxValue)
-                        {
+                            break;
+
+                        case HandResult::handBlackjackInsured:
                             messageParamList.push_back({
-                                new ADisplayMessageParam("id", "mes_id_info_game_result_split_hand_lose"),
-                                new ADisplayMessageParam("number", std::to_string(handNumber)),
-                                new ADisplayMessageParam("lostCash", std::to_string(boxIt->getBet()))
+                                new ADisplayMessageParam("id", "mes_id_info_game_result_blackjack_insurance"),
+                                new ADisplayMessageParam("name", boxIt->getPlayer().getName())
                             });
-                        }
-                    }
-                }
-                else
-                {
-                    if (dealerHasOvertake)
-                    {
-                        winCash = this->payToPlayerForCommonWin(boxPtr);
-
-                        messageParamList.push_back({
-                            new ADisplayMessageParam("id", "mes_id_info_game_result_dealer_overtake")
-                        });
-                        messageParamList.push_back({
-                            new ADisplayMessageParam("id", "mes_id_info_game_result_win"),
-                            new ADisplayMessageParam("name", boxIt->getPlayer().getName()),
-                            new ADisplayMessageParam("winCash", std::to_string(winCash))
-                        });
-                    }
-                    else if (dealerHasBlackjack && playerHasBlackjack)
-                    {
-                        this->returnToPlayerItsBet(boxPtr);
+                            break;
 
-                        messageParamList.push_back({
-                            new ADisplayMessageParam("id", "mes_id_info_game_result_blackjack_tie"),
-                            new ADisplayMessageParam("name", boxIt->getPlayer().getName())
-                        });
-                    }
-                    else if (dealerHasBlackjack && !playerHasBlackjack)
-                    {
-                        u8 boxIndex = std::distance(boxes.begin(), boxIt);
-                        auto tmpIt = find(this->insuredBoxIndexes.begin(), this->insuredBoxIndexes.end(), boxIndex);
-
-                        if (tmpIt != this->insuredBoxIndexes.end())
-                        {
-                            this->returnToPlayerItsBet(boxPtr);
+                        case HandResult::handBlackjackLose:
+                            messageParamList.push_back({
+                                new ADisplayMessageParam("id", "mes_id_info_game_result_blackjack_lose"),
+                                new ADisplayMessageParam("name", boxIt->getPlayer().getName())
+                            });
+                            break;
 
+                        case HandResult::handBlackjack:
                             messageParamList.push_back({
-                                new ADisplayMessageParam("id", "mes_id_info_game_result_blackjack_insurance"),
+                                new ADisplayMessageParam("id", "mes_id_info_game_result_blackjack"),
                                 new ADisplayMessageParam("name", boxIt->getPlayer().getName())
                             });
-                        }
-                        else
-                        {
+                            break;
+
+                        case HandResult::handTie:
                             messageParamList.push_back({
-                                new ADisplayMessageParam("id", "mes_id_info_game_result_blackjack_lose"),
+                                new ADisplayMessageParam("id", "mes_id_info_game_result_tie"),
                                 new ADisplayMessageParam("name", boxIt->getPlayer().getName())
                             });
-                        }
-                    }
-                    else if (!dealerHasBlackjack && playerHasBlackjack)
-                    {
-                        this->payToPlayerForBlackjack(boxPtr);
+                            break;
 
-                        messageParamList.push_back({
-                            new ADisplayMessageParam("id", "mes_id_info_game_result_blackjack"),
-                            new ADisplayMessageParam("name", boxIt->getPlayer().getName())
-                        });
-                    }
-                    else if (currBoxValue == dealerBoxValue)
-                    {
-                        this->returnToPlayerItsBet(boxPtr);
+                        case HandResult::handSurrender:
+                            messageParamList.push_back({
+                                new ADisplayMessageParam("id", "mes_id_info_game_result_surrender"),
+                                new ADisplayMessageParam("name", boxIt->getPlayer().getName()),
+                                new ADisplayMessageParam("returnCash", std::to_string(boxIt->getBet() / 2))
+                            });
+                            break;
 
-                        messageParamList.push_back({
-                            new ADisplayMessageParam("id", "mes_id_info_game_result_tie"),
-                            new ADisplayMessageParam("name", boxIt->getPlayer().getName())
-                        });
-                    }
-                    else if (currBoxValue > dealerBoxValue)
-                    {
-                        winCash = this->payToPlayerForCommonWin(boxPtr);
+                        case HandResult::handWin:
+                            messageParamList.push_back({
+                                new ADisplayMessageParam("id", "mes_id_info_game_result_win"),
+                                new ADisplayMessageParam("name", boxIt->getPlayer().getName()),
+                                new ADisplayMessageParam("winCash", std::to_string(winCash))
+                            });
+                            break;
 
-                        messageParamList.push_back({
-                            new ADisplayMessageParam("id", "mes_id_info_game_result_win"),
-                            new ADisplayMessageParam("name", boxIt->getPlayer().getName()),
-                            new ADisplayMessageParam("winCash", std::to_string(winCash))
-                        });
-                    }
-                    else if (currBoxValue < dealerBoxValue)
-                    {
-                        messageParamList.push_back({
-                            new ADisplayMessageParam("id", "mes_id_info_game_result_lose"),
-                            new ADisplayMessageParam("name", boxIt->getPlayer().getName()),
-                            new ADisplayMessageParam("lostCash", std::to_string(boxIt->getBet()))
-                        });
+                        default:
+                            messageParamList.push_back({
+                                new ADisplayMessageParam("id", "mes_id_info_game_result_lose"),
+                                new ADisplayMessageParam("name", boxIt->getPlayer().getName()),
+                                new ADisplayMessageParam("lostCash", std::to_string(boxIt->getBet()))
+                            });
+                            break;
                     }
                 }
             }
@@ -355,6 +394,8 @@ void AmericanBlackjack::playGame()
             {
                 boxIt = boxes.erase(boxIt);
 
+                metrics.increment(MetricCounter::metricEliminatedPlayers);
+
                 messageParamList.push_back({
                     new ADisplayMessageParam("id", "mes_id_info_game_result_player_left"),
                     new ADisplayMessageParam("name",  boxIt->getPlayer().getName())
@@ -368,18 +409,105 @@ void AmericanBlackjack::playGame()
             }
         }
 
+        this->recordRoundFinish();
+
         this->app->displayMessages(messageParamList);
 
         this->dealerBox->resetBox();
+        BJ2020_PROFILE_STOP(settlementTimer);
 
         if (!this->insuredBoxIndexes.empty())
         {
             this->insuredBoxIndexes.clear();
         }
+
+        this->surrenderedBoxIndexes.clear();
+
+        this->writeCheckpoint();
+
+        metrics.increment(MetricCounter::metricRounds);
+        metrics.observe(MetricHistogram::metricRoundDuration, std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - roundStartTime).count());
+    }
+}
+
+void AmericanBlackjack::offerInsurances()
+{
+    for (auto& box : this->boxes)
+    {
+        if (!this->canInsureBox(box))
+        {
+            continue;
+        }
+
+        // Insuring a blackjack is taking even money
+        std::vector<std::string> options = box.hasBlackjack() ?
+            std::vector<std::string>{"Even money", "No even money"} : std::vector<std::string>{"Insurance", "No insurance"};
+        OptionInputValidator validator(options.size(), "Insurance", options);
+        auto& messageParamList = validator.getAdditionalMessageParams();
+
+        messageParamList.insert(messageParamList.begin(), {
+            {
+                new ADisplayMessageParam("id", "mes_id_info_dealer_cards"),
+                new DisplayMessageParamDealerCards("cards", "", this->dealerBox->getHandCards(), true)
+            },
+            {
+                new ADisplayMessageParam("id", "mes_id_info_player_cards"),
+                new ADisplayMessageParam("name", box.getPlayer().getName()),
+                new DisplayMessageParamPlayerCards("cards", "", box.getAllCards(), box.getCurrentHandNumber())
+            }
+        });
+
+        if (this->app->requestInput<u16>(validator) == 1)
+        {
+            this->insureBox(box);
+        }
     }
 }
 
 void AmericanBlackjack::finishGame()
 {
 
+}
+
+void AmericanBlackjack::setCheckpointPath(const std::string& path)
+{
+    this->checkpointPath = path;
+}
+
+bool AmericanBlackjack::restoreCheckpoint()
+{
+    if (this->checkpointPath.empty() || !std::ifstream(this->checkpointPath))
+    {
+        return false;
+    }
+
+    SnapshotReader reader;
+
+    reader.readFromFile(this->checkpointPath);
+    this->readSnapshot(reader);
+
+    this->isRestored = true;
+
+    return true;
+}
+
+void AmericanBlackjack::writeCheckpoint()
+{
+    if (this->checkpointPath.empty())
+    {
+        return;
+    }
+
+    // Nobody is left at the table, the next start is a new game
+    if (this->boxes.empty())
+    {
+        std::remove(this->checkpointPath.c_str());
+
+        return;
+    }
+
+    this->checkpointWriter.clear();
+    this->writeSnapshot(this->checkpointWriter);
+    this->checkpointWriter.writeToFile(this->checkpointPath);
 }
\ No newline at end of file
@@ -1,13 +1,15 @@
+#include <stdexcept>
+
 #include "Application.h"
 
-Application::Application(AbstractBlackjack& game, AInputHandler& inputHandler, ADisplayHandler& displayHandler)
+Application::Application(AbstractBlackjack& game, AInputHandler& inputHandler, AbstractDisplayHandler<ADisplayEntity>& displayHandler)
 : game{game}, inputHandler{inputHandler}, displayHandler{displayHandler}
 {
     this->game.assignApp(this);
     this->inputHandler.assignApp(this);
 }
 
-ADisplayHandler& Application::getDisplayHandler()
+AbstractDisplayHandler<ADisplayEntity>& Application::getDisplayHandler()
 {
     return this->displayHandler;
 }
@@ -17,6 +19,53 @@ void Application::addMessageEntity(const std::string& key, ADisplayEntity* entit
     this->displayEntityList.insert(std::pair<std::string, ADisplayEntity*>(key, entity));
 }
 
+void Application::setMessageCatalog(const MessageCatalog* catalog)
+{
+    this->messageCatalog = catalog;
+    this->localeIndex = 0;
+    this->game.clearActionMenus();
+    this->catalogEntities.clear();
+    this->catalogEntities.reserve(catalog->getLocaleCount() * catalog->getMessageCount());
+
+    for (u16 locale = 0; locale < catalog->getLocaleCount(); locale++)
+    {
+        for (u16 message = 0; message < catalog->getMessageCount(); message++)
+        {
+            MessageLayout layout = catalog->getLayout(locale, message);
+
+            this->catalogEntities.emplace_back(catalog->getTemplate(locale, message),
+                layout != MessageLayout::messageInline, layout == MessageLayout::messagePause);
+        }
+    }
+}
+
+void Application::setLocale(const std::string& locale)
+{
+    s32 localeIndex = this->messageCatalog != nullptr ? this->messageCatalog->findLocale(locale) : -1;
+
+    if (localeIndex < 0)
+    {
+        throw std::invalid_argument("Application::setLocale(locale) - no messages for locale " + locale);
+    }
+
+    this->localeIndex = localeIndex;
+    this->game.clearActionMenus();
+}
+
+ADisplayEntity* Application::getMessageEntity(const std::string& messageId) const
+{
+    s32 messageIndex = this->messageCatalog != nullptr ? this->messageCatalog->findMessage(messageId) : -1;
+
+    if (messageIndex < 0)
+    {
+        return this->displayEntityList.at(messageId);
+    }
+
+    auto* app = const_cast<Application*>(this);
+
+    return &app->catalogEntities[this->localeIndex * this->messageCatalog->getMessageCount() + messageIndex];
+}
+
 void Application::displayMessage(std::vector<ADisplayMessageParam*> params) const
 {
     auto* app = const_cast<Application*>(this);
@@ -44,7 +93,7 @@ void Application::displayMessage(std::vector<ADisplayMessageParam*> params) cons
 
     if (!messageId.empty())
     {
-        this->displayHandler.display(this->displayEntityList.at(messageId), params);
+        this->displayHandler.display(this->getMessageEntity(messageId), params);
     }
     else
     {
@@ -53,6 +102,20 @@ void Application::displayMessage(std::vector<ADisplayMessageParam*> params) cons
 }
 
 void Application::displayMessages(std::vector<std::vector<ADisplayMessageParam*>> messageParamList) const
+{
+    std::vector<ADisplayEntity*> entities = this->prepareMessages(messageParamList);
+
+    this->displayHandler.displayBatch(entities, messageParamList);
+}
+
+std::string Application::renderMessages(std::vector<std::vector<ADisplayMessageParam*>> messageParamList) const
+{
+    std::vector<ADisplayEntity*> entities = this->prepareMessages(messageParamList);
+
+    return this->displayHandler.renderBatch(entities, messageParamList);
+}
+
+std::vector<ADisplayEntity*> Application::prepareMessages(std::vector<std::vector<ADisplayMessageParam*>>& messageParamList) const
 {
     auto* app = const_cast<Application*>(this);
 
@@ -66,7 +129,7 @@ void Application::displayMessages(std::vector<std::vector<ADisplayMessageParam*>
             {
                 if (kv->getKey() == "id")
                 {
-                    entities.push_back(this->displayEntityList.at(kv->getValue()));
+                    entities.push_back(this->getMessageEntity(kv->getValue()));
                 }
                 else
                 {
@@ -80,7 +143,7 @@ void Application::displayMessages(std::vector<std::vector<ADisplayMessageParam*>
         }
     }
 
-    this->displayHandler.displayBatch(entities, messageParamList);
+    return entities;
 }
 
 void Application::requestInputToCreatePlayer()
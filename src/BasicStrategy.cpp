@@ -0,0 +1,135 @@
+#include <cstring>
+
+#include "BasicStrategy.h"
+
+// Row letters are per dealer upcard 2..10, A:
+// H - hit, S - stand, D - double or hit, d - double or stand, P - split, . - don't split
+BasicStrategy::BasicStrategy()
+{
+    for (u8 value = 4; value <= 8; value++)
+    {
+        this->setHandRow(false, value, "HHHHHHHHHH");
+    }
+
+    this->setHandRow(false, 9, "HDDDDHHHHH");
+    this->setHandRow(false, 10, "DDDDDDDDHH");
+    this->setHandRow(false, 11, "DDDDDDDDDH");
+    this->setHandRow(false, 12, "HHSSSHHHHH");
+
+    for (u8 value = 13; value <= 16; value++)
+    {
+        this->setHandRow(false, value, "SSSSSHHHHH");
+    }
+
+    for (u8 value = 17; value <= 21; value++)
+    {
+        this->setHandRow(false, value, "SSSSSSSSSS");
+    }
+
+    this->setHandRow(true, 12, "HHHHHHHHHH");
+    this->setHandRow(true, 13, "HHHDDHHHHH");
+    this->setHandRow(true, 14, "HHHDDHHHHH");
+    this->setHandRow(true, 15, "HHDDDHHHHH");
+    this->setHandRow(true, 16, "HHDDDHHHHH");
+    this->setHandRow(true, 17, "HDDDDHHHHH");
+    this->setHandRow(true, 18, "SddddSSHHH");
+
+    for (u8 value = 19; value <= 21; value++)
+    {
+        this->setHandRow(true, value, "SSSSSSSSSS");
+    }
+
+    this->setPairRow(2, "..PPPP....");
+    this->setPairRow(3, "..PPPP....");
+    this->setPairRow(4, "..........");
+    this->setPairRow(5, "..........");
+    this->setPairRow(6, ".PPPP.....");
+    this->setPairRow(7, "PPPPPP....");
+    this->setPairRow(8, "PPPPPPPPPP");
+    this->setPairRow(9, "PPPPP.PP..");
+    this->setPairRow(10, "..........");
+    this->setPairRow(11, "PPPPPPPPPP");
+}
+
+BasicStrategy::BasicStrategy(const StrategyTableData& data)
+{
+    std::memcpy(this->handTable, data.handTable, sizeof(this->handTable));
+    std::memcpy(this->pairTable, data.pairTable, sizeof(this->pairTable));
+}
+
+u64 BasicStrategy::getHash() const
+{
+    // FNV-1a over both tables
+    const u8* hand = &this->handTable[0][0][0];
+    const u8* pair = &this->pairTable[0][0];
+    u64 hash = 0xCBF29CE484222325;
+
+    for (u16 index = 0; index < sizeof(this->handTable); index++)
+    {
+        hash = (hash ^ hand[index]) * 0x100000001B3;
+    }
+
+    for (u16 index = 0; index < sizeof(this->pairTable); index++)
+    {
+        hash = (hash ^ pair[index]) * 0x100000001B3;
+    }
+
+    return hash;
+}
+
+void BasicStrategy::setHandRow(bool soft, u8 value, const char* row)
+{
+    for (u8 upcard = 2; upcard <= 11; upcard++)
+    {
+        u8 entry = 0;
+
+        switch (row[upcard - 2])
+        {
+            case 'H':
+                entry = hitAction | hitAction << 4;
+                break;
+
+            case 'S':
+                entry = standAction | standAction << 4;
+                break;
+
+            case 'D':
+                entry = doubleAction | hitAction << 4;
+                break;
+
+            case 'd':
+                entry = doubleAction | standAction << 4;
+                break;
+        }
+
+        this->handTable[soft][value][upcard] = entry;
+    }
+}
+
+void BasicStrategy::setPairRow(u8 cardValue, const char* row)
+{
+    for (u8 upcard = 2; upcard <= 11; upcard++)
+    {
+        this->pairTable[cardValue][upcard] = row[upcard - 2] == 'P';
+    }
+}
+
+void BasicStrategy::decideBatch(DecisionBatch& batch) const
+{
+    u16 size = batch.size();
+
+    batch.decisions.resize(size);
+
+    const u8* handValues = batch.handValues.data();
+    const u8* softHands = batch.softHands.data();
+    const u8* pairValues = batch.pairValues.data();
+    const u8* dealerUpcards = batch.dealerUpcards.data();
+    const u8* actionMasks = batch.actionMasks.data();
+    u8* decisions = batch.decisions.data();
+
+    // decide() is inlined, so the lanes are plain table lookups and selects with no branches on hand state
+    for (u16 index = 0; index < size; index++)
+    {
+        decisions[index] = this->decide(handValues[index], softHands[index], pairValues[index], dealerUpcards[index], actionMasks[index]);
+    }
+}
\ No newline at end of file
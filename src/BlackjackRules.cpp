@@ -0,0 +1,290 @@
+#include <fstream>
+#include <stdexcept>
+
+#include "BlackjackRules.h"
+
+namespace
+{
+    bool parseFlag(const std::string& value)
+    {
+        if (value == "true" || value == "yes" || value == "1")
+        {
+            return true;
+        }
+
+        if (value == "false" || value == "no" || value == "0")
+        {
+            return false;
+        }
+
+        throw std::invalid_argument("expected true or false, got " + value);
+    }
+
+    std::string trim(const std::string& value)
+    {
+        u64 begin = value.find_first_not_of(" \t\r");
+        u64 end = value.find_last_not_of(" \t\r");
+
+        return begin == std::string::npos ? "" : value.substr(begin, end - begin + 1);
+    }
+}
+
+u64 BlackjackRules::getHash() const
+{
+    // FNV-1a over the fields in declaration order, the leading byte is the version of this list
+    const u8 fields[] = {
+        4,
+        this->deckCount,
+        this->dealerHitsSoft17,
+        this->blackjackPayoutNumerator,
+        this->blackjackPayoutDenominator,
+        (u8) this->doubleRule,
+        this->doubleAfterSplit,
+        this->maxSplitHands,
+        this->resplitAces,
+        (u8) this->surrender,
+        this->dealerPeeks,
+        this->dealerHoleCard
+    };
+    u64 hash = 0xCBF29CE484222325;
+
+    for (u8 field : fields)
+    {
+        hash = (hash ^ field) * 0x100000001B3;
+    }
+
+    return hash;
+}
+
+bool BlackjackRules::operator==(const BlackjackRules& other) const
+{
+    return this->deckCount == other.deckCount &&
+        this->dealerHitsSoft17 == other.dealerHitsSoft17 &&
+        this->blackjackPayoutNumerator == other.blackjackPayoutNumerator &&
+        this->blackjackPayoutDenominator == other.blackjackPayoutDenominator &&
+        this->doubleRule == other.doubleRule &&
+        this->doubleAfterSplit == other.doubleAfterSplit &&
+        this->maxSplitHands == other.maxSplitHands &&
+        this->resplitAces == other.resplitAces &&
+        this->surrender == other.surrender &&
+        this->dealerPeeks == other.dealerPeeks &&
+        this->dealerHoleCard == other.dealerHoleCard &&
+        this->penetration == other.penetration;
+}
+
+bool BlackjackRules::operator!=(const BlackjackRules& other) const
+{
+    return !(*this == other);
+}
+
+bool BlackjackRules::isDoubleAllowed(u8 handValue) const
+{
+    switch (this->doubleRule)
+    {
+    case DoubleRule::doubleNineToEleven:
+        return handValue >= 9 && handValue <= 11;
+
+    case DoubleRule::doubleTenToEleven:
+        return handValue >= 10 && handValue <= 11;
+
+    default:
+        return true;
+    }
+}
+
+BlackjackRules BlackjackRules::readFromFile(const std::string& path)
+{
+    std::ifstream file(path);
+
+    if (!file)
+    {
+        throw std::invalid_argument("BlackjackRules::readFromFile(path) - can't open " + path);
+    }
+
+    try
+    {
+        return BlackjackRules::read(file);
+    }
+    catch (const std::invalid_argument& exception)
+    {
+        throw std::invalid_argument(path + ": " + exception.what());
+    }
+}
+
+BlackjackRules BlackjackRules::read(std::istream& stream)
+{
+    BlackjackRules rules;
+    std::string line;
+    u32 lineNumber = 0;
+
+    while (std::getline(stream, line))
+    {
+        lineNumber++;
+        line = trim(line.substr(0, line.find('#')));
+
+        if (line.empty())
+        {
+            continue;
+        }
+
+        u64 separator = line.find('=');
+        std::string key = trim(line.substr(0, separator));
+        std::string value = separator == std::string::npos ? "" : trim(line.substr(separator + 1));
+
+        try
+        {
+            if (separator == std::string::npos || value.empty())
+            {
+                throw std::invalid_argument("expected key = value");
+            }
+
+            if (key == "deck_count")
+            {
+                u64 deckCount = std::stoul(value);
+
+                if (deckCount < 1 || deckCount > 8)
+                {
+                    throw std::invalid_argument("deck count must be from 1 to 8");
+                }
+
+                rules.deckCount = deckCount;
+            }
+            else if (key == "dealer_hits_soft_17")
+            {
+                rules.dealerHitsSoft17 = parseFlag(value);
+            }
+            else if (key == "blackjack_payout")
+            {
+                u64 colon = value.find(':');
+                u64 numerator = std::stoul(value.substr(0, colon));
+                u64 denominator = colon == std::string::npos ? 0 : std::stoul(value.substr(colon + 1));
+
+                if (numerator == 0 || numerator > 255 || denominator == 0 || denominator > 255)
+                {
+                    throw std::invalid_argument("blackjack payout must look like 3:2");
+                }
+
+                rules.blackjackPayoutNumerator = numerator;
+                rules.blackjackPayoutDenominator = denominator;
+            }
+            else if (key == "double")
+            {
+                if (value == "any")
+                {
+                    rules.doubleRule = DoubleRule::doubleAnyTwo;
+                }
+                else if (value == "9-11")
+                {
+                    rules.doubleRule = DoubleRule::doubleNineToEleven;
+                }
+                else if (value == "10-11")
+                {
+                    rules.doubleRule = DoubleRule::doubleTenToEleven;
+                }
+                else
+                {
+                    throw std::invalid_argument("double must be any, 9-11 or 10-11");
+                }
+            }
+            else if (key == "double_after_split")
+            {
+                rules.doubleAfterSplit = parseFlag(value);
+            }
+            else if (key == "max_split_hands")
+            {
+                u64 maxSplitHands = std::stoul(value);
+
+                if (maxSplitHands < 1 || maxSplitHands > 16)
+                {
+                    throw std::invalid_argument("max split hands must be from 1 to 16");
+                }
+
+                rules.maxSplitHands = maxSplitHands;
+            }
+            else if (key == "resplit_aces")
+            {
+                rules.resplitAces = parseFlag(value);
+            }
+            else if (key == "surrender")
+            {
+                if (value == "none")
+                {
+                    rules.surrender = SurrenderRule::surrenderNone;
+                }
+                else if (value == "late")
+                {
+                    rules.surrender = SurrenderRule::surrenderLate;
+                }
+                else if (value == "early")
+                {
+                    rules.surrender = SurrenderRule::surrenderEarly;
+                }
+                else
+                {
+                    throw std::invalid_argument("surrender must be none, late or early");
+                }
+            }
+            else if (key == "dealer_peeks")
+            {
+                rules.dealerPeeks = parseFlag(value);
+            }
+            else if (key == "hole_card")
+            {
+                rules.dealerHoleCard = parseFlag(value);
+            }
+            else if (key == "penetration")
+            {
+                f32 penetration = std::stof(value);
+
+                if (!(penetration > 0 && penetration <= 1))
+                {
+                    throw std::invalid_argument("penetration must be above 0 and at most 1");
+                }
+
+                rules.penetration = penetration;
+            }
+            else
+            {
+                throw std::invalid_argument("unknown rule " + key);
+            }
+        }
+        catch (const std::logic_error& exception)
+        {
+            // std::stoul() and std::stof() throw std::invalid_argument and std::out_of_range with bare messages
+            throw std::invalid_argument("line " + std::to_string(lineNumber) + ": " + key + ": " + exception.what());
+        }
+    }
+
+    if (rules.dealerPeeks && !rules.dealerHoleCard)
+    {
+        throw std::invalid_argument("dealer_peeks: a dealer without a hole card can't peek");
+    }
+
+    // Early surrender is offered before the hole card check, a peeking dealer would end the round first
+    if (rules.surrender == SurrenderRule::surrenderEarly && rules.dealerPeeks)
+    {
+        throw std::invalid_argument("surrender: early surrender can't be played with dealer_peeks");
+    }
+
+    return rules;
+}
+
+void BlackjackRules::write(std::ostream& stream) const
+{
+    const char* doubleRules[] = {"any", "9-11", "10-11"};
+    const char* surrenderRules[] = {"none", "late", "early"};
+
+    stream << std::boolalpha;
+    stream << "deck_count = " << (u16) this->deckCount << std::endl;
+    stream << "dealer_hits_soft_17 = " << this->dealerHitsSoft17 << std::endl;
+    stream << "blackjack_payout = " << (u16) this->blackjackPayoutNumerator << ":" << (u16) this->blackjackPayoutDenominator << std::endl;
+    stream << "double = " << doubleRules[this->doubleRule] << std::endl;
+    stream << "double_after_split = " << this->doubleAfterSplit << std::endl;
+    stream << "max_split_hands = " << (u16) this->maxSplitHands << std::endl;
+    stream << "resplit_aces = " << this->resplitAces << std::endl;
+    stream << "surrender = " << surrenderRules[this->surrender] << std::endl;
+    stream << "dealer_peeks = " << this->dealerPeeks << std::endl;
+    stream << "hole_card = " << this->dealerHoleCard << std::endl;
+    stream << "penetration = " << this->penetration << std::endl;
+    stream << std::noboolalpha;
+}
\ No newline at end of file
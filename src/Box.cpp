@@ -17,6 +17,7 @@ Player& Box::getPlayer() const
 void Box::resetBox()
 {
     this->hands.clear();
+    this->handStates.clear();
     this->bets.clear();
 
     this->bets = {0};
@@ -29,9 +30,27 @@ void Box::giveCard(Card* card)
     {
         this->hands.resize(this->hands.size() + 1);
         this->hands[this->activeHand] = {};
+        this->handStates.resize(this->hands.size(), HandState::empty);
     }
 
     this->hands[this->activeHand].push_back(card);
+    this->handStates[this->activeHand] = HandState::getNext(this->handStates[this->activeHand],
+        HandState::getRank(card->getCardValue()));
+}
+
+void Box::removeLastCard()
+{
+    auto& cards = this->hands[this->activeHand];
+    u8 state = HandState::empty;
+
+    cards.pop_back();
+
+    for (auto card : cards)
+    {
+        state = HandState::getNext(state, HandState::getRank(card->getCardValue()));
+    }
+
+    this->handStates[this->activeHand] = state;
 }
 
 std::vector<std::vector<Card*>>& Box::getAllCards()
@@ -66,49 +85,24 @@ u8 Box::getHandCardsCount()
 }
 
 
-u8 Box::getHandCardsValue()
+u8 Box::getHandState() const
 {
-    if (this->hasBlackjack())
-    {
-        return 21;
-    }
-
-    u16 value = 0;
-    u8 aceCardCount = 0;
-
-    if (this->hands.empty())
-    {
-        return 0;
-    }
-
-    for (auto& card : this->hands[this->activeHand])
+    if (this->activeHand >= this->handStates.size())
     {
-        if (card->getCardFace() != CardFace::ace)
-        {
-            value += card->getCardValue();
-        }
-        else
-        {
-            aceCardCount++;
-        }
+        return HandState::empty;
     }
 
-    if (aceCardCount == 1 && (this->allowedMaxValue - value) == Card::getMaxAceCardValue())
-    {
-        value += Card::getMaxAceCardValue();
-    }
-    else
-    {
-        while (aceCardCount > 0)
-        {
-            value += (this->allowedMaxValue - (value + Card::getMinAceCardValue() * aceCardCount) >= Card::getMaxAceCardValue())
-                     ? Card::getMaxAceCardValue() : Card::getMinAceCardValue();
+    return this->handStates[this->activeHand];
+}
 
-            aceCardCount--;
-        }
-    }
+u8 Box::getHandCardsValue()
+{
+    return HandState::getInfo(this->getHandState()).total;
+}
 
-    return value;
+bool Box::isHandSoft()
+{
+    return HandState::getInfo(this->getHandState()).isSoft;
 }
 
 bool Box::isAllowedMaxValueReached()
@@ -198,6 +192,18 @@ std::vector<u8> Box::getPlayableHandNumbers()
     return playableHands;
 }
 
+u8 Box::getPlayableHandCount() const
+{
+    u8 playableHandCount = 0;
+
+    for (auto state : this->handStates)
+    {
+        playableHandCount += HandState::getInfo(state).total <= this->allowedMaxValue;
+    }
+
+    return playableHandCount;
+}
+
 bool Box::isBoxInSplit()
 {
     return this->hands.size() > 1;
@@ -205,15 +211,8 @@ bool Box::isBoxInSplit()
 
 bool Box::hasBlackjack()
 {
-    if (this->hands.empty() || this->hands.size() > 1)
-    {
-        return false;
-    }
-
-    auto& cards = this->hands[this->activeHand];
-
-    return cards.size() == 2 && (cards[0]->getCardValue() == 10 && cards[1]->getCardValue() == 11 ||
-        cards[1]->getCardValue() == 10 && cards[0]->getCardValue() == 11);
+    // Ace and ten after a split are only 21
+    return this->hands.size() == 1 && this->getHandState() == HandState::blackjack;
 }
 
 bool Box::hasOvertake(bool checkAllHands)
@@ -278,4 +277,51 @@ bool Box::hasOvertake(bool checkAllHands)
     {
         return this->getHandCardsValue() > this->allowedMaxValue;
     }
+}
+
+void Box::writeSnapshot(SnapshotWriter& writer, const Card* shoe) const
+{
+    writer.write(this->activeHand);
+    writer.writeVector(this->bets);
+    writer.write<u8>(this->hands.size());
+
+    for (auto& hand : this->hands)
+    {
+        writer.write<u8>(hand.size());
+
+        for (auto card : hand)
+        {
+            writer.write<u16>(card - shoe);
+        }
+    }
+}
+
+void Box::readSnapshot(SnapshotReader& reader, Card* shoe, u16 shoeSize)
+{
+    this->activeHand = reader.read<u8>();
+    reader.readVector(this->bets);
+    this->hands.resize(reader.read<u8>());
+    this->handStates.assign(this->hands.size(), HandState::empty);
+
+    for (u8 handIndex = 0; handIndex < this->hands.size(); handIndex++)
+    {
+        auto& hand = this->hands[handIndex];
+
+        hand.resize(reader.read<u8>());
+
+        for (auto& card : hand)
+        {
+            u16 shoeIndex = reader.read<u16>();
+
+            if (shoeIndex >= shoeSize)
+            {
+                throw std::runtime_error("Box::readSnapshot(reader, shoe, shoeSize) - card is out of the shoe");
+            }
+
+            card = shoe + shoeIndex;
+
+            this->handStates[handIndex] = HandState::getNext(this->handStates[handIndex],
+                HandState::getRank(card->getCardValue()));
+        }
+    }
 }
\ No newline at end of file
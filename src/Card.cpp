@@ -8,7 +8,7 @@ bool Card::operator==(const Card& card) const
 
 bool Card::operator!=(const Card& card) const
 {
-    return this->number != card.number && this->suit != card.suit;
+    return !(*this == card);
 }
 
 CardFace Card::getCardFace()
@@ -52,6 +52,11 @@ std::string Card::getCardLetter() const
     return std::to_string(this->number);
 }
 
+u8 Card::getCardNumber() const
+{
+    return this->number;
+}
+
 u8 Card::getCardValue()
 {
 	switch (this->number)
@@ -69,7 +74,7 @@ u8 Card::getCardValue()
 	}
 }
 
-CardSuit Card::getCardSuit()
+CardSuit Card::getCardSuit() const
 {
     return this->suit;
 }
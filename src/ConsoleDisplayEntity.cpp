@@ -1,11 +1,11 @@
 #include "ConsoleDisplayEntity.h"
 
-std::string& ConsoleDisplayEntity::getDisplayEntity()
+std::string_view& ConsoleDisplayEntity::getDisplayEntity()
 {
     return this->entity;
 }
 
-void ConsoleDisplayEntity::setDisplayEntity(std::string value)
+void ConsoleDisplayEntity::setDisplayEntity(std::string_view value)
 {
     this->entity = value;
 }
@@ -2,17 +2,38 @@
 #include "AppAliasDisplayMessageParam.h"
 #include "AppTypes.h"
 
+#include <chrono>
+#include <utility>
+
 #if defined(_WIN32) || defined(_WIN64)
 #include <windows.h>
 #else
 #include "istream"
 #endif
 
-ConsoleDisplayHandler::ConsoleDisplayHandler()
+ConsoleDisplayHandler::ConsoleDisplayHandler(bool asyncRendering, RenderBackpressure backpressure)
+    : asyncRendering{asyncRendering}, backpressure{backpressure}
 {
 #if defined(_WIN32) || defined(_WIN64)
     SetConsoleOutputCP(CP_UTF8);
 #endif
+
+    if (this->asyncRendering)
+    {
+        this->rendering = true;
+        this->renderThread = std::thread(&ConsoleDisplayHandler::renderLoop, this);
+    }
+}
+
+ConsoleDisplayHandler::~ConsoleDisplayHandler()
+{
+    if (this->asyncRendering)
+    {
+        this->flush();
+
+        this->rendering = false;
+        this->renderThread.join();
+    }
 }
 
 void ConsoleDisplayHandler::clearConsole() const
@@ -33,35 +54,186 @@ void ConsoleDisplayHandler::pauseConsole() const
 #endif
 }
 
-void ConsoleDisplayHandler::display(ConsoleDisplayEntity* entity, std::vector<ADisplayMessageParam*> params) const
+void ConsoleDisplayHandler::render(const ConsoleRenderEvent& event) const
 {
     this->clearConsole();
 
-    std::string cache = this->processText(entity->getDisplayEntity(), params);
-    bool pause = false;
+    std::cout << event.text << std::flush;
 
-    if (entity->hasEndLine())
+    if (event.pause)
     {
-        cache += "\n";
+        this->pauseConsole();
+    }
+}
+
+bool ConsoleDisplayHandler::tryPublish(std::string& text, bool pause) const
+{
+    auto* slot = this->renderQueue.acquireSlot();
+
+    if (slot == nullptr)
+    {
+        return false;
     }
 
-    pause = entity->pauseAfterDisplay();
+    // Swapping keeps the capacity of both strings, so slots stop allocating once warmed up
+    slot->text.swap(text);
+    slot->pause = pause;
 
-    std::cout << cache << std::flush;
+    this->renderQueue.commitSlot();
 
-    if (pause)
+    return true;
+}
+
+void ConsoleDisplayHandler::publish(std::string& text, bool pause) const
+{
+    if (!this->asyncRendering)
     {
-        this->pauseConsole();
+        this->render({text, pause});
+
+        return;
+    }
+
+    if (this->hasCoalescedEvent && this->tryPublish(this->coalescedEvent.text, this->coalescedEvent.pause))
+    {
+        this->hasCoalescedEvent = false;
+    }
+
+    if (!this->hasCoalescedEvent && this->tryPublish(text, pause))
+    {
+        return;
+    }
+
+    RenderBackpressure backpressure = this->backpressure;
+
+    // A frame waiting for the player is never dropped, the game would go on without them having seen it.
+    // Nor is it coalesced into, the player would be paused on text they weren't meant to stop on.
+    if ((pause && backpressure == RenderBackpressure::drop) ||
+        (this->hasCoalescedEvent && this->coalescedEvent.pause && backpressure == RenderBackpressure::coalesce))
+    {
+        backpressure = RenderBackpressure::block;
+    }
+
+    switch (backpressure)
+    {
+        case RenderBackpressure::block:
+            if (this->hasCoalescedEvent)
+            {
+                while (!this->tryPublish(this->coalescedEvent.text, this->coalescedEvent.pause))
+                {
+                    std::this_thread::yield();
+                }
+
+                this->hasCoalescedEvent = false;
+            }
+
+            while (!this->tryPublish(text, pause))
+            {
+                std::this_thread::yield();
+            }
+            break;
+
+        case RenderBackpressure::drop:
+            this->droppedEventCount++;
+            break;
+
+        case RenderBackpressure::coalesce:
+            // Every frame starts with clearing the console, so only the newest one would stay visible anyway
+            this->coalescedEvent.text.swap(text);
+            this->coalescedEvent.pause = pause;
+
+            if (this->hasCoalescedEvent)
+            {
+                this->droppedEventCount++;
+            }
+
+            this->hasCoalescedEvent = true;
+            break;
     }
 }
 
+void ConsoleDisplayHandler::renderLoop()
+{
+    u16 idleSpins = 0;
+
+    while (this->rendering || !this->renderQueue.empty())
+    {
+        auto* event = this->renderQueue.front();
+
+        if (event == nullptr)
+        {
+            if (++idleSpins < 64)
+            {
+                std::this_thread::yield();
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            continue;
+        }
+
+        idleSpins = 0;
+
+        this->render(*event);
+
+        this->renderQueue.pop();
+    }
+}
+
+void ConsoleDisplayHandler::flush() const
+{
+    if (!this->asyncRendering)
+    {
+        return;
+    }
+
+    if (this->hasCoalescedEvent)
+    {
+        while (!this->tryPublish(this->coalescedEvent.text, this->coalescedEvent.pause))
+        {
+            std::this_thread::yield();
+        }
+
+        this->hasCoalescedEvent = false;
+    }
+
+    // The renderer pops an event only after it has been written, so an empty queue means everything is on screen
+    while (!this->renderQueue.empty())
+    {
+        std::this_thread::yield();
+    }
+}
+
+u32 ConsoleDisplayHandler::getDroppedEventCount() const
+{
+    return this->droppedEventCount;
+}
+
+void ConsoleDisplayHandler::display(ConsoleDisplayEntity* entity, std::vector<ADisplayMessageParam*> params) const
+{
+    std::string cache = this->processText(entity->getDisplayEntity(), params);
+
+    if (entity->hasEndLine())
+    {
+        cache += "\n";
+    }
+
+    this->publish(cache, entity->pauseAfterDisplay());
+}
+
 void ConsoleDisplayHandler::displayBatch(std::vector<ConsoleDisplayEntity*> entities, std::vector<std::vector<ADisplayMessageParam*>> params) const
 {
-    this->clearConsole();
+    bool pause = !entities.empty() && entities.back()->pauseAfterDisplay();
+    std::string cache = this->renderBatch(std::move(entities), std::move(params));
+
+    this->publish(cache, pause);
+}
 
+std::string ConsoleDisplayHandler::renderBatch(std::vector<ConsoleDisplayEntity*> entities, std::vector<std::vector<ADisplayMessageParam*>> params) const
+{
     std::string cache;
     u8 index = 0;
-    bool pause = false;
 
     for (auto const& entity: entities)
     {
@@ -71,16 +243,9 @@ void ConsoleDisplayHandler::displayBatch(std::vector<ConsoleDisplayEntity*> enti
         {
             cache += "\n";
         }
-
-        pause = entity->pauseAfterDisplay();
     }
 
-    std::cout << cache << std::flush;
-
-    if (pause)
-    {
-        this->pauseConsole();
-    }
+    return cache;
 }
 
 void ConsoleDisplayHandler::transformCardListEntity(ADisplayMessageParam* entity, std::vector<Card*>& cards)
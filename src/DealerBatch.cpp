@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <cstring>
+
+#include "DealerBatch.h"
+#include "HandState.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define BJ2020_DEALER_KERNEL_X86
+    #include <immintrin.h>
+#endif
+
+// The HandState tables widened to 32 bits for the gathers
+struct DealerKernelTables
+{
+    s32 next[HandState::stateCount * HandState::rankCount] = {};
+
+    // -1 where the dealer draws, 0 where the dealer stands; the first row under S17, the second under H17
+    s32 mustDraw[2][HandState::stateCount] = {};
+};
+
+static constexpr DealerKernelTables buildDealerKernelTables()
+{
+    DealerKernelTables tables;
+
+    for (u8 state = 0; state < HandState::stateCount; state++)
+    {
+        for (u8 rank = 0; rank < HandState::rankCount; rank++)
+        {
+            tables.next[state * HandState::rankCount + rank] = HandState::getNext(state, rank);
+        }
+
+        tables.mustDraw[0][state] = HandState::mustDealerDraw(state, false) ? -1 : 0;
+        tables.mustDraw[1][state] = HandState::mustDealerDraw(state, true) ? -1 : 0;
+    }
+
+    return tables;
+}
+
+alignas(64) static constexpr DealerKernelTables dealerKernelTables = buildDealerKernelTables();
+
+void DealerBatch::reserve(u16 laneCount)
+{
+    this->states.reserve(laneCount);
+    this->upcomingRanks.reserve(laneCount * DealerBatch::maxDrawCount + DealerBatch::gatherPadding);
+    this->drawCounts.reserve(laneCount);
+}
+
+void DealerBatch::clear()
+{
+    this->states.clear();
+    this->upcomingRanks.clear();
+    this->drawCounts.clear();
+}
+
+void DealerBatch::appendLane(u8 state, const u8* ranks, u16 rankCount)
+{
+    u32 offset = this->states.size() * DealerBatch::maxDrawCount;
+    u8 copiedCount = std::min<u16>(rankCount, DealerBatch::maxDrawCount);
+
+    this->states.push_back(state);
+    this->drawCounts.push_back(0);
+
+    this->upcomingRanks.resize(offset + DealerBatch::maxDrawCount + DealerBatch::gatherPadding, 8);
+    std::memcpy(this->upcomingRanks.data() + offset, ranks, copiedCount);
+    std::fill(this->upcomingRanks.begin() + offset + copiedCount, this->upcomingRanks.end(), 8);
+}
+
+u16 DealerBatch::size() const
+{
+    return this->states.size();
+}
+
+u8 DealerBatch::getState(u16 lane) const
+{
+    return this->states[lane];
+}
+
+u8 DealerBatch::getDrawCount(u16 lane) const
+{
+    return this->drawCounts[lane];
+}
+
+bool DealerBatch::isKernelSupported(DealerKernel kernel)
+{
+#ifdef BJ2020_DEALER_KERNEL_X86
+    switch (kernel)
+    {
+        case DealerKernel::dealerKernelAvx2:
+            return __builtin_cpu_supports("avx2");
+
+        case DealerKernel::dealerKernelAvx512:
+            return __builtin_cpu_supports("avx512f");
+
+        default:
+            return true;
+    }
+#else
+    return kernel == DealerKernel::dealerKernelScalar;
+#endif
+}
+
+DealerKernel DealerBatch::getBestKernel()
+{
+    static const DealerKernel bestKernel =
+        DealerBatch::isKernelSupported(DealerKernel::dealerKernelAvx512) ? DealerKernel::dealerKernelAvx512 :
+        DealerBatch::isKernelSupported(DealerKernel::dealerKernelAvx2) ? DealerKernel::dealerKernelAvx2 :
+        DealerKernel::dealerKernelScalar;
+
+    return bestKernel;
+}
+
+void DealerBatch::drawOut(DealerBatch& batch, bool hitsSoft17)
+{
+    DealerBatch::drawOut(batch, hitsSoft17, DealerBatch::getBestKernel());
+}
+
+void DealerBatch::drawOut(DealerBatch& batch, bool hitsSoft17, DealerKernel kernel)
+{
+    u16 fromLane = 0;
+
+    if (kernel == DealerKernel::dealerKernelAvx512)
+    {
+        fromLane = DealerBatch::drawOutAvx512(batch, hitsSoft17);
+    }
+    else if (kernel == DealerKernel::dealerKernelAvx2)
+    {
+        fromLane = DealerBatch::drawOutAvx2(batch, hitsSoft17);
+    }
+
+    // Lanes left over from the last full vector
+    DealerBatch::drawOutScalar(batch, hitsSoft17, fromLane);
+}
+
+void DealerBatch::drawOutScalar(DealerBatch& batch, bool hitsSoft17, u16 fromLane)
+{
+    for (u16 lane = fromLane; lane < batch.size(); lane++)
+    {
+        const u8* ranks = batch.upcomingRanks.data() + lane * DealerBatch::maxDrawCount;
+        u8 state = batch.states[lane];
+        u8 drawCount = 0;
+
+        while (HandState::mustDealerDraw(state, hitsSoft17))
+        {
+            state = HandState::getNext(state, ranks[drawCount++]);
+        }
+
+        batch.states[lane] = state;
+        batch.drawCounts[lane] = drawCount;
+    }
+}
+
+#ifdef BJ2020_DEALER_KERNEL_X86
+
+// Every step draws one card for all lanes that still must, the loop ends when no lane of the vector draws
+__attribute__((target("avx2")))
+u16 DealerBatch::drawOutAvx2(DealerBatch& batch, bool hitsSoft17)
+{
+    const int* next = dealerKernelTables.next;
+    const int* mustDraw = dealerKernelTables.mustDraw[hitsSoft17];
+    const int* ranks = (const int*) batch.upcomingRanks.data();
+    u16 vectorEnd = batch.size() - batch.size() % 8;
+
+    const __m256i rankCount = _mm256_set1_epi32(HandState::rankCount);
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+    const __m256i laneOffsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+        _mm256_set1_epi32(DealerBatch::maxDrawCount));
+
+    for (u16 lane = 0; lane < vectorEnd; lane += 8)
+    {
+        __m256i states = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*) (batch.states.data() + lane)));
+        __m256i rankIndexes = _mm256_add_epi32(laneOffsets, _mm256_set1_epi32(lane * DealerBatch::maxDrawCount));
+        __m256i drawCounts = _mm256_setzero_si256();
+        __m256i drawing = _mm256_i32gather_epi32(mustDraw, states, 4);
+
+        while (!_mm256_testz_si256(drawing, drawing))
+        {
+            __m256i upcoming = _mm256_and_si256(_mm256_i32gather_epi32(ranks, rankIndexes, 1), byteMask);
+            __m256i nextStates = _mm256_i32gather_epi32(next,
+                _mm256_add_epi32(_mm256_mullo_epi32(states, rankCount), upcoming), 4);
+
+            states = _mm256_blendv_epi8(states, nextStates, drawing);
+
+            // drawing is -1 in the lanes that drew
+            drawCounts = _mm256_sub_epi32(drawCounts, drawing);
+            rankIndexes = _mm256_sub_epi32(rankIndexes, drawing);
+            drawing = _mm256_and_si256(drawing, _mm256_i32gather_epi32(mustDraw, states, 4));
+        }
+
+        alignas(32) s32 laneStates[8];
+        alignas(32) s32 laneDrawCounts[8];
+
+        _mm256_store_si256((__m256i*) laneStates, states);
+        _mm256_store_si256((__m256i*) laneDrawCounts, drawCounts);
+
+        for (u8 index = 0; index < 8; index++)
+        {
+            batch.states[lane + index] = laneStates[index];
+            batch.drawCounts[lane + index] = laneDrawCounts[index];
+        }
+    }
+
+    return vectorEnd;
+}
+
+__attribute__((target("avx512f")))
+u16 DealerBatch::drawOutAvx512(DealerBatch& batch, bool hitsSoft17)
+{
+    const int* next = dealerKernelTables.next;
+    const int* mustDraw = dealerKernelTables.mustDraw[hitsSoft17];
+    const int* ranks = (const int*) batch.upcomingRanks.data();
+    u16 vectorEnd = batch.size() - batch.size() % 16;
+
+    const __m512i rankCount = _mm512_set1_epi32(HandState::rankCount);
+    const __m512i byteMask = _mm512_set1_epi32(0xFF);
+    const __m512i one = _mm512_set1_epi32(1);
+    const __m512i zero = _mm512_setzero_si512();
+    const __mmask16 allLanes = 0xFFFF;
+    const __m512i laneOffsets = _mm512_mullo_epi32(
+        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+        _mm512_set1_epi32(DealerBatch::maxDrawCount));
+
+    for (u16 lane = 0; lane < vectorEnd; lane += 16)
+    {
+        __m512i states = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*) (batch.states.data() + lane)));
+        __m512i rankIndexes = _mm512_add_epi32(laneOffsets, _mm512_set1_epi32(lane * DealerBatch::maxDrawCount));
+        __m512i drawCounts = _mm512_setzero_si512();
+        __mmask16 drawing = _mm512_test_epi32_mask(
+            _mm512_mask_i32gather_epi32(zero, allLanes, states, mustDraw, 4), one);
+
+        // Only the drawing lanes are gathered and updated, masked gathers start from zero so no lane is left undefined
+        while (drawing != 0)
+        {
+            __m512i upcoming = _mm512_and_si512(
+                _mm512_mask_i32gather_epi32(zero, drawing, rankIndexes, ranks, 1), byteMask);
+
+            states = _mm512_mask_i32gather_epi32(states, drawing,
+                _mm512_add_epi32(_mm512_mullo_epi32(states, rankCount), upcoming), next, 4);
+            drawCounts = _mm512_mask_add_epi32(drawCounts, drawing, drawCounts, one);
+            rankIndexes = _mm512_mask_add_epi32(rankIndexes, drawing, rankIndexes, one);
+            drawing = _mm512_mask_test_epi32_mask(drawing,
+                _mm512_mask_i32gather_epi32(zero, drawing, states, mustDraw, 4), one);
+        }
+
+        _mm_storeu_si128((__m128i*) (batch.states.data() + lane), _mm512_cvtepi32_epi8(states));
+        _mm_storeu_si128((__m128i*) (batch.drawCounts.data() + lane), _mm512_cvtepi32_epi8(drawCounts));
+    }
+
+    return vectorEnd;
+}
+
+#else
+
+u16 DealerBatch::drawOutAvx2(DealerBatch&, bool)
+{
+    return 0;
+}
+
+u16 DealerBatch::drawOutAvx512(DealerBatch&, bool)
+{
+    return 0;
+}
+
+#endif
\ No newline at end of file
@@ -18,3 +18,8 @@ void DisplayMessageParamDealerCards::transformValue(Application* app)
         this->isValueTransformed = true;
     }
 }
+
+const std::vector<Card*>& DisplayMessageParamDealerCards::getCards() const
+{
+    return this->cards;
+}
@@ -12,3 +12,13 @@ void DisplayMessageParamPlayerCards::transformValue(Application* app)
         this->isValueTransformed = true;
     }
 }
+
+const std::vector<std::vector<Card*>>& DisplayMessageParamPlayerCards::getCards() const
+{
+    return this->cards;
+}
+
+u8 DisplayMessageParamPlayerCards::getCurrentHand() const
+{
+    return this->currentHand;
+}
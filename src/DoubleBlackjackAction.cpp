@@ -1,4 +1,5 @@
 #include "DoubleBlackjackAction.h"
+#include "MetricsRegistry.h"
 
 std::string DoubleBlackjackAction::getName()
 {
@@ -13,15 +14,31 @@ bool DoubleBlackjackAction::execute(Box* currentBox)
     currentBox->setBet(currentBet * 2);
     currentBox->giveCard(this->blackjack->getNextCard());
 
+    MetricsRegistry& metrics = MetricsRegistry::getInstance();
+
+    metrics.increment(MetricCounter::metricDoubles);
+
+    if (currentBox->hasOvertake())
+    {
+        metrics.increment(MetricCounter::metricBusts);
+    }
+
     return false;
 }
 
 bool DoubleBlackjackAction::isAvailable(Box* currentBox)
 {
     u32 currentBet = currentBox->getBet();
+    auto& rules = this->blackjack->getRules();
 
-    return currentBox->getHandCount() == 1 &&
+    return (currentBox->getHandCount() == 1 || rules.doubleAfterSplit) &&
+        rules.isDoubleAllowed(currentBox->getHandCardsValue()) &&
         currentBox->getHandCardsCount() == 2 &&
         currentBox->getPlayer().getCash() >= currentBet;
 }
 
+
+u8 DoubleBlackjackAction::getActionType()
+{
+    return BlackjackActionType::doubleAction;
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#include "EarlySurrenderBlackjackAction.h"
+
+std::string EarlySurrenderBlackjackAction::getName()
+{
+    return "Surrender";
+}
+
+bool EarlySurrenderBlackjackAction::execute(Box* currentBox)
+{
+    // Half of the bet is returned at settlement, whatever the dealer has
+    this->blackjack->addSurrenderedBoxIndex(this->blackjack->getBoxIndex(*currentBox));
+
+    return false;
+}
+
+bool EarlySurrenderBlackjackAction::isAvailable(Box* currentBox)
+{
+    return this->blackjack->getRules().surrender == SurrenderRule::surrenderEarly &&
+        currentBox->getHandCount() == 1 &&
+        currentBox->getHandCardsCount() == 2;
+}
+
+u8 EarlySurrenderBlackjackAction::getActionType()
+{
+    return BlackjackActionType::earlySurrenderAction;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include "EuropeanBlackjack.h"
+
+EuropeanBlackjack::EuropeanBlackjack()
+{
+    this->rules = EuropeanBlackjack::toEuropeanRules(this->rules);
+}
+
+void EuropeanBlackjack::setRules(const BlackjackRules& _rules)
+{
+    AmericanBlackjack::setRules(EuropeanBlackjack::toEuropeanRules(_rules));
+}
+
+BlackjackRules EuropeanBlackjack::toEuropeanRules(BlackjackRules _rules)
+{
+    _rules.dealerHoleCard = false;
+    _rules.dealerPeeks = false;
+
+    return _rules;
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include <cstring>
+
+#include "HandHistory.h"
+
+void HandHistoryRound::clear()
+{
+    this->insuredBoxMask = 0;
+    this->flags = 0;
+    this->initialBets.clear();
+    this->actions.clear();
+    this->dealerCards.clear();
+    this->hands.clear();
+}
+
+HandHistoryRecord::HandHistoryRecord(const u8* data)
+    : data{data}
+{}
+
+template <typename T>
+T HandHistoryRecord::readField(u32 offset) const
+{
+    T value;
+
+    std::memcpy(&value, this->data + offset, sizeof(T));
+
+    return value;
+}
+
+u8 HandHistoryRecord::encodeCard(Card& card)
+{
+    return (card.getCardSuit() << 4) | card.getCardNumber();
+}
+
+Card HandHistoryRecord::decodeCard(u8 code)
+{
+    return Card(code & 0x0F, (CardSuit) (code >> 4));
+}
+
+void HandHistoryRecord::encode(const HandHistoryRound& round, std::vector<u8>& output)
+{
+    u64 start = output.size();
+    u32 shoeNumber = round.shoeNumber;
+    u16 reserved = 0;
+
+    auto append = [&output](const void* value, u64 size)
+    {
+        const u8* bytes = static_cast<const u8*>(value);
+
+        output.insert(output.end(), bytes, bytes + size);
+    };
+
+    output.resize(start + 8);
+    output[start + 2] = round.initialBets.size();
+    output[start + 3] = round.hands.size();
+    output[start + 4] = round.dealerCards.size();
+    output[start + 5] = round.actions.size();
+    output[start + 6] = round.insuredBoxMask;
+    output[start + 7] = round.flags;
+
+    append(&round.seed, sizeof(round.seed));
+    append(&shoeNumber, sizeof(shoeNumber));
+    append(&round.shoeIndex, sizeof(round.shoeIndex));
+    append(&reserved, sizeof(reserved));
+    append(round.initialBets.data(), round.initialBets.size() * sizeof(u32));
+    append(round.dealerCards.data(), round.dealerCards.size());
+    for (auto& action : round.actions)
+    {
+        output.push_back((action.boxIndex << 4) | (action.handNumber - 1));
+        output.push_back(action.action);
+    }
+
+    for (auto& hand : round.hands)
+    {
+        u8 cardCount = hand.cards.size();
+
+        append(&hand.boxIndex, 1);
+        append(&hand.handNumber, 1);
+        append(&hand.result, 1);
+        append(&cardCount, 1);
+        append(&hand.bet, sizeof(hand.bet));
+        append(&hand.payout, sizeof(hand.payout));
+        append(hand.cards.data(), cardCount);
+    }
+
+    u16 size = output.size() - start;
+
+    std::memcpy(output.data() + start, &size, sizeof(size));
+}
+
+void HandHistoryRecord::decode(HandHistoryRound& round) const
+{
+    // Hands are overwritten in place so that their card buffers are reused
+    round.initialBets.clear();
+    round.actions.clear();
+    round.dealerCards.clear();
+
+    round.seed = this->getSeed();
+    round.shoeNumber = this->getShoeNumber();
+    round.shoeIndex = this->getShoeIndex();
+    round.insuredBoxMask = this->getInsuredBoxMask();
+    round.flags = this->getFlags();
+
+    for (u8 boxIndex = 0; boxIndex < this->getBoxCount(); boxIndex++)
+    {
+        round.initialBets.push_back(this->getInitialBet(boxIndex));
+    }
+
+    for (u8 index = 0; index < this->getDealerCardCount(); index++)
+    {
+        round.dealerCards.push_back(this->getDealerCard(index));
+    }
+
+    for (u8 index = 0; index < this->getActionCount(); index++)
+    {
+        round.actions.push_back(this->getAction(index));
+    }
+
+    u32 offset = this->getHandsOffset();
+
+    round.hands.resize(this->getHandCount());
+
+    for (auto& hand : round.hands)
+    {
+        u8 cardCount = this->data[offset + 3];
+
+        hand.boxIndex = this->data[offset];
+        hand.handNumber = this->data[offset + 1];
+        hand.result = this->data[offset + 2];
+        hand.bet = this->readField<u32>(offset + 4);
+        hand.payout = this->readField<u32>(offset + 8);
+        hand.cards.assign(this->data + offset + HandHistoryRecord::handHeaderSize,
+            this->data + offset + HandHistoryRecord::handHeaderSize + cardCount);
+
+        offset += HandHistoryRecord::handHeaderSize + cardCount;
+    }
+}
+
+u32 HandHistoryRecord::getHandsOffset() const
+{
+    return HandHistoryRecord::headerSize + this->getBoxCount() * sizeof(u32) + this->getDealerCardCount() +
+        this->getActionCount() * 2;
+}
+
+u16 HandHistoryRecord::getSize() const
+{
+    return this->readField<u16>(0);
+}
+
+u8 HandHistoryRecord::getBoxCount() const
+{
+    return this->data[2];
+}
+
+u8 HandHistoryRecord::getHandCount() const
+{
+    return this->data[3];
+}
+
+u8 HandHistoryRecord::getDealerCardCount() const
+{
+    return this->data[4];
+}
+
+u8 HandHistoryRecord::getActionCount() const
+{
+    return this->data[5];
+}
+
+u8 HandHistoryRecord::getInsuredBoxMask() const
+{
+    return this->data[6];
+}
+
+u8 HandHistoryRecord::getFlags() const
+{
+    return this->data[7];
+}
+
+u64 HandHistoryRecord::getSeed() const
+{
+    return this->readField<u64>(8);
+}
+
+u64 HandHistoryRecord::getShoeNumber() const
+{
+    return this->readField<u32>(16);
+}
+
+u16 HandHistoryRecord::getShoeIndex() const
+{
+    return this->readField<u16>(20);
+}
+
+u32 HandHistoryRecord::getInitialBet(u8 boxIndex) const
+{
+    return this->readField<u32>(HandHistoryRecord::headerSize + boxIndex * sizeof(u32));
+}
+
+u8 HandHistoryRecord::getDealerCard(u8 index) const
+{
+    return this->data[HandHistoryRecord::headerSize + this->getBoxCount() * sizeof(u32) + index];
+}
+
+HandHistoryAction HandHistoryRecord::getAction(u8 index) const
+{
+    const u8* actionData = this->data + HandHistoryRecord::headerSize + this->getBoxCount() * sizeof(u32) +
+        this->getDealerCardCount() + index * 2;
+    HandHistoryAction action;
+
+    action.boxIndex = actionData[0] >> 4;
+    action.handNumber = (actionData[0] & 0x0F) + 1;
+    action.action = actionData[1];
+
+    return action;
+}
+
+u64 HandHistoryRecord::getTotalBet() const
+{
+    u64 totalBet = 0;
+    u32 offset = this->getHandsOffset();
+
+    for (u8 index = 0; index < this->getHandCount(); index++)
+    {
+        totalBet += this->readField<u32>(offset + 4);
+        offset += HandHistoryRecord::handHeaderSize + this->data[offset + 3];
+    }
+
+    return totalBet;
+}
+
+u64 HandHistoryRecord::getTotalPayout() const
+{
+    u64 totalPayout = 0;
+    u32 offset = this->getHandsOffset();
+
+    for (u8 index = 0; index < this->getHandCount(); index++)
+    {
+        totalPayout += this->readField<u32>(offset + 8);
+        offset += HandHistoryRecord::handHeaderSize + this->data[offset + 3];
+    }
+
+    return totalPayout;
+}
\ No newline at end of file
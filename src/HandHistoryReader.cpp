@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "HandHistoryReader.h"
+#include "HandHistoryWriter.h"
+
+HandHistoryReader::HandHistoryReader(const std::string& path)
+{
+#ifndef _WIN32
+    int descriptor = open(path.c_str(), O_RDONLY);
+    struct stat fileStat;
+
+    if (descriptor >= 0 && fstat(descriptor, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        void* mapping = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+        if (mapping != MAP_FAILED)
+        {
+            madvise(mapping, fileStat.st_size, MADV_SEQUENTIAL);
+
+            this->data = static_cast<const u8*>(mapping);
+            this->size = fileStat.st_size;
+            this->isMapped = true;
+        }
+    }
+
+    if (descriptor >= 0)
+    {
+        close(descriptor);
+    }
+#endif
+
+    if (!this->isMapped)
+    {
+        std::ifstream file(path, std::ios::binary);
+
+        if (!file)
+        {
+            throw std::runtime_error("HandHistoryReader::HandHistoryReader(path) - can't open " + path);
+        }
+
+        this->fallbackBuffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        this->data = this->fallbackBuffer.data();
+        this->size = this->fallbackBuffer.size();
+    }
+
+    u32 version = 0;
+    u32 rulesSize = 0;
+    u64 rulesHash = 0;
+
+    if (this->size >= HandHistoryWriter::fileHeaderSize)
+    {
+        std::memcpy(&version, this->data + sizeof(HandHistoryWriter::fileMagic), sizeof(version));
+        std::memcpy(&rulesSize, this->data + 12, sizeof(rulesSize));
+        std::memcpy(&rulesHash, this->data + 16, sizeof(rulesHash));
+    }
+
+    if (version != HandHistoryWriter::fileVersion || rulesSize != sizeof(BlackjackRules) ||
+        !std::equal(this->data, this->data + sizeof(HandHistoryWriter::fileMagic), HandHistoryWriter::fileMagic))
+    {
+        this->unmap();
+
+        throw std::runtime_error("HandHistoryReader::HandHistoryReader(path) - " + path + " is not a hand history log");
+    }
+
+    std::memcpy(&this->rules, this->data + HandHistoryWriter::rulesOffset, sizeof(this->rules));
+
+    if (this->rules.getHash() != rulesHash)
+    {
+        this->unmap();
+
+        throw std::runtime_error("HandHistoryReader::HandHistoryReader(path) - the rules of " + path + " are damaged");
+    }
+
+    this->rewind();
+}
+
+HandHistoryReader::~HandHistoryReader()
+{
+    this->unmap();
+}
+
+void HandHistoryReader::unmap()
+{
+#ifndef _WIN32
+    if (this->isMapped)
+    {
+        munmap(const_cast<u8*>(this->data), this->size);
+
+        this->isMapped = false;
+    }
+#endif
+}
+
+bool HandHistoryReader::next(HandHistoryRecord& record)
+{
+    if (this->offset + HandHistoryRecord::headerSize > this->size)
+    {
+        return false;
+    }
+
+    record = HandHistoryRecord(this->data + this->offset);
+
+    // A record cut off by a crashed writer ends the log
+    if (record.getSize() < HandHistoryRecord::headerSize || this->offset + record.getSize() > this->size)
+    {
+        return false;
+    }
+
+    this->offset += record.getSize();
+
+    return true;
+}
+
+void HandHistoryReader::rewind()
+{
+    this->offset = HandHistoryWriter::fileHeaderSize;
+}
+
+u64 HandHistoryReader::getFileSize() const
+{
+    return this->size;
+}
+
+const BlackjackRules& HandHistoryReader::getRules() const
+{
+    return this->rules;
+}
\ No newline at end of file
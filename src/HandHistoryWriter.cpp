@@ -0,0 +1,90 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "HandHistoryWriter.h"
+#include "HandHistoryReader.h"
+
+constexpr char HandHistoryWriter::fileMagic[8];
+
+HandHistoryWriter::HandHistoryWriter(const std::string& path, const BlackjackRules& rules)
+{
+    this->file = std::fopen(path.c_str(), "ab");
+
+    if (this->file == nullptr)
+    {
+        throw std::runtime_error("HandHistoryWriter::HandHistoryWriter(path, rules) - can't open " + path);
+    }
+
+    this->buffer.reserve(HandHistoryWriter::flushThreshold + 1024);
+
+    // A new log starts with the header, an existing one is appended to
+    std::fseek(this->file, 0, SEEK_END);
+
+    if (std::ftell(this->file) == 0)
+    {
+        u32 rulesSize = sizeof(BlackjackRules);
+        u64 rulesHash = rules.getHash();
+
+        this->buffer.resize(HandHistoryWriter::fileHeaderSize);
+
+        std::memcpy(this->buffer.data(), HandHistoryWriter::fileMagic, sizeof(HandHistoryWriter::fileMagic));
+        std::memcpy(this->buffer.data() + 8, &HandHistoryWriter::fileVersion, sizeof(HandHistoryWriter::fileVersion));
+        std::memcpy(this->buffer.data() + 12, &rulesSize, sizeof(rulesSize));
+        std::memcpy(this->buffer.data() + 16, &rulesHash, sizeof(rulesHash));
+        std::memcpy(this->buffer.data() + HandHistoryWriter::rulesOffset, &rules, sizeof(rules));
+
+        return;
+    }
+
+    std::fclose(this->file);
+
+    // Rounds of other rules would be replayed under the rules of the log
+    if (HandHistoryReader(path).getRules().getHash() != rules.getHash())
+    {
+        throw std::runtime_error("HandHistoryWriter::HandHistoryWriter(path, rules) - " + path +
+            " was recorded under other rules");
+    }
+
+    this->file = std::fopen(path.c_str(), "ab");
+
+    if (this->file == nullptr)
+    {
+        throw std::runtime_error("HandHistoryWriter::HandHistoryWriter(path, rules) - can't open " + path);
+    }
+}
+
+HandHistoryWriter::~HandHistoryWriter()
+{
+    this->flush();
+
+    std::fclose(this->file);
+}
+
+void HandHistoryWriter::write(const HandHistoryRound& round)
+{
+    HandHistoryRecord::encode(round, this->buffer);
+
+    this->recordCount++;
+
+    if (this->buffer.size() >= HandHistoryWriter::flushThreshold)
+    {
+        this->flush();
+    }
+}
+
+void HandHistoryWriter::flush()
+{
+    if (!this->buffer.empty())
+    {
+        std::fwrite(this->buffer.data(), 1, this->buffer.size(), this->file);
+
+        this->buffer.clear();
+    }
+
+    std::fflush(this->file);
+}
+
+u64 HandHistoryWriter::getRecordCount() const
+{
+    return this->recordCount;
+}
\ No newline at end of file
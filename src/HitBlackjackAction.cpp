@@ -1,4 +1,5 @@
 #include "HitBlackjackAction.h"
+#include "MetricsRegistry.h"
 
 std::string HitBlackjackAction::getName()
 {
@@ -9,10 +10,20 @@ bool HitBlackjackAction::execute(Box* currentBox)
 {
     currentBox->giveCard(this->blackjack->getNextCard());
 
+    if (currentBox->hasOvertake())
+    {
+        MetricsRegistry::getInstance().increment(MetricCounter::metricBusts);
+    }
+
     return true;
 }
 
 bool HitBlackjackAction::isAvailable(Box* currentBox)
 {
     return true;
+}
+
+u8 HitBlackjackAction::getActionType()
+{
+    return BlackjackActionType::hitAction;
 }
\ No newline at end of file
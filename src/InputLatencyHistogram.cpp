@@ -0,0 +1,120 @@
+#include "InputLatencyHistogram.h"
+
+u16 InputLatencyHistogram::getBucketIndex(u64 value)
+{
+    if (value < (1 << InputLatencyHistogram::subBucketBits))
+    {
+        return value;
+    }
+
+    u8 magnitude = 1;
+
+    while ((value >> magnitude) >= (1 << InputLatencyHistogram::subBucketBits))
+    {
+        magnitude++;
+    }
+
+    return (1 << InputLatencyHistogram::subBucketBits) + (magnitude - 1) * InputLatencyHistogram::halfSubBucketCount +
+        (value >> magnitude) - InputLatencyHistogram::halfSubBucketCount;
+}
+
+u64 InputLatencyHistogram::getBucketValue(u16 index)
+{
+    if (index < (1 << InputLatencyHistogram::subBucketBits))
+    {
+        return index;
+    }
+
+    u16 offset = index - (1 << InputLatencyHistogram::subBucketBits);
+    u8 magnitude = offset / InputLatencyHistogram::halfSubBucketCount + 1;
+    u64 subBucket = offset % InputLatencyHistogram::halfSubBucketCount + InputLatencyHistogram::halfSubBucketCount;
+
+    return ((subBucket + 1) << magnitude) - 1;
+}
+
+void InputLatencyHistogram::record(u64 value)
+{
+    if (value > InputLatencyHistogram::maxValue)
+    {
+        value = InputLatencyHistogram::maxValue;
+    }
+
+    // Single writer: plain relaxed stores, readers see each counter either before or after the update
+    std::atomic<u64>& bucket = this->buckets[InputLatencyHistogram::getBucketIndex(value)];
+
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    this->sum.store(this->sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    this->count.store(this->count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    if (value > this->max.load(std::memory_order_relaxed))
+    {
+        this->max.store(value, std::memory_order_relaxed);
+    }
+}
+
+u64 InputLatencyHistogram::getCount() const
+{
+    return this->count.load(std::memory_order_relaxed);
+}
+
+u64 InputLatencyHistogram::getMax() const
+{
+    return this->max.load(std::memory_order_relaxed);
+}
+
+f64 InputLatencyHistogram::getMean() const
+{
+    u64 _count = this->getCount();
+
+    return _count ? (f64) this->sum.load(std::memory_order_relaxed) / _count : 0.0;
+}
+
+u64 InputLatencyHistogram::getValueAtPercentile(f64 percent) const
+{
+    u64 totalCount = 0;
+
+    for (auto& bucket : this->buckets)
+    {
+        totalCount += bucket.load(std::memory_order_relaxed);
+    }
+
+    if (totalCount == 0)
+    {
+        return 0;
+    }
+
+    u64 targetCount = (u64) (percent / 100.0 * totalCount + 0.5);
+    u64 cumulativeCount = 0;
+
+    if (targetCount == 0)
+    {
+        targetCount = 1;
+    }
+
+    for (u16 index = 0; index < InputLatencyHistogram::bucketCount; index++)
+    {
+        cumulativeCount += this->buckets[index].load(std::memory_order_relaxed);
+
+        if (cumulativeCount >= targetCount)
+        {
+            u64 value = InputLatencyHistogram::getBucketValue(index);
+            u64 _max = this->getMax();
+
+            return value < _max ? value : _max;
+        }
+    }
+
+    return this->getMax();
+}
+
+void InputLatencyHistogram::reset()
+{
+    for (auto& bucket : this->buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+
+    this->count.store(0, std::memory_order_relaxed);
+    this->sum.store(0, std::memory_order_relaxed);
+    this->max.store(0, std::memory_order_relaxed);
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include <iomanip>
+
+#include "InputLatencyRecorder.h"
+
+InputLatencyRecorder& InputLatencyRecorder::getInstance()
+{
+    static InputLatencyRecorder recorder;
+
+    return recorder;
+}
+
+const char* InputLatencyRecorder::getKindName(InputKind kind)
+{
+    switch (kind)
+    {
+        case InputKind::inputName:
+            return "name";
+
+        case InputKind::inputStartCash:
+            return "start cash";
+
+        case InputKind::inputBet:
+            return "bet";
+
+        case InputKind::inputAction:
+            return "action";
+
+        default:
+            return "option";
+    }
+}
+
+const char* InputLatencyRecorder::getPhaseName(InputPhase phase)
+{
+    switch (phase)
+    {
+        case InputPhase::inputPhasePrompt:
+            return "prompt";
+
+        case InputPhase::inputPhaseWait:
+            return "wait";
+
+        case InputPhase::inputPhaseProcessing:
+            return "processing";
+
+        default:
+            return "retries";
+    }
+}
+
+const InputLatencyHistogram& InputLatencyRecorder::getHistogram(InputKind kind, InputPhase phase) const
+{
+    return this->histograms[kind][phase];
+}
+
+void InputLatencyRecorder::reset()
+{
+    for (auto& kindHistograms : this->histograms)
+    {
+        for (auto& histogram : kindHistograms)
+        {
+            histogram.reset();
+        }
+    }
+}
+
+void InputLatencyRecorder::printSummary(std::ostream& output) const
+{
+    output << "Input       | Phase      |    Count |      p50 |      p90 |      p99 |      Max |     Mean" << std::endl;
+
+    for (u8 kind = 0; kind < InputLatencyRecorder::kindCount; kind++)
+    {
+        if (this->histograms[kind][InputPhase::inputPhaseWait].getCount() == 0)
+        {
+            continue;
+        }
+
+        for (u8 phase = 0; phase < InputLatencyRecorder::phaseCount; phase++)
+        {
+            const InputLatencyHistogram& histogram = this->histograms[kind][phase];
+
+            // Retries are plain counts, everything else is shown in milliseconds
+            f64 scale = phase == InputPhase::inputPhaseRetries ? 1.0 : 1e6;
+
+            output << std::left << std::setw(11) << InputLatencyRecorder::getKindName((InputKind) kind) << " | "
+                << std::setw(10) << InputLatencyRecorder::getPhaseName((InputPhase) phase) << " | " << std::right
+                << std::setw(8) << histogram.getCount() << std::fixed << std::setprecision(3)
+                << " | " << std::setw(8) << histogram.getValueAtPercentile(50) / scale
+                << " | " << std::setw(8) << histogram.getValueAtPercentile(90) / scale
+                << " | " << std::setw(8) << histogram.getValueAtPercentile(99) / scale
+                << " | " << std::setw(8) << histogram.getMax() / scale
+                << " | " << std::setw(8) << histogram.getMean() / scale << std::defaultfloat << std::endl;
+        }
+    }
+}
\ No newline at end of file
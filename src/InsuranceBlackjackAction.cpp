@@ -21,10 +21,17 @@ bool InsuranceBlackjackAction::isAvailable(Box* currentBox)
     auto& dealerBox = this->blackjack->getDealerBox();
     u8 currentBoxIndex = this->blackjack->getBoxIndex(*currentBox);
 
-    return !this->blackjack->hasInsuredBoxIndex(currentBoxIndex) &&
+    // A dealer who peeks offers insurance before the check only, see AbstractBlackjack::canInsureBox()
+    return !this->blackjack->getRules().dealerPeeks &&
+        !this->blackjack->hasInsuredBoxIndex(currentBoxIndex) &&
         dealerBox.getHandCards().size() == 2 &&
         dealerBox.getHandCards()[0]->getCardLetter() == "A" &&
         currentBox->getHandCount() == 1 &&
         currentBox->getHandCardsCount() == 2 &&
         currentBox->getPlayer().getCash() >= currentBox->getBet() / 2;
+}
+
+u8 InsuranceBlackjackAction::getActionType()
+{
+    return BlackjackActionType::insuranceAction;
 }
\ No newline at end of file
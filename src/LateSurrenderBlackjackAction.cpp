@@ -0,0 +1,26 @@
+#include "LateSurrenderBlackjackAction.h"
+
+std::string LateSurrenderBlackjackAction::getName()
+{
+    return "Surrender";
+}
+
+bool LateSurrenderBlackjackAction::execute(Box* currentBox)
+{
+    // Half of the bet is returned at settlement, unless the dealer turns out to have a blackjack
+    this->blackjack->addSurrenderedBoxIndex(this->blackjack->getBoxIndex(*currentBox));
+
+    return false;
+}
+
+bool LateSurrenderBlackjackAction::isAvailable(Box* currentBox)
+{
+    return this->blackjack->getRules().surrender == SurrenderRule::surrenderLate &&
+        currentBox->getHandCount() == 1 &&
+        currentBox->getHandCardsCount() == 2;
+}
+
+u8 LateSurrenderBlackjackAction::getActionType()
+{
+    return BlackjackActionType::lateSurrenderAction;
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "LuckyLadiesSideBet.h"
+
+u8 LuckyLadiesSideBet::getValue(u8 cardNumber)
+{
+    if (cardNumber == CardFace::ace)
+    {
+        return 11;
+    }
+
+    return cardNumber > 10 ? 10 : cardNumber;
+}
+
+bool LuckyLadiesSideBet::isQueenOfHearts(const Card& card)
+{
+    return card.getCardNumber() == CardFace::queen && card.getCardSuit() == CardSuit::heart;
+}
+
+std::string LuckyLadiesSideBet::getName() const
+{
+    return "Lucky Ladies";
+}
+
+u16 LuckyLadiesSideBet::getPayout(const Card& playerCard1, const Card& playerCard2,
+    const Card& dealerUpcard, const Card& dealerSecondCard) const
+{
+    if (LuckyLadiesSideBet::getValue(playerCard1.getCardNumber()) + LuckyLadiesSideBet::getValue(playerCard2.getCardNumber()) != 20)
+    {
+        return 0;
+    }
+
+    if (LuckyLadiesSideBet::isQueenOfHearts(playerCard1) && LuckyLadiesSideBet::isQueenOfHearts(playerCard2))
+    {
+        bool dealerHasBlackjack = LuckyLadiesSideBet::getValue(dealerUpcard.getCardNumber()) +
+            LuckyLadiesSideBet::getValue(dealerSecondCard.getCardNumber()) == 21;
+
+        return dealerHasBlackjack ? LuckyLadiesSideBet::queenPairDealerBlackjackPayout : LuckyLadiesSideBet::queenPairPayout;
+    }
+
+    if (playerCard1.getCardSuit() != playerCard2.getCardSuit())
+    {
+        return LuckyLadiesSideBet::unsuitedPayout;
+    }
+
+    return playerCard1.getCardNumber() == playerCard2.getCardNumber() ? LuckyLadiesSideBet::matchedPayout : LuckyLadiesSideBet::suitedPayout;
+}
+
+f64 LuckyLadiesSideBet::getExpectedValue(const ShoeComposition& composition) const
+{
+    // Ordered two-card draws of each kind
+    f64 matchedCount = 0;
+    f64 suitedCount = 0;
+    f64 tenCount = 0;
+
+    for (u8 suit = 1; suit <= 4; suit++)
+    {
+        f64 suitTenCount = 0;
+        f64 suitTenSquares = 0;
+
+        for (u8 cardNumber = 10; cardNumber <= CardFace::king; cardNumber++)
+        {
+            f64 count = composition.getCount(cardNumber, suit);
+
+            matchedCount += count * (count - 1);
+            suitTenCount += count;
+            suitTenSquares += count * count;
+        }
+
+        // Ten-valued cards of different ranks, and an ace with a nine
+        suitedCount += suitTenCount * suitTenCount - suitTenSquares +
+            2.0 * composition.getCount(CardFace::ace, suit) * composition.getCount(9, suit);
+        tenCount += suitTenCount;
+    }
+
+    f64 queenCount = composition.getCount(CardFace::queen, CardSuit::heart);
+    f64 queenPairCount = queenCount * (queenCount - 1);
+    f64 aceCount = composition.getRankCount(CardFace::ace);
+    f64 totalCount = composition.getTotalCount();
+    f64 twentyCount = tenCount * (tenCount - 1) + 2.0 * aceCount * composition.getRankCount(9);
+    f64 unsuitedCount = twentyCount - matchedCount - suitedCount;
+
+    matchedCount -= queenPairCount;
+
+    // The dealer's two cards come from what is left after the two queens
+    f64 dealerBlackjackChance = totalCount > 3 ?
+        2.0 * aceCount * (tenCount - 2) / ((totalCount - 2) * (totalCount - 3)) : 0;
+    f64 queenPairReturn = dealerBlackjackChance * (LuckyLadiesSideBet::queenPairDealerBlackjackPayout + 1) +
+        (1 - dealerBlackjackChance) * (LuckyLadiesSideBet::queenPairPayout + 1);
+
+    return (queenPairReturn * queenPairCount +
+        (LuckyLadiesSideBet::matchedPayout + 1) * matchedCount +
+        (LuckyLadiesSideBet::suitedPayout + 1) * suitedCount +
+        (LuckyLadiesSideBet::unsuitedPayout + 1) * unsuitedCount) / (totalCount * (totalCount - 1)) - 1;
+}
\ No newline at end of file
@@ -0,0 +1,431 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "MessageCatalog.h"
+
+constexpr char MessageCatalog::fileMagic[8];
+
+namespace
+{
+    std::string trim(const std::string& value)
+    {
+        u64 begin = value.find_first_not_of(" \t\r");
+        u64 end = value.find_last_not_of(" \t\r");
+
+        return begin == std::string::npos ? "" : value.substr(begin, end - begin + 1);
+    }
+
+    MessageLayout parseLayout(const std::string& value)
+    {
+        if (value == "line")
+        {
+            return MessageLayout::messageLine;
+        }
+
+        if (value == "inline")
+        {
+            return MessageLayout::messageInline;
+        }
+
+        if (value == "pause")
+        {
+            return MessageLayout::messagePause;
+        }
+
+        throw std::invalid_argument("expected line, inline or pause, got " + value);
+    }
+
+    MessageCatalogEntry appendString(std::vector<u8>& text, const std::string& value)
+    {
+        if (value.size() > UINT16_MAX)
+        {
+            throw std::invalid_argument("a template can't be longer than 65535 bytes");
+        }
+
+        MessageCatalogEntry entry = {(u32) text.size(), (u16) value.size(), 0, 0};
+
+        text.insert(text.end(), value.begin(), value.end());
+
+        return entry;
+    }
+}
+
+MessageCatalog::MessageCatalog(const std::string& path)
+{
+#ifndef _WIN32
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    struct stat fileStat;
+
+    if (descriptor >= 0 && fstat(descriptor, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        void* mapping = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+
+        if (mapping != MAP_FAILED)
+        {
+            this->data = static_cast<const u8*>(mapping);
+            this->size = fileStat.st_size;
+            this->isMapped = true;
+        }
+    }
+
+    if (descriptor >= 0)
+    {
+        close(descriptor);
+    }
+#endif
+
+    if (!this->isMapped)
+    {
+        std::ifstream file(path, std::ios::binary);
+
+        if (!file)
+        {
+            throw std::runtime_error("MessageCatalog::MessageCatalog(path) - can't open " + path);
+        }
+
+        this->fallbackBuffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        this->data = this->fallbackBuffer.data();
+        this->size = this->fallbackBuffer.size();
+    }
+
+    this->attach(path);
+}
+
+MessageCatalog::~MessageCatalog()
+{
+    this->unmap();
+}
+
+void MessageCatalog::unmap()
+{
+#ifndef _WIN32
+    if (this->isMapped)
+    {
+        munmap(const_cast<u8*>(this->data), this->size);
+
+        this->isMapped = false;
+    }
+#endif
+}
+
+void MessageCatalog::attach(const std::string& name)
+{
+    this->header = reinterpret_cast<const MessageCatalogHeader*>(this->data);
+
+    bool isValid = this->size >= sizeof(MessageCatalogHeader) &&
+        std::memcmp(this->header->magic, MessageCatalog::fileMagic, sizeof(MessageCatalog::fileMagic)) == 0 &&
+        this->header->version == MessageCatalog::fileVersion && this->header->size == this->size;
+
+    u64 entryCount = isValid ? (u64) this->header->localeCount * (1 + this->header->messageCount) + this->header->messageCount : 0;
+
+    isValid = isValid && sizeof(MessageCatalogHeader) + entryCount * sizeof(MessageCatalogEntry) <= this->header->textOffset &&
+        this->header->textOffset <= this->size;
+
+    if (isValid)
+    {
+        this->locales = reinterpret_cast<const MessageCatalogEntry*>(this->data + sizeof(MessageCatalogHeader));
+        this->messageIds = this->locales + this->header->localeCount;
+        this->templates = this->messageIds + this->header->messageCount;
+
+        for (u64 index = 0; index < entryCount; index++)
+        {
+            const MessageCatalogEntry& entry = this->locales[index];
+
+            isValid = isValid && entry.layout <= MessageLayout::messagePause &&
+                (u64) this->header->textOffset + entry.offset + entry.length <= this->size;
+        }
+    }
+
+    if (!isValid)
+    {
+        this->unmap();
+
+        throw std::runtime_error("MessageCatalog::attach(name) - " + name + " is not a message catalog");
+    }
+}
+
+std::unique_ptr<MessageCatalog> MessageCatalog::open(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(MessageCatalog::fileMagic)] = {};
+
+    if (!file)
+    {
+        throw std::runtime_error("MessageCatalog::open(path) - can't open " + path);
+    }
+
+    if (file.read(magic, sizeof(magic)) && std::memcmp(magic, MessageCatalog::fileMagic, sizeof(magic)) == 0)
+    {
+        return std::unique_ptr<MessageCatalog>(new MessageCatalog(path));
+    }
+
+    file.clear();
+    file.seekg(0);
+
+    try
+    {
+        return MessageCatalog::compileToMemory(file);
+    }
+    catch (const std::invalid_argument& exception)
+    {
+        throw std::invalid_argument(path + ": " + exception.what());
+    }
+}
+
+std::vector<u8> MessageCatalog::compile(std::istream& source)
+{
+    // Locales in the order they appear, messages sorted by id
+    std::vector<std::pair<std::string, std::map<std::string, std::pair<MessageLayout, std::string>>>> locales;
+    std::string line;
+    u32 lineNumber = 0;
+
+    while (std::getline(source, line))
+    {
+        lineNumber++;
+        line = trim(line);
+
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        try
+        {
+            if (line.front() == '[' && line.back() == ']')
+            {
+                std::string locale = trim(line.substr(1, line.size() - 2));
+
+                if (locale.empty())
+                {
+                    throw std::invalid_argument("empty locale name");
+                }
+
+                for (auto& existingLocale : locales)
+                {
+                    if (existingLocale.first == locale)
+                    {
+                        throw std::invalid_argument("locale " + locale + " is defined twice");
+                    }
+                }
+
+                locales.emplace_back(locale, std::map<std::string, std::pair<MessageLayout, std::string>>());
+
+                continue;
+            }
+
+            u64 separator = line.find('=');
+            std::string key = trim(line.substr(0, separator));
+            u64 keySeparator = key.find_first_of(" \t");
+
+            if (separator == std::string::npos || keySeparator == std::string::npos)
+            {
+                throw std::invalid_argument("expected <message id> <line|inline|pause> = <template>");
+            }
+
+            if (locales.empty())
+            {
+                throw std::invalid_argument("message before the first [locale]");
+            }
+
+            std::string messageId = key.substr(0, keySeparator);
+            MessageLayout layout = parseLayout(trim(key.substr(keySeparator)));
+
+            if (!locales.back().second.emplace(messageId, std::make_pair(layout, trim(line.substr(separator + 1)))).second)
+            {
+                throw std::invalid_argument("message " + messageId + " is defined twice");
+            }
+        }
+        catch (const std::invalid_argument& exception)
+        {
+            throw std::invalid_argument("line " + std::to_string(lineNumber) + ": " + exception.what());
+        }
+    }
+
+    if (locales.empty())
+    {
+        throw std::invalid_argument("the catalog has no locale");
+    }
+
+    if (locales.size() > UINT16_MAX || locales.front().second.size() > UINT16_MAX)
+    {
+        throw std::invalid_argument("a catalog can't have more than 65535 locales or messages");
+    }
+
+    auto& messages = locales.front().second;
+
+    for (auto& locale : locales)
+    {
+        bool hasSameIds = locale.second.size() == messages.size();
+
+        for (auto it = messages.begin(), localeIt = locale.second.begin(); hasSameIds && it != messages.end(); it++, localeIt++)
+        {
+            hasSameIds = it->first == localeIt->first;
+        }
+
+        if (!hasSameIds)
+        {
+            throw std::invalid_argument("locale " + locale.first + " doesn't define the messages of " + locales.front().first);
+        }
+    }
+
+    std::vector<MessageCatalogEntry> entries;
+    std::vector<u8> text;
+
+    for (auto& locale : locales)
+    {
+        entries.push_back(appendString(text, locale.first));
+    }
+
+    for (auto& message : messages)
+    {
+        entries.push_back(appendString(text, message.first));
+    }
+
+    for (auto& locale : locales)
+    {
+        for (auto& message : locale.second)
+        {
+            entries.push_back(appendString(text, message.second.second));
+            entries.back().layout = message.second.first;
+        }
+    }
+
+    MessageCatalogHeader header = {};
+    std::vector<u8> compiledData(sizeof(header) + entries.size() * sizeof(MessageCatalogEntry));
+
+    std::memcpy(header.magic, MessageCatalog::fileMagic, sizeof(header.magic));
+    header.version = MessageCatalog::fileVersion;
+    header.size = compiledData.size() + text.size();
+    header.localeCount = locales.size();
+    header.messageCount = messages.size();
+    header.textOffset = compiledData.size();
+
+    std::memcpy(compiledData.data(), &header, sizeof(header));
+    std::memcpy(compiledData.data() + sizeof(header), entries.data(), entries.size() * sizeof(MessageCatalogEntry));
+    compiledData.insert(compiledData.end(), text.begin(), text.end());
+
+    return compiledData;
+}
+
+std::unique_ptr<MessageCatalog> MessageCatalog::compileToMemory(std::istream& source)
+{
+    std::unique_ptr<MessageCatalog> catalog(new MessageCatalog());
+
+    catalog->fallbackBuffer = MessageCatalog::compile(source);
+    catalog->data = catalog->fallbackBuffer.data();
+    catalog->size = catalog->fallbackBuffer.size();
+    catalog->attach("compiled catalog");
+
+    return catalog;
+}
+
+void MessageCatalog::write(const std::string& path, const std::vector<u8>& compiledData)
+{
+    // Written aside and renamed, so that a running game never maps a half-written catalog
+    std::string temporaryPath = path + ".tmp" + std::to_string(std::random_device{}());
+
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+        if (!file.write(reinterpret_cast<const char*>(compiledData.data()), compiledData.size()))
+        {
+            throw std::runtime_error("MessageCatalog::write(path, compiledData) - can't write " + temporaryPath);
+        }
+    }
+
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporaryPath.c_str());
+
+        throw std::runtime_error("MessageCatalog::write(path, compiledData) - can't rename to " + path);
+    }
+}
+
+std::string_view MessageCatalog::getString(const MessageCatalogEntry& entry) const
+{
+    return std::string_view(reinterpret_cast<const char*>(this->data + this->header->textOffset + entry.offset), entry.length);
+}
+
+u16 MessageCatalog::getLocaleCount() const
+{
+    return this->header->localeCount;
+}
+
+u16 MessageCatalog::getMessageCount() const
+{
+    return this->header->messageCount;
+}
+
+std::string_view MessageCatalog::getLocaleName(u16 localeIndex) const
+{
+    return this->getString(this->locales[localeIndex]);
+}
+
+s32 MessageCatalog::findLocale(std::string_view locale) const
+{
+    for (u16 index = 0; index < this->header->localeCount; index++)
+    {
+        if (this->getLocaleName(index) == locale)
+        {
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+s32 MessageCatalog::findMessage(std::string_view messageId) const
+{
+    u16 begin = 0;
+    u16 end = this->header->messageCount;
+
+    while (begin < end)
+    {
+        u16 middle = begin + (end - begin) / 2;
+        int comparison = this->getMessageId(middle).compare(messageId);
+
+        if (comparison == 0)
+        {
+            return middle;
+        }
+
+        if (comparison < 0)
+        {
+            begin = middle + 1;
+        }
+        else
+        {
+            end = middle;
+        }
+    }
+
+    return -1;
+}
+
+std::string_view MessageCatalog::getMessageId(u16 messageIndex) const
+{
+    return this->getString(this->messageIds[messageIndex]);
+}
+
+std::string_view MessageCatalog::getTemplate(u16 localeIndex, u16 messageIndex) const
+{
+    return this->getString(this->templates[localeIndex * this->header->messageCount + messageIndex]);
+}
+
+MessageLayout MessageCatalog::getLayout(u16 localeIndex, u16 messageIndex) const
+{
+    return MessageLayout(this->templates[localeIndex * this->header->messageCount + messageIndex].layout);
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "MetricsRegistry.h"
+
+MetricsRegistry& MetricsRegistry::getInstance()
+{
+    static MetricsRegistry registry;
+
+    return registry;
+}
+
+const char* MetricsRegistry::getCounterName(MetricCounter counter)
+{
+    switch (counter)
+    {
+        case MetricCounter::metricRounds:
+            return "bj2020_rounds_total";
+
+        case MetricCounter::metricHands:
+            return "bj2020_hands_total";
+
+        case MetricCounter::metricSplits:
+            return "bj2020_splits_total";
+
+        case MetricCounter::metricDoubles:
+            return "bj2020_doubles_total";
+
+        case MetricCounter::metricBusts:
+            return "bj2020_busts_total";
+
+        case MetricCounter::metricBlackjacks:
+            return "bj2020_blackjacks_total";
+
+        case MetricCounter::metricReshuffles:
+            return "bj2020_reshuffles_total";
+
+        default:
+            return "bj2020_eliminated_players_total";
+    }
+}
+
+const char* MetricsRegistry::getHistogramName(MetricHistogram histogram)
+{
+    switch (histogram)
+    {
+        case MetricHistogram::metricDecisionLatency:
+            return "bj2020_decision_latency_seconds";
+
+        default:
+            return "bj2020_round_duration_seconds";
+    }
+}
+
+MetricsShard& MetricsRegistry::registerShard()
+{
+    std::lock_guard<std::mutex> lock(this->shardsMutex);
+
+    this->shards.emplace_back(new MetricsShard());
+    localShard = this->shards.back().get();
+
+    return *localShard;
+}
+
+u64 MetricsRegistry::getCounter(MetricCounter counter) const
+{
+    std::lock_guard<std::mutex> lock(this->shardsMutex);
+    u64 value = 0;
+
+    for (auto& shard : this->shards)
+    {
+        value += shard->counters[counter].load(std::memory_order_relaxed);
+    }
+
+    return value;
+}
+
+u64 MetricsRegistry::getHistogramCount(MetricHistogram histogram) const
+{
+    std::lock_guard<std::mutex> lock(this->shardsMutex);
+    u64 value = 0;
+
+    for (auto& shard : this->shards)
+    {
+        for (u8 bucket = 0; bucket < MetricsShard::bucketCount; bucket++)
+        {
+            value += shard->buckets[histogram][bucket].load(std::memory_order_relaxed);
+        }
+    }
+
+    return value;
+}
+
+void MetricsRegistry::writePrometheus(std::ostream& output) const
+{
+    u64 counters[MetricsShard::counterCount] = {};
+    u64 buckets[MetricsShard::histogramCount][MetricsShard::bucketCount] = {};
+    u64 sumsNs[MetricsShard::histogramCount] = {};
+
+    {
+        std::lock_guard<std::mutex> lock(this->shardsMutex);
+
+        for (auto& shard : this->shards)
+        {
+            for (u8 counter = 0; counter < MetricsShard::counterCount; counter++)
+            {
+                counters[counter] += shard->counters[counter].load(std::memory_order_relaxed);
+            }
+
+            for (u8 histogram = 0; histogram < MetricsShard::histogramCount; histogram++)
+            {
+                for (u8 bucket = 0; bucket < MetricsShard::bucketCount; bucket++)
+                {
+                    buckets[histogram][bucket] += shard->buckets[histogram][bucket].load(std::memory_order_relaxed);
+                }
+
+                sumsNs[histogram] += shard->sumsNs[histogram].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    for (u8 counter = 0; counter < MetricsShard::counterCount; counter++)
+    {
+        const char* name = MetricsRegistry::getCounterName((MetricCounter) counter);
+
+        output << "# TYPE " << name << " counter\n";
+        output << name << " " << counters[counter] << "\n";
+    }
+
+    for (u8 histogram = 0; histogram < MetricsShard::histogramCount; histogram++)
+    {
+        const char* name = MetricsRegistry::getHistogramName((MetricHistogram) histogram);
+        u64 cumulativeCount = 0;
+
+        output << "# TYPE " << name << " histogram\n";
+
+        // Prometheus buckets are cumulative
+        for (u8 bucket = 0; bucket < MetricsShard::bucketCount; bucket++)
+        {
+            cumulativeCount += buckets[histogram][bucket];
+
+            output << name << "_bucket{le=\"";
+
+            if (bucket < MetricsShard::bucketCount - 1)
+            {
+                output << (f64) ((u64) 1 << (bucket + 10)) / 1e9;
+            }
+            else
+            {
+                output << "+Inf";
+            }
+
+            output << "\"} " << cumulativeCount << "\n";
+        }
+
+        output << name << "_sum " << sumsNs[histogram] / 1e9 << "\n";
+        output << name << "_count " << cumulativeCount << "\n";
+    }
+}
\ No newline at end of file
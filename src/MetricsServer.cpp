@@ -0,0 +1,164 @@
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+#include "MetricsServer.h"
+#include "InputLatencyRecorder.h"
+
+MetricsServer::MetricsServer(u16 port, MetricsRegistry& registry)
+    : registry{registry}, port{port}
+{}
+
+MetricsServer::~MetricsServer()
+{
+    this->stop();
+}
+
+void MetricsServer::start()
+{
+#ifndef _WIN32
+    this->listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+
+    if (this->listenSocket < 0)
+    {
+        throw std::runtime_error("MetricsServer::start() - can't create a socket");
+    }
+
+    int reuseAddress = 1;
+    setsockopt(this->listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuseAddress, sizeof(reuseAddress));
+
+    // Loopback only, the metrics are not meant to leave the host
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(this->port);
+
+    socklen_t addressLength = sizeof(address);
+
+    if (bind(this->listenSocket, (sockaddr*) &address, sizeof(address)) != 0 || listen(this->listenSocket, 8) != 0 ||
+        getsockname(this->listenSocket, (sockaddr*) &address, &addressLength) != 0)
+    {
+        close(this->listenSocket);
+        this->listenSocket = -1;
+
+        throw std::runtime_error("MetricsServer::start() - can't listen on port " + std::to_string(this->port));
+    }
+
+    this->port = ntohs(address.sin_port);
+    this->serving = true;
+    this->serveThread = std::thread(&MetricsServer::serveLoop, this);
+#else
+    throw std::runtime_error("MetricsServer::start() - not supported on this platform");
+#endif
+}
+
+void MetricsServer::stop()
+{
+    if (!this->serving)
+    {
+        return;
+    }
+
+    this->serving = false;
+    this->serveThread.join();
+
+#ifndef _WIN32
+    close(this->listenSocket);
+#endif
+
+    this->listenSocket = -1;
+}
+
+u16 MetricsServer::getPort() const
+{
+    return this->port;
+}
+
+void MetricsServer::serveLoop()
+{
+#ifndef _WIN32
+    pollfd listenPoll{this->listenSocket, POLLIN, 0};
+
+    while (this->serving)
+    {
+        // Wakes up regularly to notice stop()
+        if (poll(&listenPoll, 1, 100) <= 0)
+        {
+            continue;
+        }
+
+        int clientSocket = accept(this->listenSocket, nullptr, nullptr);
+
+        if (clientSocket >= 0)
+        {
+            this->serveClient(clientSocket);
+
+            close(clientSocket);
+        }
+    }
+#endif
+}
+
+void MetricsServer::serveClient(int clientSocket)
+{
+#ifndef _WIN32
+    // Scrapers send a short GET, the headers are read up to their end and ignored
+    std::string request;
+    char buffer[1024];
+    pollfd clientPoll{clientSocket, POLLIN, 0};
+
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192 && poll(&clientPoll, 1, 1000) > 0)
+    {
+        ssize_t readSize = recv(clientSocket, buffer, sizeof(buffer), 0);
+
+        if (readSize <= 0)
+        {
+            break;
+        }
+
+        request.append(buffer, readSize);
+    }
+
+    std::ostringstream body;
+    std::string status = "200 OK";
+
+    if (request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 6, "GET / ") == 0)
+    {
+        body.precision(9);
+        this->registry.writePrometheus(body);
+    }
+    else if (request.compare(0, 19, "GET /input-latency ") == 0)
+    {
+        InputLatencyRecorder::getInstance().printSummary(body);
+    }
+    else
+    {
+        status = "404 Not Found";
+    }
+
+    std::string content = body.str();
+    std::string response = "HTTP/1.1 " + status + "\r\n"
+        "Content-Type: text/plain; version=0.0.4\r\n"
+        "Content-Length: " + std::to_string(content.size()) + "\r\n"
+        "Connection: close\r\n\r\n" + content;
+
+    for (size_t sentSize = 0; sentSize < response.size();)
+    {
+        ssize_t writeSize = send(clientSocket, response.data() + sentSize, response.size() - sentSize, MSG_NOSIGNAL);
+
+        if (writeSize <= 0)
+        {
+            break;
+        }
+
+        sentSize += writeSize;
+    }
+#endif
+}
\ No newline at end of file
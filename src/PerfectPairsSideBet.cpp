@@ -0,0 +1,64 @@
+#include "PerfectPairsSideBet.h"
+
+bool PerfectPairsSideBet::isRed(u8 suit)
+{
+    return suit == CardSuit::diamond || suit == CardSuit::heart;
+}
+
+std::string PerfectPairsSideBet::getName() const
+{
+    return "Perfect Pairs";
+}
+
+u16 PerfectPairsSideBet::getPayout(const Card& playerCard1, const Card& playerCard2, const Card&, const Card&) const
+{
+    if (playerCard1.getCardNumber() != playerCard2.getCardNumber())
+    {
+        return 0;
+    }
+
+    if (playerCard1.getCardSuit() == playerCard2.getCardSuit())
+    {
+        return PerfectPairsSideBet::perfectPairPayout;
+    }
+
+    if (PerfectPairsSideBet::isRed(playerCard1.getCardSuit()) == PerfectPairsSideBet::isRed(playerCard2.getCardSuit()))
+    {
+        return PerfectPairsSideBet::coloredPairPayout;
+    }
+
+    return PerfectPairsSideBet::mixedPairPayout;
+}
+
+f64 PerfectPairsSideBet::getExpectedValue(const ShoeComposition& composition) const
+{
+    // Ordered two-card draws of each kind
+    f64 perfectCount = 0;
+    f64 coloredCount = 0;
+    f64 pairCount = 0;
+
+    for (u8 cardNumber = 2; cardNumber <= 14; cardNumber++)
+    {
+        f64 rankCount = composition.getRankCount(cardNumber);
+
+        for (u8 suit = 1; suit <= 4; suit++)
+        {
+            f64 count = composition.getCount(cardNumber, suit);
+
+            perfectCount += count * (count - 1);
+        }
+
+        coloredCount += 2.0 * composition.getCount(cardNumber, CardSuit::club) * composition.getCount(cardNumber, CardSuit::spade) +
+            2.0 * composition.getCount(cardNumber, CardSuit::diamond) * composition.getCount(cardNumber, CardSuit::heart);
+        pairCount += rankCount * (rankCount - 1);
+    }
+
+    f64 totalCount = composition.getTotalCount();
+    f64 drawCount = totalCount * (totalCount - 1);
+    f64 mixedCount = pairCount - perfectCount - coloredCount;
+
+    // Winning stakes come back with the winnings
+    return ((PerfectPairsSideBet::perfectPairPayout + 1) * perfectCount +
+        (PerfectPairsSideBet::coloredPairPayout + 1) * coloredCount +
+        (PerfectPairsSideBet::mixedPairPayout + 1) * mixedCount) / drawCount - 1;
+}
\ No newline at end of file
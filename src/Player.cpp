@@ -11,6 +11,11 @@ void Player::decreaseCash(u32 amount)
 	this->cash -= amount;
 }
 
+void Player::setCash(u32 amount)
+{
+	this->cash = amount;
+}
+
 std::string Player::getName() const
 {
     return this->name;
@@ -0,0 +1,225 @@
+#include "ReplayBlackjack.h"
+
+ReplayBlackjack::ReplayBlackjack()
+{
+    this->shoeCache.resize(ReplayBlackjack::shoeCacheSize);
+    this->players.reserve(ReplayBlackjack::maxBoxCount);
+
+    for (u8 boxNumber = 1; boxNumber <= ReplayBlackjack::maxBoxCount; boxNumber++)
+    {
+        this->players.emplace_back(nullptr, "Replay " + std::to_string(boxNumber), ReplayBlackjack::bankroll);
+    }
+}
+
+void ReplayBlackjack::prepareGame()
+{}
+
+void ReplayBlackjack::playGame()
+{}
+
+void ReplayBlackjack::finishGame()
+{}
+
+void ReplayBlackjack::replay(HandHistoryReader& reader)
+{
+    HandHistoryRecord record;
+
+    while (reader.next(record))
+    {
+        this->replayRound(record);
+    }
+}
+
+bool ReplayBlackjack::replayRound(const HandHistoryRecord& record)
+{
+    u64 mismatchCount = this->mismatchCount;
+
+    record.decode(this->round);
+
+    this->roundCount++;
+    this->loadShoe(this->round.seed, this->round.shoeNumber, this->round.shoeIndex);
+    this->prepareBoxes(this->round.initialBets.size());
+
+    for (u8 boxIndex = 0; boxIndex < this->boxes.size(); boxIndex++)
+    {
+        this->boxes[boxIndex].setBet(this->round.initialBets[boxIndex]);
+    }
+
+    this->dealCardsToBoxes(2);
+    this->dealCardsToDealer(this->getInitialDealerCardCount());
+
+    for (auto& action : this->round.actions)
+    {
+        if (action.action == handHistoryInsuranceCollected)
+        {
+            this->collectInsurances();
+
+            continue;
+        }
+
+        if (action.boxIndex >= this->boxes.size() || action.action >= this->actions.size() ||
+            action.handNumber > this->boxes[action.boxIndex].getHandCount())
+        {
+            this->reportMismatch("invalid action");
+            this->resetRound();
+
+            return false;
+        }
+
+        Box& box = this->boxes[action.boxIndex];
+
+        box.switchHand(action.handNumber);
+
+        this->actions[action.action]->execute(&box);
+    }
+
+    this->drawDealerCards();
+
+    if (!this->compareCards(this->dealerBox->getHandCards(), this->round.dealerCards))
+    {
+        this->reportMismatch("dealer cards differ");
+    }
+
+    for (auto& hand : this->round.hands)
+    {
+        if (hand.boxIndex >= this->boxes.size() || hand.handNumber > this->boxes[hand.boxIndex].getHandCount())
+        {
+            this->reportMismatch("hand " + std::to_string(hand.boxIndex) + "/" + std::to_string(hand.handNumber) +
+                " was not played");
+
+            continue;
+        }
+
+        Box& box = this->boxes[hand.boxIndex];
+        u32 cash = box.getPlayer().getCash();
+        u32 winCash = 0;
+
+        box.switchHand(hand.handNumber);
+
+        if (!this->compareCards(box.getHandCards(), hand.cards) || box.getBet() != hand.bet)
+        {
+            this->reportMismatch("hand " + std::to_string(hand.boxIndex) + "/" + std::to_string(hand.handNumber) +
+                " cards or stake differ");
+        }
+
+        this->settleHand(&box, hand.boxIndex, winCash);
+
+        u32 payout = box.getPlayer().getCash() - cash;
+
+        if (payout != hand.payout)
+        {
+            this->reportMismatch("hand " + std::to_string(hand.boxIndex) + "/" + std::to_string(hand.handNumber) +
+                " pays " + std::to_string(payout) + " instead of " + std::to_string(hand.payout));
+        }
+
+        this->handCount++;
+    }
+
+    this->resetRound();
+
+    return mismatchCount == this->mismatchCount;
+}
+
+void ReplayBlackjack::loadShoe(u64 seed, u64 shoeNumber, u16 shoeIndex)
+{
+    CachedShoe& cachedShoe = this->shoeCache[shoeNumber % ReplayBlackjack::shoeCacheSize];
+
+    if (!cachedShoe.isValid || cachedShoe.seed != seed || cachedShoe.shoeNumber != shoeNumber)
+    {
+        this->setRunSeed(seed);
+        this->setNextShoeNumber(shoeNumber);
+        this->createShoe(this->rules.deckCount);
+        this->shuffleShoe();
+
+        cachedShoe.seed = seed;
+        cachedShoe.shoeNumber = shoeNumber;
+        cachedShoe.isValid = true;
+        cachedShoe.cards = this->shoe;
+    }
+    else
+    {
+        this->shoe = cachedShoe.cards;
+    }
+
+    this->shoeIndex = shoeIndex;
+}
+
+void ReplayBlackjack::prepareBoxes(u8 boxCount)
+{
+    if (this->boxes.size() != boxCount)
+    {
+        this->boxes.clear();
+        this->createBoxes(this->players, boxCount);
+    }
+}
+
+bool ReplayBlackjack::compareCards(const std::vector<Card*>& cards, const std::vector<u8>& recordedCards)
+{
+    if (cards.size() != recordedCards.size())
+    {
+        return false;
+    }
+
+    for (u8 index = 0; index < cards.size(); index++)
+    {
+        if (HandHistoryRecord::encodeCard(*cards[index]) != recordedCards[index])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ReplayBlackjack::reportMismatch(const std::string& mismatch)
+{
+    this->mismatchCount++;
+
+    if (this->mismatches.size() < ReplayBlackjack::maxReportedMismatchCount)
+    {
+        this->mismatches.push_back("Round " + std::to_string(this->roundCount) + ": " + mismatch);
+    }
+}
+
+void ReplayBlackjack::resetRound()
+{
+    for (auto& box : this->boxes)
+    {
+        u32 cash = box.getPlayer().getCash();
+
+        if (cash > ReplayBlackjack::bankroll)
+        {
+            box.getPlayer().decreaseCash(cash - ReplayBlackjack::bankroll);
+        }
+        else
+        {
+            box.getPlayer().increaseCash(ReplayBlackjack::bankroll - cash);
+        }
+
+        box.resetBox();
+    }
+
+    this->dealerBox->resetBox();
+    this->insuredBoxIndexes.clear();
+    this->surrenderedBoxIndexes.clear();
+}
+
+u64 ReplayBlackjack::getRoundCount() const
+{
+    return this->roundCount;
+}
+
+u64 ReplayBlackjack::getHandCount() const
+{
+    return this->handCount;
+}
+
+u64 ReplayBlackjack::getMismatchCount() const
+{
+    return this->mismatchCount;
+}
+
+const std::vector<std::string>& ReplayBlackjack::getMismatches() const
+{
+    return this->mismatches;
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "RoundProfiler.h"
+
+RoundProfiler& RoundProfiler::getInstance()
+{
+    static RoundProfiler profiler;
+
+    return profiler;
+}
+
+const char* RoundProfiler::getPhaseName(ProfilePhase phase)
+{
+    switch (phase)
+    {
+        case ProfilePhase::phaseBet:
+            return "bet";
+
+        case ProfilePhase::phaseDeal:
+            return "deal";
+
+        case ProfilePhase::phasePlayerActions:
+            return "player actions";
+
+        case ProfilePhase::phaseDealerDraw:
+            return "dealer draw";
+
+        default:
+            return "settlement";
+    }
+}
+
+u64 RoundProfiler::getNowNs() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->startTime).count();
+}
+
+void RoundProfiler::record(ProfilePhase phase, u64 startNs, u64 durationNs, u64 allocationCount, u64 allocationBytes)
+{
+    ProfilePhaseSummary& summary = this->summaries[phase];
+
+    summary.count++;
+    summary.totalNs += durationNs;
+    summary.allocationCount += allocationCount;
+    summary.allocationBytes += allocationBytes;
+
+    if (durationNs > summary.maxNs)
+    {
+        summary.maxNs = durationNs;
+    }
+
+    if (this->events.size() < RoundProfiler::maxEventCount)
+    {
+        this->events.push_back({phase, startNs, durationNs, allocationCount, allocationBytes});
+    }
+}
+
+void RoundProfiler::reset()
+{
+    this->events.clear();
+
+    for (auto& summary : this->summaries)
+    {
+        summary = ProfilePhaseSummary();
+    }
+
+    this->startTime = std::chrono::steady_clock::now();
+}
+
+const std::vector<ProfileEvent>& RoundProfiler::getEvents() const
+{
+    return this->events;
+}
+
+const ProfilePhaseSummary& RoundProfiler::getSummary(ProfilePhase phase) const
+{
+    return this->summaries[phase];
+}
+
+void RoundProfiler::writeChromeTrace(std::ostream& stream) const
+{
+    // Complete ("X") events of the trace event format, timestamps are in microseconds
+    stream << "{\"traceEvents\":[";
+
+    for (u64 index = 0; index < this->events.size(); index++)
+    {
+        const ProfileEvent& event = this->events[index];
+
+        stream << (index ? ",\n" : "\n")
+            << "{\"name\":\"" << RoundProfiler::getPhaseName(event.phase) << "\",\"cat\":\"round\",\"ph\":\"X\""
+            << ",\"ts\":" << event.startNs / 1000.0 << ",\"dur\":" << event.durationNs / 1000.0
+            << ",\"pid\":1,\"tid\":1,\"args\":{\"allocations\":" << event.allocationCount
+            << ",\"bytes\":" << event.allocationBytes << "}}";
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ns\"}" << std::endl;
+}
+
+void RoundProfiler::printSummary(std::ostream& stream) const
+{
+    stream << "Phase | Count | Total ms | Mean us | Max us | Allocations per call | Bytes per call" << std::endl;
+
+    for (u8 phase = 0; phase < RoundProfiler::phaseCount; phase++)
+    {
+        const ProfilePhaseSummary& summary = this->summaries[phase];
+
+        if (summary.count == 0)
+        {
+            continue;
+        }
+
+        stream << RoundProfiler::getPhaseName((ProfilePhase) phase) << " | " << summary.count
+            << " | " << summary.totalNs / 1e6
+            << " | " << summary.totalNs / 1e3 / summary.count
+            << " | " << summary.maxNs / 1e3
+            << " | " << (f64) summary.allocationCount / summary.count
+            << " | " << (f64) summary.allocationBytes / summary.count << std::endl;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "ShoeComposition.h"
+
+void ShoeComposition::reset(u8 deckCount)
+{
+    *this = ShoeComposition();
+
+    for (u8 cardNumber = 2; cardNumber <= 14; cardNumber++)
+    {
+        for (u8 suit = 1; suit <= 4; suit++)
+        {
+            this->cardCounts[cardNumber][suit] = deckCount;
+        }
+
+        this->rankCounts[cardNumber] = 4 * deckCount;
+    }
+
+    for (u8 suit = 1; suit <= 4; suit++)
+    {
+        this->suitCounts[suit] = 13 * deckCount;
+    }
+
+    this->totalCount = 52 * deckCount;
+}
+
+void ShoeComposition::remove(const Card& card)
+{
+    u8 cardNumber = card.getCardNumber();
+    u8 suit = card.getCardSuit();
+
+    this->cardCounts[cardNumber][suit]--;
+    this->rankCounts[cardNumber]--;
+    this->suitCounts[suit]--;
+    this->totalCount--;
+}
\ No newline at end of file
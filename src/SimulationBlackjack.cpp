@@ -0,0 +1,367 @@
+#include "SimulationBlackjack.h"
+
+SimulationBlackjack::SimulationBlackjack(u8 boxCount, u32 flatBet)
+    : boxCount{boxCount}, flatBet{flatBet}
+{
+    for (u8 boxNumber = 1; boxNumber <= boxCount; boxNumber++)
+    {
+        this->players.emplace_back(nullptr, "Bot " + std::to_string(boxNumber), SimulationBlackjack::bankroll);
+    }
+}
+
+void SimulationBlackjack::prepareGame()
+{
+    this->createBoxes(this->players, this->boxCount);
+}
+
+void SimulationBlackjack::playGame()
+{
+    BasicStrategy strategy;
+    DecisionBatch batch;
+
+    batch.reserve(this->boxCount);
+
+    for (u64 roundNumber = 0; roundNumber < this->roundLimit; roundNumber++)
+    {
+        if (this->needsNewShoe())
+        {
+            this->startShoe();
+        }
+
+        this->beginRound();
+
+        while (true)
+        {
+            batch.clear();
+
+            this->appendPendingHands(batch);
+
+            if (batch.size() == 0)
+            {
+                break;
+            }
+
+            AbstractBlackjack::evaluateActionMasks(batch, this->rules);
+            strategy.decideBatch(batch);
+
+            this->applyDecisions(batch, 0, batch.size());
+        }
+
+        this->finishRound();
+    }
+}
+
+void SimulationBlackjack::finishGame()
+{}
+
+void SimulationBlackjack::requestBets()
+{
+    for (auto& box : this->getBoxes())
+    {
+        box.setBet(this->flatBet);
+    }
+}
+
+std::vector<Player>& SimulationBlackjack::getSeatedPlayers()
+{
+    return this->players;
+}
+
+void SimulationBlackjack::writeSnapshot(SnapshotWriter& writer)
+{
+    AbstractBlackjack::writeSnapshot(writer);
+
+    writer.writeVector(this->boxFinished);
+    writer.write(this->runningCount);
+    writer.write(this->countedShoeIndex);
+    writer.write(this->trueCount);
+    this->result.writeSnapshot(writer);
+}
+
+void SimulationBlackjack::readSnapshot(SnapshotReader& reader)
+{
+    AbstractBlackjack::readSnapshot(reader);
+
+    reader.readVector(this->boxFinished);
+    this->runningCount = reader.read<s16>();
+    this->countedShoeIndex = reader.read<u16>();
+    this->trueCount = reader.read<s8>();
+    this->result.readSnapshot(reader);
+
+    this->composition.reset(this->rules.deckCount);
+
+    for (u16 index = 0; index < this->countedShoeIndex; index++)
+    {
+        this->composition.remove(this->shoe[index]);
+    }
+
+    this->updateShoeRanks();
+}
+
+void SimulationBlackjack::setRoundLimit(u64 _roundLimit)
+{
+    this->roundLimit = _roundLimit;
+}
+
+void SimulationBlackjack::addSideBet(AbstractSideBet* sideBet)
+{
+    if (this->sideBets.size() >= SimulationResult::maxSideBetCount)
+    {
+        throw std::length_error("SimulationBlackjack::addSideBet(sideBet) - too many side bets");
+    }
+
+    this->sideBets.push_back(sideBet);
+    this->sideBetEvs.push_back(0);
+}
+
+bool SimulationBlackjack::needsNewShoe()
+{
+    return this->shoe.empty() || this->shoeIndex >= this->shoe.size() * this->rules.penetration ||
+        this->shouldShoeBeReassembled(this->players.size());
+}
+
+void SimulationBlackjack::startShoe()
+{
+    this->createShoe(this->rules.deckCount);
+    this->shuffleShoe();
+    this->updateShoeRanks();
+
+    this->runningCount = 0;
+    this->countedShoeIndex = 0;
+    this->composition.reset(this->rules.deckCount);
+}
+
+void SimulationBlackjack::updateShoeRanks()
+{
+    this->shoeRanks.clear();
+
+    if (this->shoeMode != ShoeMode::shoeCards)
+    {
+        return;
+    }
+
+    for (auto& card : this->shoe)
+    {
+        this->shoeRanks.push_back(HandState::getRank(card.getCardValue()));
+    }
+}
+
+s8 SimulationBlackjack::updateTrueCount()
+{
+    // Every card dealt before this round has been seen by the time bets are placed
+    for (; this->countedShoeIndex < this->shoeIndex; this->countedShoeIndex++)
+    {
+        u8 cardValue = this->shoe[this->countedShoeIndex].getCardValue();
+
+        this->composition.remove(this->shoe[this->countedShoeIndex]);
+
+        if (cardValue <= 6)
+        {
+            this->runningCount++;
+        }
+        else if (cardValue >= 10)
+        {
+            this->runningCount--;
+        }
+    }
+
+    f32 remainingDeckCount = (this->shoe.size() - this->shoeIndex) / 52.0f;
+
+    if (remainingDeckCount < 0.5f)
+    {
+        remainingDeckCount = 0.5f;
+    }
+
+    s16 trueCount = (s16) (this->runningCount / remainingDeckCount);
+
+    if (trueCount < SimulationResult::minTrueCount)
+    {
+        return SimulationResult::minTrueCount;
+    }
+
+    if (trueCount > SimulationResult::maxTrueCount)
+    {
+        return SimulationResult::maxTrueCount;
+    }
+
+    return trueCount;
+}
+
+void SimulationBlackjack::beginRound()
+{
+    this->trueCount = this->updateTrueCount();
+
+    for (u8 index = 0; index < this->sideBets.size(); index++)
+    {
+        this->sideBetEvs[index] = this->sideBets[index]->getExpectedValue(this->composition);
+    }
+
+    this->requestBets();
+    this->recordRoundStart();
+    this->roundShoeIndex = this->shoeIndex;
+    this->dealCardsToBoxes(2);
+    this->dealCardsToDealer(this->getInitialDealerCardCount());
+
+    this->boxFinished.assign(this->boxes.size(), false);
+
+    // Under a hole card check a dealer blackjack ends the round before anybody acts.
+    // Insurance and even money would be offered before the check, but basic strategy never takes them.
+    bool isRoundDecided = this->rules.dealerPeeks && this->dealerBox->hasBlackjack();
+
+    for (auto& box : this->boxes)
+    {
+        if (isRoundDecided || box.hasBlackjack())
+        {
+            this->boxFinished[this->getBoxIndex(box)] = true;
+        }
+    }
+}
+
+void SimulationBlackjack::appendPendingHands(DecisionBatch& batch)
+{
+    for (auto& box : this->boxes)
+    {
+        if (!this->boxFinished[this->getBoxIndex(box)])
+        {
+            this->appendToDecisionBatch(batch, box);
+        }
+    }
+}
+
+void SimulationBlackjack::applyDecisions(DecisionBatch& batch, u16 fromIndex, u16 toIndex)
+{
+    for (u16 index = fromIndex; index < toIndex; index++)
+    {
+        this->applyDecision(*batch.boxes[index], batch.decisions[index]);
+    }
+}
+
+void SimulationBlackjack::applyDecision(Box& box, u8 action)
+{
+    this->recordAction(box, action);
+    this->result.addAction(action);
+
+    bool continueHand = this->actions[action]->execute(&box);
+
+    if (!continueHand || box.getHandCardsValue() >= this->allowedMaxValueForPlayer)
+    {
+        this->finishHand(box);
+    }
+}
+
+void SimulationBlackjack::finishHand(Box& box)
+{
+    // Split hands are played one after another, new hands are always appended at the end
+    while (box.getCurrentHandNumber() < box.getHandCount())
+    {
+        box.switchHand(box.getCurrentHandNumber() + 1);
+
+        if (box.getHandCardsValue() < this->allowedMaxValueForPlayer)
+        {
+            return;
+        }
+    }
+
+    this->boxFinished[this->getBoxIndex(box)] = true;
+}
+
+void SimulationBlackjack::appendDealerHand(DealerBatch& batch)
+{
+    if (this->shoeMode != ShoeMode::shoeCards)
+    {
+        return;
+    }
+
+    this->dealerLane = batch.size();
+
+    batch.appendLane(this->dealerBox->getHandState(), this->shoeRanks.data() + this->shoeIndex,
+        this->shoeRanks.size() - this->shoeIndex);
+}
+
+void SimulationBlackjack::takeDealerCards(const DealerBatch& batch)
+{
+    if (this->shoeMode != ShoeMode::shoeCards)
+    {
+        return;
+    }
+
+    for (u8 drawCount = batch.getDrawCount(this->dealerLane); drawCount > 0; drawCount--)
+    {
+        this->dealerBox->giveCard(this->getNextCard());
+    }
+}
+
+void SimulationBlackjack::finishRound()
+{
+    u32 winCash = 0;
+
+    this->drawDealerCards();
+    this->recordRoundHands();
+    this->settleSideBets();
+
+    for (auto& box : this->boxes)
+    {
+        u8 boxIndex = this->getBoxIndex(box);
+
+        for (u8 handNumber = 1; handNumber <= box.getHandCount(); handNumber++)
+        {
+            box.switchHand(handNumber);
+
+            this->result.addHands(1, box.getBet());
+            this->settleHand(&box, boxIndex, winCash);
+        }
+
+        u32 cash = box.getPlayer().getCash();
+
+        this->result.addBoxRound(this->trueCount, (s32) (cash - SimulationBlackjack::bankroll));
+
+        // Bots never run out of money: every round starts from the same bankroll
+        if (cash > SimulationBlackjack::bankroll)
+        {
+            box.getPlayer().decreaseCash(cash - SimulationBlackjack::bankroll);
+        }
+        else
+        {
+            box.getPlayer().increaseCash(SimulationBlackjack::bankroll - cash);
+        }
+
+        box.resetBox();
+    }
+
+    this->recordRoundFinish();
+
+    this->dealerBox->resetBox();
+    this->insuredBoxIndexes.clear();
+    this->surrenderedBoxIndexes.clear();
+    this->result.addRound();
+}
+
+void SimulationBlackjack::settleSideBets()
+{
+    if (this->sideBets.empty())
+    {
+        return;
+    }
+
+    auto& dealerCards = this->dealerBox->getHandCards();
+
+    // Boxes were dealt their two cards one box after another
+    for (u8 boxIndex = 0; boxIndex < this->boxes.size(); boxIndex++)
+    {
+        const Card& playerCard1 = this->shoe[this->roundShoeIndex + 2 * boxIndex];
+        const Card& playerCard2 = this->shoe[this->roundShoeIndex + 2 * boxIndex + 1];
+
+        for (u8 index = 0; index < this->sideBets.size(); index++)
+        {
+            u16 payout = this->sideBets[index]->getPayout(playerCard1, playerCard2, *dealerCards[0], *dealerCards[1]);
+            s32 netResult = payout > 0 ? (s32) (payout * this->flatBet) : -(s32) this->flatBet;
+
+            this->result.addSideBet(index, this->sideBetEvs[index], this->flatBet, netResult);
+        }
+    }
+}
+
+const SimulationResult& SimulationBlackjack::getResult() const
+{
+    return this->result;
+}
\ No newline at end of file
@@ -0,0 +1,443 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "SimulationResult.h"
+
+constexpr char SimulationResult::fileMagic[8];
+
+u8 SimulationResult::getBucketIndex(s8 trueCount)
+{
+    if (trueCount < SimulationResult::minTrueCount)
+    {
+        trueCount = SimulationResult::minTrueCount;
+    }
+    else if (trueCount > SimulationResult::maxTrueCount)
+    {
+        trueCount = SimulationResult::maxTrueCount;
+    }
+
+    return trueCount - SimulationResult::minTrueCount;
+}
+
+u8 SimulationResult::getSideBetBucketIndex(f64 expectedValue)
+{
+    f64 percent = std::round(100 * expectedValue);
+
+    if (percent < SimulationResult::minSideBetEv)
+    {
+        percent = SimulationResult::minSideBetEv;
+    }
+    else if (percent > SimulationResult::maxSideBetEv)
+    {
+        percent = SimulationResult::maxSideBetEv;
+    }
+
+    return (s16) percent - SimulationResult::minSideBetEv;
+}
+
+f64 SimulationResult::getMean(s64 sum, u64 count)
+{
+    return count ? (f64) sum / count : 0;
+}
+
+f64 SimulationResult::getConfidenceHalfWidth(s64 sum, u64 squares, u64 count)
+{
+    if (count < 2)
+    {
+        return 0;
+    }
+
+    f64 mean = (f64) sum / count;
+    f64 variance = ((f64) squares - mean * sum) / (count - 1);
+
+    // 95% normal interval of the mean
+    return 1.96 * std::sqrt(variance / count);
+}
+
+void SimulationResult::setShoeRange(u64 _seed, u64 _firstShoe, u64 _shoeCount)
+{
+    this->seed = _seed;
+    this->firstShoe = _firstShoe;
+    this->shoeCount = _shoeCount;
+}
+
+void SimulationResult::addRound()
+{
+    this->roundCount++;
+}
+
+void SimulationResult::addHands(u8 _handCount, u32 bet)
+{
+    this->handCount += _handCount;
+    this->totalBet += bet;
+}
+
+void SimulationResult::addBoxRound(s8 trueCount, s32 _netResult)
+{
+    u8 bucketIndex = SimulationResult::getBucketIndex(trueCount);
+    u64 square = (s64) _netResult * _netResult;
+
+    this->boxRoundCount++;
+    this->netResult += _netResult;
+    this->netResultSquares += square;
+
+    this->bucketBoxRoundCounts[bucketIndex]++;
+    this->bucketNetResults[bucketIndex] += _netResult;
+    this->bucketNetResultSquares[bucketIndex] += square;
+}
+
+void SimulationResult::addAction(u8 action)
+{
+    if (action < SimulationResult::actionTypeCount)
+    {
+        this->actionCounts[action]++;
+    }
+}
+
+void SimulationResult::addSideBet(u8 sideBetIndex, f64 expectedValue, u32 stake, s32 _netResult)
+{
+    u8 bucketIndex = SimulationResult::getSideBetBucketIndex(expectedValue);
+
+    if (sideBetIndex < SimulationResult::maxSideBetCount)
+    {
+        this->sideBetCounts[sideBetIndex][bucketIndex]++;
+        this->sideBetStakes[sideBetIndex][bucketIndex] += stake;
+        this->sideBetNetResults[sideBetIndex][bucketIndex] += _netResult;
+    }
+}
+
+void SimulationResult::merge(const SimulationResult& result)
+{
+    if (this->shoeCount > 0 && result.shoeCount > 0 && this->seed != result.seed)
+    {
+        throw std::invalid_argument("SimulationResult::merge(result) - results of different seeds can't be merged");
+    }
+
+    if (this->shoeCount == 0)
+    {
+        this->seed = result.seed;
+        this->firstShoe = result.firstShoe;
+    }
+    else if (result.shoeCount > 0 && result.firstShoe < this->firstShoe)
+    {
+        this->firstShoe = result.firstShoe;
+    }
+
+    this->shoeCount += result.shoeCount;
+    this->roundCount += result.roundCount;
+    this->handCount += result.handCount;
+    this->totalBet += result.totalBet;
+    this->boxRoundCount += result.boxRoundCount;
+    this->netResult += result.netResult;
+    this->netResultSquares += result.netResultSquares;
+
+    for (u8 index = 0; index < SimulationResult::trueCountBucketCount; index++)
+    {
+        this->bucketBoxRoundCounts[index] += result.bucketBoxRoundCounts[index];
+        this->bucketNetResults[index] += result.bucketNetResults[index];
+        this->bucketNetResultSquares[index] += result.bucketNetResultSquares[index];
+    }
+
+    for (u8 action = 0; action < SimulationResult::actionTypeCount; action++)
+    {
+        this->actionCounts[action] += result.actionCounts[action];
+    }
+
+    for (u8 sideBetIndex = 0; sideBetIndex < SimulationResult::maxSideBetCount; sideBetIndex++)
+    {
+        for (u8 index = 0; index < SimulationResult::sideBetEvBucketCount; index++)
+        {
+            this->sideBetCounts[sideBetIndex][index] += result.sideBetCounts[sideBetIndex][index];
+            this->sideBetStakes[sideBetIndex][index] += result.sideBetStakes[sideBetIndex][index];
+            this->sideBetNetResults[sideBetIndex][index] += result.sideBetNetResults[sideBetIndex][index];
+        }
+    }
+}
+
+void SimulationResult::subtract(const SimulationResult& result)
+{
+    this->roundCount -= result.roundCount;
+    this->handCount -= result.handCount;
+    this->totalBet -= result.totalBet;
+    this->boxRoundCount -= result.boxRoundCount;
+    this->netResult -= result.netResult;
+    this->netResultSquares -= result.netResultSquares;
+
+    for (u8 index = 0; index < SimulationResult::trueCountBucketCount; index++)
+    {
+        this->bucketBoxRoundCounts[index] -= result.bucketBoxRoundCounts[index];
+        this->bucketNetResults[index] -= result.bucketNetResults[index];
+        this->bucketNetResultSquares[index] -= result.bucketNetResultSquares[index];
+    }
+
+    for (u8 action = 0; action < SimulationResult::actionTypeCount; action++)
+    {
+        this->actionCounts[action] -= result.actionCounts[action];
+    }
+
+    for (u8 sideBetIndex = 0; sideBetIndex < SimulationResult::maxSideBetCount; sideBetIndex++)
+    {
+        for (u8 index = 0; index < SimulationResult::sideBetEvBucketCount; index++)
+        {
+            this->sideBetCounts[sideBetIndex][index] -= result.sideBetCounts[sideBetIndex][index];
+            this->sideBetStakes[sideBetIndex][index] -= result.sideBetStakes[sideBetIndex][index];
+            this->sideBetNetResults[sideBetIndex][index] -= result.sideBetNetResults[sideBetIndex][index];
+        }
+    }
+}
+
+void SimulationResult::writeToFile(const std::string& path) const
+{
+    SnapshotWriter writer;
+
+    writer.writeBytes(SimulationResult::fileMagic, sizeof(SimulationResult::fileMagic));
+    writer.write(SimulationResult::fileVersion);
+    this->writeSnapshot(writer);
+    writer.writeToFile(path);
+}
+
+void SimulationResult::readFromFile(const std::string& path)
+{
+    SnapshotReader reader;
+    char magic[sizeof(SimulationResult::fileMagic)];
+
+    reader.readFromFile(path);
+    reader.readBytes(magic, sizeof(magic));
+
+    if (!std::equal(magic, magic + sizeof(magic), SimulationResult::fileMagic) ||
+        reader.read<u32>() != SimulationResult::fileVersion)
+    {
+        throw std::runtime_error("SimulationResult::readFromFile(path) - " + path + " is not a simulation result file");
+    }
+
+    this->readSnapshot(reader);
+}
+
+void SimulationResult::writeSnapshot(SnapshotWriter& writer) const
+{
+    writer.write(this->seed);
+    writer.write(this->firstShoe);
+    writer.write(this->shoeCount);
+    writer.write(this->roundCount);
+    writer.write(this->handCount);
+    writer.write(this->totalBet);
+    writer.write(this->boxRoundCount);
+    writer.write(this->netResult);
+    writer.write(this->netResultSquares);
+    writer.write(this->bucketBoxRoundCounts);
+    writer.write(this->bucketNetResults);
+    writer.write(this->bucketNetResultSquares);
+    writer.write(this->actionCounts);
+    writer.write(this->sideBetCounts);
+    writer.write(this->sideBetStakes);
+    writer.write(this->sideBetNetResults);
+}
+
+void SimulationResult::readSnapshot(SnapshotReader& reader)
+{
+    this->seed = reader.read<u64>();
+    this->firstShoe = reader.read<u64>();
+    this->shoeCount = reader.read<u64>();
+    this->roundCount = reader.read<u64>();
+    this->handCount = reader.read<u64>();
+    this->totalBet = reader.read<u64>();
+    this->boxRoundCount = reader.read<u64>();
+    this->netResult = reader.read<s64>();
+    this->netResultSquares = reader.read<u64>();
+    reader.readBytes(this->bucketBoxRoundCounts, sizeof(this->bucketBoxRoundCounts));
+    reader.readBytes(this->bucketNetResults, sizeof(this->bucketNetResults));
+    reader.readBytes(this->bucketNetResultSquares, sizeof(this->bucketNetResultSquares));
+    reader.readBytes(this->actionCounts, sizeof(this->actionCounts));
+    reader.readBytes(this->sideBetCounts, sizeof(this->sideBetCounts));
+    reader.readBytes(this->sideBetStakes, sizeof(this->sideBetStakes));
+    reader.readBytes(this->sideBetNetResults, sizeof(this->sideBetNetResults));
+}
+
+void SimulationResult::printSummary(std::ostream& stream) const
+{
+    f64 averageBet = this->boxRoundCount ? (f64) this->totalBet / this->boxRoundCount : 0;
+    f64 mean = SimulationResult::getMean(this->netResult, this->boxRoundCount);
+    f64 halfWidth = SimulationResult::getConfidenceHalfWidth(this->netResult, this->netResultSquares, this->boxRoundCount);
+
+    stream << "Seed: " << this->seed << std::endl;
+    stream << "Shoes: " << this->shoeCount << " (first " << this->firstShoe << ")" << std::endl;
+    stream << "Rounds: " << this->roundCount << std::endl;
+    stream << "Hands: " << this->handCount << std::endl;
+    stream << "Total bet: " << this->totalBet << std::endl;
+    stream << "Net result: " << this->netResult << std::endl;
+    stream << "Net per box and round: " << mean << " +/- " << halfWidth << " (95%)" << std::endl;
+
+    if (averageBet > 0)
+    {
+        stream << "Player edge: " << 100.0 * this->netResult / this->totalBet << "%" << std::endl;
+    }
+
+    stream << "Actions per hand:";
+
+    for (u8 action = 0; action < SimulationResult::actionTypeCount; action++)
+    {
+        if (this->actionCounts[action] > 0)
+        {
+            stream << " " << (u16) action << "=" << (f64) this->actionCounts[action] / this->handCount;
+        }
+    }
+
+    stream << std::endl;
+    stream << "True count | Box rounds | Net per box and round" << std::endl;
+
+    for (u8 index = 0; index < SimulationResult::trueCountBucketCount; index++)
+    {
+        if (this->bucketBoxRoundCounts[index] == 0)
+        {
+            continue;
+        }
+
+        stream << (s16) (index + SimulationResult::minTrueCount) << " | " << this->bucketBoxRoundCounts[index] << " | "
+            << SimulationResult::getMean(this->bucketNetResults[index], this->bucketBoxRoundCounts[index]) << " +/- "
+            << SimulationResult::getConfidenceHalfWidth(this->bucketNetResults[index],
+                this->bucketNetResultSquares[index], this->bucketBoxRoundCounts[index]) << std::endl;
+    }
+
+    for (u8 sideBetIndex = 0; sideBetIndex < SimulationResult::maxSideBetCount; sideBetIndex++)
+    {
+        if (this->getSideBetCount(sideBetIndex) == 0)
+        {
+            continue;
+        }
+
+        stream << "Side bet " << (u16) sideBetIndex << " EV % | Bets | Realized %" << std::endl;
+
+        for (u8 index = 0; index < SimulationResult::sideBetEvBucketCount; index++)
+        {
+            if (this->sideBetCounts[sideBetIndex][index] == 0)
+            {
+                continue;
+            }
+
+            stream << (s16) (index + SimulationResult::minSideBetEv) << " | " << this->sideBetCounts[sideBetIndex][index] << " | "
+                << 100.0 * this->sideBetNetResults[sideBetIndex][index] / this->sideBetStakes[sideBetIndex][index] << std::endl;
+        }
+    }
+}
+
+void SimulationResult::writeCsvHeader(std::ostream& stream)
+{
+    stream << "rounds,box_rounds,hands,total_bet,net,net_squares,mean,variance";
+
+    for (s16 trueCount = SimulationResult::minTrueCount; trueCount <= SimulationResult::maxTrueCount; trueCount++)
+    {
+        stream << ",tc" << trueCount << "_box_rounds,tc" << trueCount << "_net";
+    }
+
+    for (u8 action = 0; action < SimulationResult::actionTypeCount; action++)
+    {
+        stream << ",action" << (u16) action;
+    }
+}
+
+void SimulationResult::writeCsvRow(std::ostream& stream) const
+{
+    f64 mean = SimulationResult::getMean(this->netResult, this->boxRoundCount);
+    f64 variance = this->boxRoundCount > 1 ?
+        ((f64) this->netResultSquares - mean * this->netResult) / (this->boxRoundCount - 1) : 0;
+
+    stream << this->roundCount << ',' << this->boxRoundCount << ',' << this->handCount << ',' << this->totalBet
+        << ',' << this->netResult << ',' << this->netResultSquares << ',' << mean << ',' << variance;
+
+    for (u8 index = 0; index < SimulationResult::trueCountBucketCount; index++)
+    {
+        stream << ',' << this->bucketBoxRoundCounts[index] << ',' << this->bucketNetResults[index];
+    }
+
+    for (u8 action = 0; action < SimulationResult::actionTypeCount; action++)
+    {
+        stream << ',' << this->actionCounts[action];
+    }
+}
+
+u64 SimulationResult::getSeed() const
+{
+    return this->seed;
+}
+
+u64 SimulationResult::getFirstShoe() const
+{
+    return this->firstShoe;
+}
+
+u64 SimulationResult::getShoeCount() const
+{
+    return this->shoeCount;
+}
+
+u64 SimulationResult::getRoundCount() const
+{
+    return this->roundCount;
+}
+
+u64 SimulationResult::getHandCount() const
+{
+    return this->handCount;
+}
+
+u64 SimulationResult::getTotalBet() const
+{
+    return this->totalBet;
+}
+
+s64 SimulationResult::getNetResult() const
+{
+    return this->netResult;
+}
+
+u64 SimulationResult::getBoxRoundCount() const
+{
+    return this->boxRoundCount;
+}
+
+f64 SimulationResult::getMeanNetResult() const
+{
+    return SimulationResult::getMean(this->netResult, this->boxRoundCount);
+}
+
+f64 SimulationResult::getMeanNetResultHalfWidth() const
+{
+    return SimulationResult::getConfidenceHalfWidth(this->netResult, this->netResultSquares, this->boxRoundCount);
+}
+
+u64 SimulationResult::getSideBetCount(u8 sideBetIndex) const
+{
+    u64 count = 0;
+
+    for (u8 index = 0; index < SimulationResult::sideBetEvBucketCount; index++)
+    {
+        count += this->sideBetCounts[sideBetIndex][index];
+    }
+
+    return count;
+}
+
+u64 SimulationResult::getSideBetStake(u8 sideBetIndex) const
+{
+    u64 stake = 0;
+
+    for (u8 index = 0; index < SimulationResult::sideBetEvBucketCount; index++)
+    {
+        stake += this->sideBetStakes[sideBetIndex][index];
+    }
+
+    return stake;
+}
+
+s64 SimulationResult::getSideBetNetResult(u8 sideBetIndex) const
+{
+    s64 sum = 0;
+
+    for (u8 index = 0; index < SimulationResult::sideBetEvBucketCount; index++)
+    {
+        sum += this->sideBetNetResults[sideBetIndex][index];
+    }
+
+    return sum;
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include <cstdio>
+#include <stdexcept>
+
+#include "SimulationStatsWriter.h"
+
+SimulationStatsWriter::SimulationStatsWriter(const std::string& csvPath, const std::string& progressPath, u64 roundInterval)
+    : progressPath{progressPath}, roundInterval{roundInterval ? roundInterval : 1}, nextRoundCount{this->roundInterval}
+{
+    if (!csvPath.empty())
+    {
+        this->csvFile.open(csvPath, std::ios::trunc);
+
+        if (!this->csvFile)
+        {
+            throw std::runtime_error("SimulationStatsWriter::SimulationStatsWriter(csvPath, progressPath, roundInterval) - can't open " + csvPath);
+        }
+
+        this->csvFile << "interval,elapsed_s,";
+        SimulationResult::writeCsvHeader(this->csvFile);
+        this->csvFile << ",cumulative_mean,cumulative_ci95" << std::endl;
+    }
+}
+
+void SimulationStatsWriter::start(u64 _shoeCount, const SimulationResult& resumedResult)
+{
+    this->shoeCount = _shoeCount;
+    this->previousResult = resumedResult;
+    this->nextRoundCount = resumedResult.getRoundCount() + this->roundInterval;
+    this->startTime = std::chrono::steady_clock::now();
+}
+
+bool SimulationStatsWriter::isDue(u64 roundCount) const
+{
+    return roundCount >= this->nextRoundCount;
+}
+
+void SimulationStatsWriter::write(const SimulationResult& result, u64 finishedShoeCount, bool isFinished)
+{
+    std::chrono::duration<f64> elapsed = std::chrono::steady_clock::now() - this->startTime;
+    SimulationResult interval = result;
+
+    interval.subtract(this->previousResult);
+
+    if (this->csvFile.is_open() && interval.getRoundCount() > 0)
+    {
+        this->csvFile << ++this->intervalNumber << ',' << elapsed.count() << ',';
+        interval.writeCsvRow(this->csvFile);
+        this->csvFile << ',' << result.getMeanNetResult() << ',' << result.getMeanNetResultHalfWidth() << std::endl;
+    }
+
+    this->previousResult = result;
+    this->nextRoundCount = result.getRoundCount() + this->roundInterval;
+
+    if (!this->progressPath.empty())
+    {
+        this->writeProgress(result, finishedShoeCount, isFinished);
+    }
+}
+
+void SimulationStatsWriter::writeProgress(const SimulationResult& result, u64 finishedShoeCount, bool isFinished)
+{
+    std::chrono::duration<f64> elapsed = std::chrono::steady_clock::now() - this->startTime;
+    std::string temporaryPath = this->progressPath + ".tmp";
+
+    {
+        std::ofstream file(temporaryPath, std::ios::trunc);
+
+        file << "state=" << (isFinished ? "finished" : "running") << std::endl;
+        file << "shoes_finished=" << finishedShoeCount << std::endl;
+        file << "shoes_total=" << this->shoeCount << std::endl;
+        file << "rounds=" << result.getRoundCount() << std::endl;
+        file << "hands=" << result.getHandCount() << std::endl;
+        file << "elapsed_s=" << elapsed.count() << std::endl;
+        file << "rounds_per_s=" << (elapsed.count() > 0 ? result.getRoundCount() / elapsed.count() : 0) << std::endl;
+        file << "net=" << result.getNetResult() << std::endl;
+        file << "total_bet=" << result.getTotalBet() << std::endl;
+        file << "mean=" << result.getMeanNetResult() << std::endl;
+        file << "ci95=" << result.getMeanNetResultHalfWidth() << std::endl;
+    }
+
+    // Readers see either the previous or the new file, never a partial one
+    std::rename(temporaryPath.c_str(), this->progressPath.c_str());
+}
\ No newline at end of file
@@ -0,0 +1,398 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "Simulator.h"
+
+constexpr char Simulator::checkpointMagic[8];
+
+Simulator::Simulator(u16 tableCount, u8 boxCount, u32 flatBet, u64 seed)
+    : seed{seed}
+{
+    for (u16 tableNumber = 1; tableNumber <= tableCount; tableNumber++)
+    {
+        auto* table = new SimulationBlackjack(boxCount, flatBet);
+
+        table->setRunSeed(this->seed);
+        table->prepareGame();
+
+        this->tables.push_back(table);
+    }
+
+    this->activeTables.reserve(tableCount);
+    this->batchOffsets.resize(tableCount + 1);
+    this->batch.reserve(tableCount * boxCount);
+    this->dealerBatch.reserve(tableCount);
+}
+
+Simulator::~Simulator()
+{
+    for (auto table : this->tables)
+    {
+        delete table;
+    }
+}
+
+void Simulator::run(u64 firstShoe, u64 shoeCount)
+{
+    this->firstShoe = firstShoe;
+    this->shoeCount = shoeCount;
+    this->nextShoeNumber = firstShoe;
+    this->endShoeNumber = firstShoe + shoeCount;
+    this->roundCount = 0;
+    this->finishedShoeCount = 0;
+
+    this->activeTables.clear();
+
+    for (auto table : this->tables)
+    {
+        if (this->nextShoeNumber < this->endShoeNumber)
+        {
+            table->setNextShoeNumber(this->nextShoeNumber++);
+            table->startShoe();
+
+            this->activeTables.push_back(table);
+        }
+    }
+
+    this->play();
+}
+
+void Simulator::resume(const std::string& checkpointPath)
+{
+    SnapshotReader reader;
+
+    reader.readFromFile(checkpointPath);
+
+    this->readCheckpoint(reader);
+    this->play();
+}
+
+void Simulator::play()
+{
+    SimulationResult resumedResult;
+
+    this->collectResult(resumedResult);
+
+    if (this->statsWriter != nullptr)
+    {
+        this->statsWriter->start(this->shoeCount, resumedResult);
+    }
+
+    this->lastCheckpointTime = std::chrono::steady_clock::now();
+
+    while (!this->activeTables.empty())
+    {
+        this->playRound();
+
+        this->roundCount += this->activeTables.size();
+
+        // A finished shoe is replaced by the next one of the range, or the table retires
+        for (u16 tableIndex = 0; tableIndex < this->activeTables.size(); )
+        {
+            auto table = this->activeTables[tableIndex];
+
+            if (!table->needsNewShoe())
+            {
+                tableIndex++;
+
+                continue;
+            }
+
+            this->finishedShoeCount++;
+
+            if (this->nextShoeNumber < this->endShoeNumber)
+            {
+                table->setNextShoeNumber(this->nextShoeNumber++);
+                table->startShoe();
+
+                tableIndex++;
+            }
+            else
+            {
+                this->activeTables.erase(this->activeTables.begin() + tableIndex);
+            }
+        }
+
+        if (this->statsWriter != nullptr && this->statsWriter->isDue(this->roundCount))
+        {
+            SimulationResult runningResult;
+
+            this->collectResult(runningResult);
+            this->statsWriter->write(runningResult, this->finishedShoeCount);
+        }
+
+        // Checked once per round: reading the clock costs far less than the round itself
+        if (!this->checkpointPath.empty() &&
+            std::chrono::steady_clock::now() - this->lastCheckpointTime >= this->checkpointInterval)
+        {
+            this->writeCheckpoint();
+        }
+    }
+
+    this->result = SimulationResult();
+    this->collectResult(this->result);
+    this->result.setShoeRange(this->seed, this->firstShoe, this->shoeCount);
+
+    if (this->statsWriter != nullptr)
+    {
+        this->statsWriter->write(this->result, this->finishedShoeCount, true);
+    }
+}
+
+void Simulator::writeCheckpoint()
+{
+    SnapshotWriter& writer = this->checkpointWriter;
+
+    writer.clear();
+    writer.writeBytes(Simulator::checkpointMagic, sizeof(Simulator::checkpointMagic));
+    writer.write(Simulator::checkpointVersion);
+    writer.write(this->rules.getHash());
+    writer.write(this->rules.penetration);
+    writer.write(this->getConfigHash());
+    writer.write(this->seed);
+    writer.write<u16>(this->tables.size());
+    writer.write(this->firstShoe);
+    writer.write(this->shoeCount);
+    writer.write(this->nextShoeNumber);
+    writer.write(this->endShoeNumber);
+    writer.write(this->roundCount);
+    writer.write(this->finishedShoeCount);
+
+    // Active tables keep the order of tables, a flag per table is enough to rebuild them
+    for (auto table : this->tables)
+    {
+        bool isActive = std::find(this->activeTables.begin(), this->activeTables.end(), table) != this->activeTables.end();
+
+        writer.write<u8>(isActive);
+        table->writeSnapshot(writer);
+    }
+
+    writer.writeToFile(this->checkpointPath);
+
+    this->lastCheckpointTime = std::chrono::steady_clock::now();
+}
+
+void Simulator::readCheckpoint(SnapshotReader& reader)
+{
+    char magic[sizeof(Simulator::checkpointMagic)];
+
+    reader.readBytes(magic, sizeof(magic));
+
+    if (!std::equal(magic, magic + sizeof(magic), Simulator::checkpointMagic) ||
+        reader.read<u32>() != Simulator::checkpointVersion)
+    {
+        throw std::runtime_error("Simulator::readCheckpoint(reader) - not a simulation checkpoint");
+    }
+
+    // Results of other rules or configurations would be merged into this run
+    u64 rulesHash = reader.read<u64>();
+    f32 penetration = reader.read<f32>();
+
+    if (rulesHash != this->rules.getHash() || penetration != this->rules.penetration)
+    {
+        throw std::invalid_argument("Simulator::readCheckpoint(reader) - checkpoint was taken under other rules or another variant");
+    }
+
+    if (reader.read<u64>() != this->getConfigHash())
+    {
+        throw std::invalid_argument("Simulator::readCheckpoint(reader) - checkpoint was taken with another strategy, shoe or side bets");
+    }
+
+    this->seed = reader.read<u64>();
+
+    if (reader.read<u16>() != this->tables.size())
+    {
+        throw std::invalid_argument("Simulator::readCheckpoint(reader) - checkpoint was taken with another table count");
+    }
+
+    this->firstShoe = reader.read<u64>();
+    this->shoeCount = reader.read<u64>();
+    this->nextShoeNumber = reader.read<u64>();
+    this->endShoeNumber = reader.read<u64>();
+    this->roundCount = reader.read<u64>();
+    this->finishedShoeCount = reader.read<u64>();
+
+    this->activeTables.clear();
+
+    for (auto table : this->tables)
+    {
+        if (reader.read<u8>())
+        {
+            this->activeTables.push_back(table);
+        }
+
+        table->readSnapshot(reader);
+    }
+}
+
+u64 Simulator::getConfigHash() const
+{
+    // FNV-1a over the strategy hash, the shoe mode and the side bet names
+    u64 strategyHash = this->strategy.getHash();
+    u64 hash = 0xCBF29CE484222325;
+
+    for (u8 shift = 0; shift < 64; shift += 8)
+    {
+        hash = (hash ^ (u8) (strategyHash >> shift)) * 0x100000001B3;
+    }
+
+    hash = (hash ^ (u8) this->shoeMode) * 0x100000001B3;
+
+    // Names are hashed with their terminating zero, so that they can't run into each other
+    for (auto& name : this->sideBetNames)
+    {
+        for (u16 index = 0; index <= name.size(); index++)
+        {
+            hash = (hash ^ (u8) name[index]) * 0x100000001B3;
+        }
+    }
+
+    return hash;
+}
+
+void Simulator::collectResult(SimulationResult& _result) const
+{
+    for (auto table : this->tables)
+    {
+        _result.merge(table->getResult());
+    }
+}
+
+void Simulator::playRound()
+{
+    u16 tableCount = this->activeTables.size();
+
+    for (auto table : this->activeTables)
+    {
+        table->beginRound();
+    }
+
+    while (true)
+    {
+        this->batch.clear();
+
+        for (u16 tableIndex = 0; tableIndex < tableCount; tableIndex++)
+        {
+            this->batchOffsets[tableIndex] = this->batch.size();
+            this->activeTables[tableIndex]->appendPendingHands(this->batch);
+        }
+
+        this->batchOffsets[tableCount] = this->batch.size();
+
+        if (this->batch.size() == 0)
+        {
+            break;
+        }
+
+        this->maskKernel(this->batch, this->rules);
+
+        this->strategy.decideBatch(this->batch);
+
+        for (u16 tableIndex = 0; tableIndex < tableCount; tableIndex++)
+        {
+            this->activeTables[tableIndex]->applyDecisions(this->batch,
+                this->batchOffsets[tableIndex], this->batchOffsets[tableIndex + 1]);
+        }
+    }
+
+    // The dealer hands of all tables are drawn out at once, finishRound() then finds them complete
+    this->dealerBatch.clear();
+
+    for (auto table : this->activeTables)
+    {
+        table->appendDealerHand(this->dealerBatch);
+    }
+
+    DealerBatch::drawOut(this->dealerBatch, this->rules.dealerHitsSoft17);
+
+    for (auto table : this->activeTables)
+    {
+        table->takeDealerCards(this->dealerBatch);
+        table->finishRound();
+    }
+}
+
+void Simulator::setHandHistoryWriter(HandHistoryWriter* writer)
+{
+    for (auto table : this->tables)
+    {
+        table->setHandHistoryWriter(writer);
+    }
+}
+
+void Simulator::setStrategy(const BasicStrategy& _strategy)
+{
+    this->strategy = _strategy;
+}
+
+void Simulator::setRules(const BlackjackRules& _rules)
+{
+    u64 hash = _rules.getHash();
+
+    this->rules = _rules;
+
+    // Penetration is left out of the hash, it doesn't enter the kernel
+    if (hash == AmericanRules::toRules().getHash())
+    {
+        this->maskKernel = &Simulator::evaluatePolicyMasks<AmericanRules>;
+    }
+    else if (hash == EuropeanRules::toRules().getHash())
+    {
+        this->maskKernel = &Simulator::evaluatePolicyMasks<EuropeanRules>;
+    }
+    else
+    {
+        this->maskKernel = &Simulator::evaluateRuntimeMasks;
+    }
+
+    for (auto table : this->tables)
+    {
+        table->setRules(_rules);
+    }
+}
+
+void Simulator::evaluateRuntimeMasks(DecisionBatch& batch, const BlackjackRules& _rules)
+{
+    AbstractBlackjack::evaluateActionMasks(batch, _rules);
+}
+
+void Simulator::addSideBet(AbstractSideBet* sideBet)
+{
+    this->sideBetNames.push_back(sideBet->getName());
+
+    for (auto table : this->tables)
+    {
+        table->addSideBet(sideBet);
+    }
+}
+
+void Simulator::setShoeMode(ShoeMode mode)
+{
+    this->shoeMode = mode;
+
+    for (auto table : this->tables)
+    {
+        table->setShoeMode(mode);
+    }
+}
+
+void Simulator::setStatsWriter(SimulationStatsWriter* writer)
+{
+    this->statsWriter = writer;
+}
+
+void Simulator::setCheckpoint(const std::string& path, std::chrono::milliseconds interval)
+{
+    this->checkpointPath = path;
+    this->checkpointInterval = interval;
+}
+
+const SimulationResult& Simulator::getResult() const
+{
+    return this->result;
+}
+
+u64 Simulator::getSeed() const
+{
+    return this->seed;
+}
\ No newline at end of file
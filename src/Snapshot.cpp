@@ -0,0 +1,44 @@
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include "Snapshot.h"
+
+void SnapshotWriter::writeToFile(const std::string& path) const
+{
+    std::string temporaryPath = path + ".tmp";
+
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+        if (!file)
+        {
+            throw std::runtime_error("SnapshotWriter::writeToFile(path) - can't open " + temporaryPath);
+        }
+
+        file.write(reinterpret_cast<const char*>(this->data.data()), this->data.size());
+
+        if (!file.flush())
+        {
+            throw std::runtime_error("SnapshotWriter::writeToFile(path) - can't write " + temporaryPath);
+        }
+    }
+
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        throw std::runtime_error("SnapshotWriter::writeToFile(path) - can't replace " + path);
+    }
+}
+
+void SnapshotReader::readFromFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file)
+    {
+        throw std::runtime_error("SnapshotReader::readFromFile(path) - can't open " + path);
+    }
+
+    this->data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    this->offset = 0;
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "SplitBlackjackAction.h"
+#include "MetricsRegistry.h"
 
 std::string SplitBlackjackAction::getName()
 {
@@ -20,8 +21,10 @@ bool SplitBlackjackAction::execute(Box* currentBox)
         currentBox->giveCard(handCards[1]);
         currentBox->giveCard(this->blackjack->getNextCard());
         currentBox->switchHand(prevHandNumber);
-        currentBox->getHandCards().pop_back();
+        currentBox->removeLastCard();
         currentBox->giveCard(this->blackjack->getNextCard());
+
+        MetricsRegistry::getInstance().increment(MetricCounter::metricSplits);
     }
 
     return true;
@@ -30,8 +33,22 @@ bool SplitBlackjackAction::execute(Box* currentBox)
 bool SplitBlackjackAction::isAvailable(Box* currentBox)
 {
     auto& handCards = currentBox->getHandCards();
+    auto& rules = this->blackjack->getRules();
+
+    if (handCards.size() != 2)
+    {
+        return false;
+    }
 
-    return handCards.size() == 2 && handCards[0]->getCardLetter() == handCards[1]->getCardLetter() &&
+    bool isSplitAces = currentBox->getHandCount() > 1 && handCards[0]->getCardFace() == CardFace::ace;
+
+    return handCards[0]->getCardLetter() == handCards[1]->getCardLetter() &&
+        currentBox->getHandCount() < rules.maxSplitHands && (rules.resplitAces || !isSplitAces) &&
         currentBox->getPlayer().getCash() >= currentBox->getBet();
 }
 
+
+u8 SplitBlackjackAction::getActionType()
+{
+    return BlackjackActionType::splitAction;
+}
\ No newline at end of file
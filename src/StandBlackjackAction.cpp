@@ -15,3 +15,7 @@ bool StandBlackjackAction::isAvailable(Box*)
     return true;
 }
 
+u8 StandBlackjackAction::getActionType()
+{
+    return BlackjackActionType::standAction;
+}
\ No newline at end of file
@@ -0,0 +1,342 @@
+#include <algorithm>
+#include <cstring>
+
+#include "StrategyTable.h"
+#include "DecisionBatch.h"
+
+constexpr char StrategyTableBuilder::fileMagic[8];
+
+StrategyTableBuilder::StrategyTableBuilder(const BlackjackRules& rules)
+    : rules{rules}
+{}
+
+f64 StrategyTableBuilder::getCardChance(u8 cardValue)
+{
+    return cardValue == 10 ? 4.0 / 13 : 1.0 / 13;
+}
+
+void StrategyTableBuilder::addCard(u8& total, bool& soft, u8 cardValue)
+{
+    // An ace counts 11 while it doesn't bust the hand
+    if (cardValue == 11 && total + 11 > 21)
+    {
+        cardValue = 1;
+    }
+    else if (cardValue == 11)
+    {
+        soft = true;
+    }
+
+    total += cardValue;
+
+    if (total > 21 && soft)
+    {
+        total -= 10;
+        soft = false;
+    }
+}
+
+const f64* StrategyTableBuilder::getDealerOutcomes(u8 total, bool soft)
+{
+    f64* outcomes = this->dealerOutcomeMemo[total][soft];
+
+    if (this->dealerOutcomeKnown[total][soft])
+    {
+        return outcomes;
+    }
+
+    this->dealerOutcomeKnown[total][soft] = true;
+
+    if (total > 21)
+    {
+        outcomes[StrategyTableBuilder::dealerBust] = 1;
+    }
+    else if (total >= 17 && !(total == 17 && soft && this->rules.dealerHitsSoft17))
+    {
+        outcomes[total - 17] = 1;
+    }
+    else
+    {
+        for (u8 cardValue = 2; cardValue <= 11; cardValue++)
+        {
+            u8 nextTotal = total;
+            bool nextSoft = soft;
+
+            StrategyTableBuilder::addCard(nextTotal, nextSoft, cardValue);
+
+            const f64* nextOutcomes = this->getDealerOutcomes(nextTotal, nextSoft);
+
+            for (u8 outcome = 0; outcome < StrategyTableBuilder::dealerOutcomeCount; outcome++)
+            {
+                outcomes[outcome] += StrategyTableBuilder::getCardChance(cardValue) * nextOutcomes[outcome];
+            }
+        }
+    }
+
+    return outcomes;
+}
+
+void StrategyTableBuilder::computeDealerOutcomes(u8 upcard)
+{
+    f64* outcomes = this->dealerOutcomes[upcard];
+
+    for (u8 holeCard = 2; holeCard <= 11; holeCard++)
+    {
+        f64 chance = StrategyTableBuilder::getCardChance(holeCard);
+
+        if (upcard + holeCard == 21)
+        {
+            this->dealerBlackjackChance[upcard] += chance;
+
+            continue;
+        }
+
+        u8 total = upcard == 11 ? 11 : upcard;
+        bool soft = upcard == 11;
+
+        StrategyTableBuilder::addCard(total, soft, holeCard);
+
+        const f64* holeOutcomes = this->getDealerOutcomes(total, soft);
+
+        for (u8 outcome = 0; outcome < StrategyTableBuilder::dealerOutcomeCount; outcome++)
+        {
+            outcomes[outcome] += chance * holeOutcomes[outcome];
+        }
+    }
+
+    for (u8 outcome = 0; outcome < StrategyTableBuilder::dealerOutcomeCount; outcome++)
+    {
+        outcomes[outcome] /= 1 - this->dealerBlackjackChance[upcard];
+    }
+}
+
+void StrategyTableBuilder::computePlayerEv(u8 upcard)
+{
+    const f64* outcomes = this->dealerOutcomes[upcard];
+
+    for (u8 total = 2; total <= 21; total++)
+    {
+        f64 ev = outcomes[StrategyTableBuilder::dealerBust];
+
+        for (u8 dealerTotal = 17; dealerTotal <= 21; dealerTotal++)
+        {
+            if (dealerTotal < total)
+            {
+                ev += outcomes[dealerTotal - 17];
+            }
+            else if (dealerTotal > total)
+            {
+                ev -= outcomes[dealerTotal - 17];
+            }
+        }
+
+        this->standEv[false][total] = ev;
+        this->standEv[true][total] = ev;
+    }
+
+    // A hand only moves to higher totals, except that a soft hand may turn into a lower hard one:
+    // hard 21..11 depend on higher hard totals, soft totals on higher soft and any hard from 12,
+    // and hard 10..2 on higher hard and soft totals.
+    for (u8 total = 21; total >= 11; total--)
+    {
+        this->hitEv[false][total] = this->getHitEv(total, false);
+    }
+
+    for (u8 total = 21; total >= 12; total--)
+    {
+        this->hitEv[true][total] = this->getHitEv(total, true);
+    }
+
+    for (u8 total = 10; total >= 2; total--)
+    {
+        this->hitEv[false][total] = this->getHitEv(total, false);
+    }
+
+    for (u8 soft = 0; soft <= 1; soft++)
+    {
+        for (u8 total = 2; total <= 21; total++)
+        {
+            f64 ev = 0;
+
+            for (u8 cardValue = 2; cardValue <= 11; cardValue++)
+            {
+                u8 nextTotal = total;
+                bool nextSoft = soft;
+
+                StrategyTableBuilder::addCard(nextTotal, nextSoft, cardValue);
+
+                ev += StrategyTableBuilder::getCardChance(cardValue) * (nextTotal > 21 ? -1 : this->standEv[nextSoft][nextTotal]);
+            }
+
+            this->doubleEv[soft][total] = 2 * ev;
+        }
+    }
+}
+
+f64 StrategyTableBuilder::getHitEv(u8 total, bool soft) const
+{
+    f64 ev = 0;
+
+    for (u8 cardValue = 2; cardValue <= 11; cardValue++)
+    {
+        u8 nextTotal = total;
+        bool nextSoft = soft;
+
+        StrategyTableBuilder::addCard(nextTotal, nextSoft, cardValue);
+
+        ev += StrategyTableBuilder::getCardChance(cardValue) * (nextTotal > 21 ? -1 : this->getBestEv(nextTotal, nextSoft, false));
+    }
+
+    return ev;
+}
+
+f64 StrategyTableBuilder::getBestEv(u8 total, bool soft, bool canDouble) const
+{
+    f64 ev = std::max(this->standEv[soft][total], total < 21 ? this->hitEv[soft][total] : -1);
+
+    return canDouble ? std::max(ev, this->doubleEv[soft][total]) : ev;
+}
+
+f64 StrategyTableBuilder::getSplitEv(u8 cardValue) const
+{
+    f64 ev = 0;
+
+    for (u8 secondCardValue = 2; secondCardValue <= 11; secondCardValue++)
+    {
+        u8 total = cardValue == 11 ? 11 : cardValue;
+        bool soft = cardValue == 11;
+
+        StrategyTableBuilder::addCard(total, soft, secondCardValue);
+
+        ev += StrategyTableBuilder::getCardChance(secondCardValue) *
+            this->getBestEv(total, soft, this->rules.doubleAfterSplit && this->rules.isDoubleAllowed(total));
+    }
+
+    return 2 * ev;
+}
+
+f64 StrategyTableBuilder::getFinalEv(f64 ev, u8 stake, u8 upcard) const
+{
+    f64 blackjackChance = this->dealerBlackjackChance[upcard];
+
+    // A peeking dealer takes only the initial bet, before any action
+    return (1 - blackjackChance) * ev - blackjackChance * (this->rules.dealerPeeks ? 1 : stake);
+}
+
+f64 StrategyTableBuilder::getSurrenderEv(u8 upcard) const
+{
+    switch (this->rules.surrender)
+    {
+        case SurrenderRule::surrenderEarly:
+            return -0.5;
+
+        case SurrenderRule::surrenderLate:
+            return this->getFinalEv(-0.5, 1, upcard);
+
+        default:
+            return -1;
+    }
+}
+
+f64 StrategyTableBuilder::getBestFinalEv(u8 total, bool soft, u8 upcard) const
+{
+    f64 stand = this->getFinalEv(this->standEv[soft][total], 1, upcard);
+    f64 hit = this->getFinalEv(total < 21 ? this->hitEv[soft][total] : -1, 1, upcard);
+    f64 doubleDown = this->rules.isDoubleAllowed(total) ? this->getFinalEv(this->doubleEv[soft][total], 2, upcard) : -2;
+
+    return std::max({stand, hit, doubleDown, this->getSurrenderEv(upcard)});
+}
+
+void StrategyTableBuilder::build(StrategyTableData& data)
+{
+    data = StrategyTableData{};
+    std::memcpy(data.magic, StrategyTableBuilder::fileMagic, sizeof(data.magic));
+
+    data.version = StrategyTableBuilder::fileVersion;
+    data.size = sizeof(data);
+    data.rulesHash = this->rules.getHash();
+    data.rules = this->rules;
+
+    f64 blackjackPayout = (f64) this->rules.blackjackPayoutNumerator / this->rules.blackjackPayoutDenominator;
+    u8 surrenderAction = this->rules.surrender == SurrenderRule::surrenderEarly ? earlySurrenderAction : lateSurrenderAction;
+    f64 gameEv = 0;
+
+    for (u8 upcard = 2; upcard <= 11; upcard++)
+    {
+        this->computeDealerOutcomes(upcard);
+        this->computePlayerEv(upcard);
+
+        f64 surrender = this->getSurrenderEv(upcard);
+
+        data.surrenderEv[upcard] = surrender;
+
+        for (u8 soft = 0; soft <= 1; soft++)
+        {
+            for (u8 total = soft ? 12 : 4; total <= 21; total++)
+            {
+                f64 stand = this->getFinalEv(this->standEv[soft][total], 1, upcard);
+                f64 hit = this->getFinalEv(total < 21 ? this->hitEv[soft][total] : -1, 1, upcard);
+                f64 doubleDown = this->getFinalEv(this->doubleEv[soft][total], 2, upcard);
+                u8 fallback = hit > stand ? hitAction : standAction;
+                bool isDoubleAllowed = this->rules.isDoubleAllowed(total);
+                u8 preferred = isDoubleAllowed && doubleDown > std::max(hit, stand) ? (u8) doubleAction : fallback;
+
+                // Surrender is only offered on the first two cards, later the fallback is played
+                if (surrender > std::max({hit, stand, isDoubleAllowed ? doubleDown : -2}))
+                {
+                    preferred = surrenderAction;
+                }
+
+                data.standEv[soft][total][upcard] = stand;
+                data.hitEv[soft][total][upcard] = hit;
+                data.doubleEv[soft][total][upcard] = doubleDown;
+                data.handTable[soft][total][upcard] = preferred | fallback << 4;
+            }
+        }
+
+        for (u8 cardValue = 2; cardValue <= 11; cardValue++)
+        {
+            u8 total = cardValue == 11 ? 12 : 2 * cardValue;
+            bool soft = cardValue == 11;
+            f64 split = this->getFinalEv(this->getSplitEv(cardValue), 2, upcard);
+
+            data.splitEv[cardValue][upcard] = split;
+            data.pairTable[cardValue][upcard] = split > this->getBestFinalEv(total, soft, upcard);
+        }
+
+        // Two-card starting hands with the best play, a player blackjack only ties a dealer one
+        f64 upcardEv = 0;
+
+        for (u8 firstCard = 2; firstCard <= 11; firstCard++)
+        {
+            for (u8 secondCard = 2; secondCard <= 11; secondCard++)
+            {
+                f64 chance = StrategyTableBuilder::getCardChance(firstCard) * StrategyTableBuilder::getCardChance(secondCard);
+                u8 total = firstCard == 11 ? 11 : firstCard;
+                bool soft = firstCard == 11;
+
+                StrategyTableBuilder::addCard(total, soft, secondCard);
+
+                if (total == 21)
+                {
+                    upcardEv += chance * (1 - this->dealerBlackjackChance[upcard]) * blackjackPayout;
+
+                    continue;
+                }
+
+                f64 ev = this->getBestFinalEv(total, soft, upcard);
+
+                if (firstCard == secondCard && data.pairTable[firstCard][upcard])
+                {
+                    ev = data.splitEv[firstCard][upcard];
+                }
+
+                upcardEv += chance * ev;
+            }
+        }
+
+        gameEv += StrategyTableBuilder::getCardChance(upcard) * upcardEv;
+    }
+
+    data.gameEv = gameEv;
+}
\ No newline at end of file
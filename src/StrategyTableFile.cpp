@@ -0,0 +1,133 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "StrategyTableFile.h"
+
+StrategyTableFile::StrategyTableFile(const std::string& path, const BlackjackRules& rules)
+{
+#ifndef _WIN32
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    struct stat fileStat;
+
+    if (descriptor < 0)
+    {
+        throw std::runtime_error("StrategyTableFile::StrategyTableFile(path, rules) - can't open " + path);
+    }
+
+    if (fstat(descriptor, &fileStat) == 0 && (u64) fileStat.st_size == sizeof(StrategyTableData))
+    {
+        void* mapping = mmap(nullptr, sizeof(StrategyTableData), PROT_READ, MAP_SHARED, descriptor, 0);
+
+        if (mapping != MAP_FAILED)
+        {
+            this->data = static_cast<const StrategyTableData*>(mapping);
+            this->isMapped = true;
+        }
+    }
+
+    close(descriptor);
+#endif
+
+    if (!this->isMapped)
+    {
+        std::ifstream file(path, std::ios::binary);
+
+        this->fallbackData.reset(new StrategyTableData());
+
+        if (!file.read(reinterpret_cast<char*>(this->fallbackData.get()), sizeof(StrategyTableData)))
+        {
+            throw std::runtime_error("StrategyTableFile::StrategyTableFile(path, rules) - can't read " + path);
+        }
+
+        this->data = this->fallbackData.get();
+    }
+
+    if (std::memcmp(this->data->magic, StrategyTableBuilder::fileMagic, sizeof(this->data->magic)) != 0 ||
+        this->data->version != StrategyTableBuilder::fileVersion || this->data->size != sizeof(StrategyTableData) ||
+        this->data->rulesHash != rules.getHash())
+    {
+        this->unmap();
+
+        throw std::runtime_error("StrategyTableFile::StrategyTableFile(path, rules) - " + path +
+            " is not a strategy table of these rules");
+    }
+}
+
+StrategyTableFile::~StrategyTableFile()
+{
+    this->unmap();
+}
+
+void StrategyTableFile::unmap()
+{
+#ifndef _WIN32
+    if (this->isMapped)
+    {
+        munmap(const_cast<StrategyTableData*>(this->data), sizeof(StrategyTableData));
+
+        this->isMapped = false;
+    }
+#endif
+}
+
+std::string StrategyTableFile::getPath(const std::string& directory, const BlackjackRules& rules)
+{
+    std::ostringstream path;
+
+    path << directory << "/strategy-" << std::hex << rules.getHash() << "-v" << StrategyTableBuilder::fileVersion << ".bjst";
+
+    return path.str();
+}
+
+void StrategyTableFile::write(const std::string& path, const StrategyTableData& data)
+{
+    // Written aside and renamed, so that concurrent processes never map a half-written table
+    std::string temporaryPath = path + ".tmp" + std::to_string(std::random_device{}());
+
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+        if (!file.write(reinterpret_cast<const char*>(&data), sizeof(data)))
+        {
+            throw std::runtime_error("StrategyTableFile::write(path, data) - can't write " + temporaryPath);
+        }
+    }
+
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporaryPath.c_str());
+
+        throw std::runtime_error("StrategyTableFile::write(path, data) - can't rename to " + path);
+    }
+}
+
+std::unique_ptr<StrategyTableFile> StrategyTableFile::open(const std::string& directory, const BlackjackRules& rules)
+{
+    std::string path = StrategyTableFile::getPath(directory, rules);
+
+    if (!std::ifstream(path).good())
+    {
+        std::unique_ptr<StrategyTableData> data(new StrategyTableData());
+
+        StrategyTableBuilder(rules).build(*data);
+        StrategyTableFile::write(path, *data);
+    }
+
+    return std::unique_ptr<StrategyTableFile>(new StrategyTableFile(path, rules));
+}
+
+const StrategyTableData& StrategyTableFile::getData() const
+{
+    return *this->data;
+}
\ No newline at end of file
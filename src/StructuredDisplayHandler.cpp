@@ -0,0 +1,390 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "StructuredDisplayHandler.h"
+#include "DisplayMessageParamDealerCards.h"
+#include "DisplayMessageParamPlayerCards.h"
+#include "DisplayMessageParamOptions.h"
+
+StructuredDisplayHandler::StructuredDisplayHandler(std::ostream& stream, StructuredFormat format)
+    : stream{stream}, format{format}
+{}
+
+void StructuredDisplayHandler::display(ADisplayEntity*, std::vector<ADisplayMessageParam*> params) const
+{
+    this->writeEvent({params});
+}
+
+void StructuredDisplayHandler::displayBatch(std::vector<ADisplayEntity*>, std::vector<std::vector<ADisplayMessageParam*>> params) const
+{
+    this->writeEvent(params);
+}
+
+std::string StructuredDisplayHandler::renderBatch(std::vector<ADisplayEntity*>, std::vector<std::vector<ADisplayMessageParam*>> params) const
+{
+    std::string text;
+
+    for (auto& messageParams : params)
+    {
+        if (this->format == StructuredFormat::structuredJson)
+        {
+            this->appendJsonMessage(text, messageParams);
+        }
+        else
+        {
+            this->appendBinaryMessage(text, messageParams);
+        }
+    }
+
+    return text;
+}
+
+void StructuredDisplayHandler::writeEvent(const std::vector<std::vector<ADisplayMessageParam*>>& messageParamList) const
+{
+    this->buffer.clear();
+    this->eventNumber++;
+
+    if (this->format == StructuredFormat::structuredJson)
+    {
+        this->buffer += "{\"event\":" + std::to_string(this->eventNumber) + ",\"messages\":[";
+
+        for (auto& params : messageParamList)
+        {
+            if (&params != &messageParamList.front())
+            {
+                this->buffer += ',';
+            }
+
+            this->appendJsonMessage(this->buffer, params);
+        }
+
+        this->buffer += "]}\n";
+    }
+    else
+    {
+        // The size is filled in once the frame is complete
+        StructuredDisplayHandler::appendBinaryValue<u32>(this->buffer, 0);
+        StructuredDisplayHandler::appendBinaryValue<u64>(this->buffer, this->eventNumber);
+        StructuredDisplayHandler::appendBinaryValue<u16>(this->buffer, messageParamList.size());
+
+        for (auto& params : messageParamList)
+        {
+            this->appendBinaryMessage(this->buffer, params);
+        }
+
+        u32 frameSize = this->buffer.size() - sizeof(u32);
+
+        std::memcpy(&this->buffer[0], &frameSize, sizeof(frameSize));
+    }
+
+    this->stream.write(this->buffer.data(), this->buffer.size());
+}
+
+void StructuredDisplayHandler::appendJsonMessage(std::string& text, const std::vector<ADisplayMessageParam*>& params) const
+{
+    std::string messageId;
+    bool isFirstField = true;
+
+    for (auto param : params)
+    {
+        if (param->getKey() == "id")
+        {
+            messageId = param->getValue();
+        }
+    }
+
+    text += "{\"id\":";
+    StructuredDisplayHandler::appendJsonString(text, messageId);
+    text += ",\"fields\":{";
+
+    for (auto param : params)
+    {
+        std::string key = param->getKey();
+
+        if (key == "id")
+        {
+            continue;
+        }
+
+        if (!isFirstField)
+        {
+            text += ',';
+        }
+
+        isFirstField = false;
+
+        StructuredDisplayHandler::appendJsonString(text, key);
+        text += ':';
+
+        if (auto* dealerCards = dynamic_cast<DisplayMessageParamDealerCards*>(param))
+        {
+            StructuredDisplayHandler::appendJsonCards(text, dealerCards->getCards());
+        }
+        else if (auto* playerCards = dynamic_cast<DisplayMessageParamPlayerCards*>(param))
+        {
+            text += "{\"currentHand\":" + std::to_string(playerCards->getCurrentHand()) + ",\"hands\":[";
+
+            for (auto& cards : playerCards->getCards())
+            {
+                if (&cards != &playerCards->getCards().front())
+                {
+                    text += ',';
+                }
+
+                StructuredDisplayHandler::appendJsonCards(text, cards);
+            }
+
+            text += "]}";
+        }
+        else if (auto* options = dynamic_cast<DisplayMessageParamOptions*>(param))
+        {
+            text += '[';
+
+            for (auto& option : options->getOptions())
+            {
+                if (&option != &options->getOptions().front())
+                {
+                    text += ',';
+                }
+
+                StructuredDisplayHandler::appendJsonString(text, option);
+            }
+
+            text += ']';
+        }
+        else
+        {
+            std::string value = param->getValue();
+
+            if (StructuredDisplayHandler::isInteger(value))
+            {
+                text += value;
+            }
+            else
+            {
+                StructuredDisplayHandler::appendJsonString(text, value);
+            }
+        }
+    }
+
+    text += "}}";
+}
+
+void StructuredDisplayHandler::appendBinaryMessage(std::string& text, const std::vector<ADisplayMessageParam*>& params) const
+{
+    std::string messageId;
+    u8 fieldCount = 0;
+
+    for (auto param : params)
+    {
+        if (param->getKey() == "id")
+        {
+            messageId = param->getValue();
+        }
+        else
+        {
+            fieldCount++;
+        }
+    }
+
+    StructuredDisplayHandler::appendBinaryString(text, messageId);
+    StructuredDisplayHandler::appendBinaryValue<u8>(text, fieldCount);
+
+    for (auto param : params)
+    {
+        std::string key = param->getKey();
+
+        if (key == "id")
+        {
+            continue;
+        }
+
+        StructuredDisplayHandler::appendBinaryString(text, key);
+
+        if (auto* dealerCards = dynamic_cast<DisplayMessageParamDealerCards*>(param))
+        {
+            StructuredDisplayHandler::appendBinaryValue<u8>(text, StructuredFieldType::fieldCards);
+            StructuredDisplayHandler::appendBinaryCards(text, dealerCards->getCards());
+        }
+        else if (auto* playerCards = dynamic_cast<DisplayMessageParamPlayerCards*>(param))
+        {
+            StructuredDisplayHandler::appendBinaryValue<u8>(text, StructuredFieldType::fieldHands);
+            StructuredDisplayHandler::appendBinaryValue<u8>(text, playerCards->getCurrentHand());
+            StructuredDisplayHandler::appendBinaryValue<u8>(text, playerCards->getCards().size());
+
+            for (auto& cards : playerCards->getCards())
+            {
+                StructuredDisplayHandler::appendBinaryCards(text, cards);
+            }
+        }
+        else if (auto* options = dynamic_cast<DisplayMessageParamOptions*>(param))
+        {
+            StructuredDisplayHandler::appendBinaryValue<u8>(text, StructuredFieldType::fieldOptions);
+            StructuredDisplayHandler::appendBinaryValue<u8>(text, options->getOptions().size());
+
+            for (auto& option : options->getOptions())
+            {
+                StructuredDisplayHandler::appendBinaryString(text, option);
+            }
+        }
+        else
+        {
+            std::string value = param->getValue();
+
+            if (StructuredDisplayHandler::isInteger(value))
+            {
+                StructuredDisplayHandler::appendBinaryValue<u8>(text, StructuredFieldType::fieldInteger);
+                StructuredDisplayHandler::appendBinaryValue<s64>(text, std::stoll(value));
+            }
+            else
+            {
+                StructuredDisplayHandler::appendBinaryValue<u8>(text, StructuredFieldType::fieldString);
+                StructuredDisplayHandler::appendBinaryString(text, value);
+            }
+        }
+    }
+}
+
+void StructuredDisplayHandler::appendJsonString(std::string& text, const std::string& value)
+{
+    text += '"';
+
+    for (char character : value)
+    {
+        switch (character)
+        {
+            case '"':
+                text += "\\\"";
+                break;
+
+            case '\\':
+                text += "\\\\";
+                break;
+
+            case '\n':
+                text += "\\n";
+                break;
+
+            default:
+                if ((u8) character < 0x20)
+                {
+                    char escaped[8];
+
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", (u8) character);
+                    text += escaped;
+                }
+                else
+                {
+                    // UTF-8 passes through untouched
+                    text += character;
+                }
+        }
+    }
+
+    text += '"';
+}
+
+void StructuredDisplayHandler::appendJsonCards(std::string& text, const std::vector<Card*>& cards)
+{
+    text += '[';
+
+    for (u8 index = 0; index < cards.size(); index++)
+    {
+        Card* card = cards[index];
+
+        if (index > 0)
+        {
+            text += ',';
+        }
+
+        if (card->getCardSuit() == CardSuit::hidden)
+        {
+            text += "null";
+
+            continue;
+        }
+
+        text += "{\"rank\":" + std::to_string(card->getCardNumber()) + ",\"suit\":\"" +
+            StructuredDisplayHandler::getSuitName(card->getCardSuit()) + "\"}";
+    }
+
+    text += ']';
+}
+
+void StructuredDisplayHandler::appendBinaryString(std::string& text, const std::string& value)
+{
+    u16 length = std::min<u64>(value.size(), UINT16_MAX);
+
+    StructuredDisplayHandler::appendBinaryValue<u16>(text, length);
+    text.append(value, 0, length);
+}
+
+void StructuredDisplayHandler::appendBinaryCards(std::string& text, const std::vector<Card*>& cards)
+{
+    StructuredDisplayHandler::appendBinaryValue<u8>(text, cards.size());
+
+    for (auto card : cards)
+    {
+        bool isHidden = card->getCardSuit() == CardSuit::hidden;
+
+        StructuredDisplayHandler::appendBinaryValue<u8>(text, isHidden ? 0 : card->getCardNumber());
+        StructuredDisplayHandler::appendBinaryValue<u8>(text, card->getCardSuit());
+    }
+}
+
+bool StructuredDisplayHandler::isInteger(const std::string& value)
+{
+    if (value.empty() || value.size() > 18 || (value[0] == '0' && value.size() > 1))
+    {
+        return false;
+    }
+
+    for (char character : value)
+    {
+        if (character < '0' || character > '9')
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void StructuredDisplayHandler::flush() const
+{
+    this->stream.flush();
+}
+
+u64 StructuredDisplayHandler::getEventCount() const
+{
+    return this->eventNumber;
+}
+
+const char* StructuredDisplayHandler::getSuitName(CardSuit suit)
+{
+    switch (suit)
+    {
+        case CardSuit::club:
+            return "club";
+
+        case CardSuit::diamond:
+            return "diamond";
+
+        case CardSuit::heart:
+            return "heart";
+
+        case CardSuit::spade:
+            return "spade";
+
+        default:
+            return "hidden";
+    }
+}
+
+void StructuredDisplayHandler::transformCardListEntity(ADisplayMessageParam*, std::vector<Card*>&)
+{}
+
+void StructuredDisplayHandler::transformCardListEntities(ADisplayMessageParam*, std::vector<std::vector<Card*>>&, u8)
+{}
\ No newline at end of file
@@ -30,3 +30,7 @@ bool SwitchHandBlackjackAction::isAvailable(Box* currentBox)
     return currentBox->getPlayableHandNumbers().size() > 1;
 }
 
+u8 SwitchHandBlackjackAction::getActionType()
+{
+    return BlackjackActionType::switchHandAction;
+}
\ No newline at end of file
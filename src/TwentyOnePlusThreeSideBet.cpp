@@ -0,0 +1,99 @@
+#include <algorithm>
+
+#include "TwentyOnePlusThreeSideBet.h"
+
+void TwentyOnePlusThreeSideBet::getStraightNumbers(u8 straightIndex, u8 cardNumbers[3])
+{
+    // Straight 0 is A-2-3, straight k runs from card number k + 1
+    cardNumbers[0] = straightIndex == 0 ? (u8) CardFace::ace : straightIndex + 1;
+    cardNumbers[1] = straightIndex + 2;
+    cardNumbers[2] = straightIndex + 3;
+}
+
+std::string TwentyOnePlusThreeSideBet::getName() const
+{
+    return "21+3";
+}
+
+u16 TwentyOnePlusThreeSideBet::getPayout(const Card& playerCard1, const Card& playerCard2, const Card& dealerUpcard, const Card&) const
+{
+    u8 cardNumbers[3] = {playerCard1.getCardNumber(), playerCard2.getCardNumber(), dealerUpcard.getCardNumber()};
+    bool isFlush = playerCard1.getCardSuit() == playerCard2.getCardSuit() && playerCard2.getCardSuit() == dealerUpcard.getCardSuit();
+
+    std::sort(cardNumbers, cardNumbers + 3);
+
+    if (cardNumbers[0] == cardNumbers[2])
+    {
+        return isFlush ? TwentyOnePlusThreeSideBet::suitedTripsPayout : TwentyOnePlusThreeSideBet::threeOfAKindPayout;
+    }
+
+    bool isStraight = (cardNumbers[0] + 1 == cardNumbers[1] && cardNumbers[1] + 1 == cardNumbers[2]) ||
+        (cardNumbers[0] == 2 && cardNumbers[1] == 3 && cardNumbers[2] == CardFace::ace);
+
+    if (isStraight)
+    {
+        return isFlush ? TwentyOnePlusThreeSideBet::straightFlushPayout : TwentyOnePlusThreeSideBet::straightPayout;
+    }
+
+    return isFlush ? TwentyOnePlusThreeSideBet::flushPayout : 0;
+}
+
+f64 TwentyOnePlusThreeSideBet::getExpectedValue(const ShoeComposition& composition) const
+{
+    // Unordered three-card draws of each kind, the kinds are made disjoint by taking the better hand out
+    f64 suitedTripsCount = 0;
+    f64 tripsCount = 0;
+    f64 straightCount = 0;
+    f64 straightFlushCount = 0;
+    f64 flushCount = 0;
+
+    for (u8 cardNumber = 2; cardNumber <= 14; cardNumber++)
+    {
+        f64 rankCount = composition.getRankCount(cardNumber);
+
+        tripsCount += rankCount * (rankCount - 1) * (rankCount - 2) / 6;
+
+        for (u8 suit = 1; suit <= 4; suit++)
+        {
+            f64 count = composition.getCount(cardNumber, suit);
+
+            suitedTripsCount += count * (count - 1) * (count - 2) / 6;
+        }
+    }
+
+    for (u8 straightIndex = 0; straightIndex < TwentyOnePlusThreeSideBet::straightCount; straightIndex++)
+    {
+        u8 cardNumbers[3];
+
+        TwentyOnePlusThreeSideBet::getStraightNumbers(straightIndex, cardNumbers);
+
+        straightCount += (f64) composition.getRankCount(cardNumbers[0]) * composition.getRankCount(cardNumbers[1]) *
+            composition.getRankCount(cardNumbers[2]);
+
+        for (u8 suit = 1; suit <= 4; suit++)
+        {
+            straightFlushCount += (f64) composition.getCount(cardNumbers[0], suit) * composition.getCount(cardNumbers[1], suit) *
+                composition.getCount(cardNumbers[2], suit);
+        }
+    }
+
+    for (u8 suit = 1; suit <= 4; suit++)
+    {
+        f64 suitCount = composition.getSuitCount(suit);
+
+        flushCount += suitCount * (suitCount - 1) * (suitCount - 2) / 6;
+    }
+
+    f64 totalCount = composition.getTotalCount();
+    f64 drawCount = totalCount * (totalCount - 1) * (totalCount - 2) / 6;
+
+    tripsCount -= suitedTripsCount;
+    straightCount -= straightFlushCount;
+    flushCount -= straightFlushCount + suitedTripsCount;
+
+    return ((TwentyOnePlusThreeSideBet::suitedTripsPayout + 1) * suitedTripsCount +
+        (TwentyOnePlusThreeSideBet::straightFlushPayout + 1) * straightFlushCount +
+        (TwentyOnePlusThreeSideBet::threeOfAKindPayout + 1) * tripsCount +
+        (TwentyOnePlusThreeSideBet::straightPayout + 1) * straightCount +
+        (TwentyOnePlusThreeSideBet::flushPayout + 1) * flushCount) / drawCount - 1;
+}
\ No newline at end of file
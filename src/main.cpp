@@ -1,54 +1,915 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "Application.h"
 #include "AmericanBlackjack.h"
+#include "EuropeanBlackjack.h"
+#include "Simulator.h"
+#include "RoundProfiler.h"
+#include "HandHistoryReader.h"
+#include "HandHistoryWriter.h"
+#include "ReplayBlackjack.h"
+#include "StrategyTableFile.h"
+#include "PerfectPairsSideBet.h"
+#include "TwentyOnePlusThreeSideBet.h"
+#include "LuckyLadiesSideBet.h"
+#include "MetricsServer.h"
+#include "InputLatencyRecorder.h"
+#include "MessageCatalog.h"
+#include "StructuredDisplayHandler.h"
 
-void initConsoleApplication()
+struct ConsoleOptions
 {
-    AmericanBlackjack game;
+    std::string historyPath;
+
+    std::string checkpointPath;
+
+    BlackjackRules rules;
+
+    bool isEuropean = false;
+
+    // Serves the game metrics on 127.0.0.1 when not zero
+    u16 metricsPort = 0;
+
+    // Input latency summary written when the game is over
+    std::string inputLatencyPath;
+
+    // Compiled or text message catalog, messages.bjmc next to the executable when not given
+    std::string messagesPath;
+
+    // The first locale of the catalog when empty
+    std::string locale;
+
+    // Events for machine clients on stdout instead of the console screen
+    bool isStructured = false;
+
+    StructuredFormat structuredFormat = StructuredFormat::structuredJson;
+};
+
+// American deals the dealer a hole card, European only after the players have acted
+bool parseVariant(const std::string& value)
+{
+    if (value != "american" && value != "european")
+    {
+        throw std::invalid_argument("Unknown variant " + value);
+    }
+
+    return value == "european";
+}
+
+// console, json or binary, the format is only set for the last two
+bool parseDisplay(const std::string& value, StructuredFormat& format)
+{
+    if (value != "console" && value != "json" && value != "binary")
+    {
+        throw std::invalid_argument("Unknown display " + value);
+    }
+
+    format = value == "binary" ? StructuredFormat::structuredBinary : StructuredFormat::structuredJson;
+
+    return value != "console";
+}
+
+// std::stoull() alone accepts "12abc" and reports a bad value with a bare "stoull"
+u64 parseNumber(const std::string& name, const std::string& value)
+{
+    if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos)
+    {
+        throw std::invalid_argument(name + " must be a whole number, got \"" + value + "\"");
+    }
+
+    try
+    {
+        return std::stoull(value);
+    }
+    catch (const std::out_of_range&)
+    {
+        throw std::invalid_argument(name + " is out of range: " + value);
+    }
+}
+
+ConsoleOptions parseConsoleOptions(int argc, char* argv[])
+{
+    ConsoleOptions options;
+
+    for (int argIndex = 1; argIndex + 1 < argc; argIndex += 2)
+    {
+        std::string name = argv[argIndex];
+        std::string value = argv[argIndex + 1];
+
+        if (name == "--history")
+        {
+            options.historyPath = value;
+        }
+        else if (name == "--checkpoint")
+        {
+            options.checkpointPath = value;
+        }
+        else if (name == "--rules")
+        {
+            options.rules = BlackjackRules::readFromFile(value);
+        }
+        else if (name == "--variant")
+        {
+            options.isEuropean = parseVariant(value);
+        }
+        else if (name == "--metrics-port")
+        {
+            u64 port = parseNumber(name, value);
+
+            if (port == 0 || port > 65535)
+            {
+                throw std::invalid_argument(name + " must be a port from 1 to 65535, got " + value);
+            }
+
+            options.metricsPort = static_cast<u16>(port);
+        }
+        else if (name == "--input-latency")
+        {
+            options.inputLatencyPath = value;
+        }
+        else if (name == "--messages")
+        {
+            options.messagesPath = value;
+        }
+        else if (name == "--locale")
+        {
+            options.locale = value;
+        }
+        else if (name == "--display")
+        {
+            options.isStructured = parseDisplay(value, options.structuredFormat);
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown option " + name);
+        }
+    }
+
+    // Every option takes a value, a trailing one without it would otherwise be dropped
+    if (argc % 2 == 0)
+    {
+        throw std::invalid_argument(std::string("Missing value for ") + argv[argc - 1]);
+    }
+
+    if (options.messagesPath.empty())
+    {
+        std::string executablePath = argv[0];
+        u64 separator = executablePath.find_last_of("/\\");
+
+        options.messagesPath = (separator == std::string::npos ? "" : executablePath.substr(0, separator + 1)) + "messages.bjmc";
+    }
+
+    return options;
+}
+
+void initConsoleApplication(const ConsoleOptions& options, const MessageCatalog& messageCatalog)
+{
+    std::unique_ptr<AmericanBlackjack> game(options.isEuropean ? new EuropeanBlackjack() : new AmericanBlackjack());
+    std::unique_ptr<HandHistoryWriter> historyWriter;
+
+    game->setRules(options.rules);
+    game->setCheckpointPath(options.checkpointPath);
+
+    if (!options.historyPath.empty())
+    {
+        historyWriter.reset(new HandHistoryWriter(options.historyPath, game->getRules()));
+        game->setHandHistoryWriter(historyWriter.get());
+    }
+
+    std::unique_ptr<MetricsServer> metricsServer;
+
+    if (options.metricsPort != 0)
+    {
+        metricsServer.reset(new MetricsServer(options.metricsPort));
+
+        // The game is playable without its metrics
+        try
+        {
+            metricsServer->start();
+        }
+        catch (const std::runtime_error& exception)
+        {
+            std::cerr << exception.what() << std::endl;
+        }
+    }
+
     ConsoleInputHandler inputHandler;
-    ConsoleDisplayHandler displayHandler;
-
-    Application app(game, inputHandler, displayHandler);
-
-    app.addMessageEntity("mes_id_info_option_name", new ADisplayEntity("{number}. {option}"));
-    app.addMessageEntity("mes_id_info_choose_option", new ADisplayEntity("Choose {optionName} (enter number from {min} to {max}):", false));
-    app.addMessageEntity("mes_id_error_invalid_choice", new ADisplayEntity("Invalid {optionName} choice."));
-
-    app.addMessageEntity("mes_id_info_player_enter_name", new ADisplayEntity("Enter player name:", false));
-    app.addMessageEntity("mes_id_error_player_name_invalid", new ADisplayEntity("Player name is invalid."));
-    app.addMessageEntity("mes_id_info_player_enter_start_cash", new ADisplayEntity("Enter player's start cash:", false));
-    app.addMessageEntity("mes_id_error_player_cash_invalid", new ADisplayEntity("Player's start cash must be non-negative integer value and less that 1000"));
-    app.addMessageEntity("mes_id_info_player_enter_bet", new ADisplayEntity("Your cash: ${cash}. Enter your bet:", false));
-    app.addMessageEntity("mes_id_error_player_bet_invalid", new ADisplayEntity("Player's bet must be non-negative integer and no greater than player's cash"));
-    app.addMessageEntity("mes_id_info_dealer_cards", new CardsDisplayEntity("Dealer: {cards}"));
-    app.addMessageEntity("mes_id_info_player_cards", new CardsDisplayEntity("Player ({name}): {cards}"));
-
-    app.addMessageEntity("mes_id_info_game_result_dealer_cards", new CardsDisplayEntity("Dealer: {cards}"));
-    app.addMessageEntity("mes_id_info_game_result_player_cards", new CardsDisplayEntity("Player ({name}): {cards}"));
-    app.addMessageEntity("mes_id_info_game_result_win", new ADisplayEntity("Player {name} win! Received ${winCash}", true, true));
-    app.addMessageEntity("mes_id_info_game_result_lose", new ADisplayEntity("Player {name} lose! Lost ${lostCash}", true, true));
-    app.addMessageEntity("mes_id_info_game_result_tie", new ADisplayEntity("Player {name} tie! He's received his bet back.", true, true));
-    app.addMessageEntity("mes_id_info_game_result_overtake", new ADisplayEntity("Player {name} busts!", true, true));
-    app.addMessageEntity("mes_id_info_game_result_dealer_overtake", new ADisplayEntity("Dealer busts!", true, true));
-    app.addMessageEntity("mes_id_info_game_result_blackjack", new ADisplayEntity("Player {name} has Blackjack!", true, true));
-    app.addMessageEntity("mes_id_info_game_result_blackjack_tie", new ADisplayEntity("Player {name} has Blackjack, but the dealer too. Tie.", true, true));
-    app.addMessageEntity("mes_id_info_game_result_blackjack_lose", new ADisplayEntity("Dealer has blackjack. Player {name} lose.", true, true));
-    app.addMessageEntity("mes_id_info_game_result_blackjack_insurance", new ADisplayEntity("Dealer has blackjack. Player {name} received his bet back.", true, true));
-    app.addMessageEntity("mes_id_info_game_result_insurance_lose", new ADisplayEntity("Dealer has no blackjack. Players's insurances are lost.", true, true));
-    app.addMessageEntity("mes_id_info_game_result_split", new ADisplayEntity("Player {name} split:", true, true));
-    app.addMessageEntity("mes_id_info_game_result_split_hand_win", new ADisplayEntity("Hand {number}: Win! Received ${winCash}", true, true));
-    app.addMessageEntity("mes_id_info_game_result_split_hand_lose", new ADisplayEntity("Hand {number}: Lose! Lost ${lostCash}", true, true));
-    app.addMessageEntity("mes_id_info_game_result_split_hand_tie", new ADisplayEntity("Hand {number}: Tie!", true, true));
-    app.addMessageEntity("mes_id_info_game_result_player_left", new ADisplayEntity("Player {name} lose all his money and left us.", true, true));
-    app.addMessageEntity("mes_id_info_shoe_is_reassembled", new ADisplayEntity("Shoe has been reassembled.", true, true));
-
-    app.requestInputToCreatePlayer();
+    std::unique_ptr<AbstractDisplayHandler<ADisplayEntity>> displayHandler;
+
+    if (options.isStructured)
+    {
+        displayHandler.reset(new StructuredDisplayHandler(std::cout, options.structuredFormat));
+    }
+    else
+    {
+        displayHandler.reset(new ConsoleDisplayHandler(true, RenderBackpressure::block));
+    }
+
+    Application app(*game, inputHandler, *displayHandler);
+
+    app.setMessageCatalog(&messageCatalog);
+
+    if (!options.locale.empty())
+    {
+        app.setLocale(options.locale);
+    }
+
+    // An interrupted game goes on with the players and the shoe it was left with
+    if (!game->restoreCheckpoint())
+    {
+        app.requestInputToCreatePlayer();
+    }
 
     app.startGame();
+
+    if (!options.inputLatencyPath.empty())
+    {
+        std::ofstream inputLatencyFile(options.inputLatencyPath);
+
+        InputLatencyRecorder::getInstance().printSummary(inputLatencyFile);
+    }
+
+#ifdef BJ2020_PROFILE
+    std::ofstream traceFile("round_trace.json");
+
+    displayHandler->flush();
+
+    RoundProfiler::getInstance().writeChromeTrace(traceFile);
+    RoundProfiler::getInstance().printSummary(std::cout);
+#endif
+}
+
+struct SimulationOptions
+{
+    u64 shoeCount = 10000;
+
+    u64 firstShoe = 0;
+
+    u16 tableCount = 16;
+
+    u64 seed = AbstractBlackjack::createRunSeed();
+
+    u64 shardIndex = 0;
+
+    u64 shardCount = 1;
+
+    std::string outputPath;
+
+    std::string historyPath;
+
+    std::string strategyDirectory;
+
+    std::string statsPath;
+
+    std::string progressPath;
+
+    u64 statsInterval = 100000;
+
+    std::string checkpointPath;
+
+    u64 checkpointSeconds = 5;
+
+    std::string resumePath;
+
+    BlackjackRules rules;
+
+    bool isEuropean = false;
+
+    std::vector<std::string> sideBetNames;
+
+    ShoeMode shoeMode = ShoeMode::shoeCards;
+};
+
+ShoeMode parseShoeMode(const std::string& value)
+{
+    if (value == "cards")
+    {
+        return ShoeMode::shoeCards;
+    }
+
+    if (value == "ranks")
+    {
+        return ShoeMode::shoeRankCounts;
+    }
+
+    if (value == "infinite")
+    {
+        return ShoeMode::shoeInfiniteDeck;
+    }
+
+    throw std::invalid_argument("Unknown shoe " + value + ", use cards, ranks or infinite");
+}
+
+std::unique_ptr<AbstractSideBet> createSideBet(const std::string& name)
+{
+    if (name == "perfect-pairs")
+    {
+        return std::unique_ptr<AbstractSideBet>(new PerfectPairsSideBet());
+    }
+
+    if (name == "21+3")
+    {
+        return std::unique_ptr<AbstractSideBet>(new TwentyOnePlusThreeSideBet());
+    }
+
+    if (name == "lucky-ladies")
+    {
+        return std::unique_ptr<AbstractSideBet>(new LuckyLadiesSideBet());
+    }
+
+    throw std::invalid_argument("Unknown side bet " + name + ", use perfect-pairs, 21+3 or lucky-ladies");
 }
 
-int main()
+// Shard i/n, counting from zero
+void parseShard(const std::string& value, u64& shardIndex, u64& shardCount)
 {
-    initConsoleApplication();
+    u64 slash = value.find('/');
+
+    if (slash == std::string::npos)
+    {
+        throw std::invalid_argument("--shard must look like i/n, e.g. 0/4, got \"" + value + "\"");
+    }
+
+    shardIndex = parseNumber("--shard", value.substr(0, slash));
+    shardCount = parseNumber("--shard", value.substr(slash + 1));
+}
+
+SimulationOptions parseSimulationOptions(int argc, char* argv[])
+{
+    SimulationOptions options;
+
+    for (int argIndex = 2; argIndex + 1 < argc; argIndex += 2)
+    {
+        std::string name = argv[argIndex];
+        std::string value = argv[argIndex + 1];
+
+        if (name == "--shoes")
+        {
+            options.shoeCount = parseNumber(name, value);
+        }
+        else if (name == "--first-shoe")
+        {
+            options.firstShoe = parseNumber(name, value);
+        }
+        else if (name == "--tables")
+        {
+            options.tableCount = parseNumber(name, value);
+        }
+        else if (name == "--seed")
+        {
+            options.seed = parseNumber(name, value);
+        }
+        else if (name == "--shard")
+        {
+            parseShard(value, options.shardIndex, options.shardCount);
+        }
+        else if (name == "--output")
+        {
+            options.outputPath = value;
+        }
+        else if (name == "--history")
+        {
+            options.historyPath = value;
+        }
+        else if (name == "--strategy-dir")
+        {
+            options.strategyDirectory = value;
+        }
+        else if (name == "--stats")
+        {
+            options.statsPath = value;
+        }
+        else if (name == "--stats-interval")
+        {
+            options.statsInterval = parseNumber(name, value);
+        }
+        else if (name == "--progress")
+        {
+            options.progressPath = value;
+        }
+        else if (name == "--checkpoint")
+        {
+            options.checkpointPath = value;
+        }
+        else if (name == "--checkpoint-interval")
+        {
+            options.checkpointSeconds = parseNumber(name, value);
+        }
+        else if (name == "--resume")
+        {
+            options.resumePath = value;
+        }
+        else if (name == "--rules")
+        {
+            options.rules = BlackjackRules::readFromFile(value);
+        }
+        else if (name == "--variant")
+        {
+            options.isEuropean = parseVariant(value);
+        }
+        else if (name == "--side-bet")
+        {
+            options.sideBetNames.push_back(value);
+        }
+        else if (name == "--shoe")
+        {
+            options.shoeMode = parseShoeMode(value);
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown simulation option " + name);
+        }
+    }
+
+    if (options.tableCount == 0)
+    {
+        throw std::invalid_argument("--tables must be at least 1");
+    }
+
+    if (options.shardIndex >= options.shardCount)
+    {
+        throw std::invalid_argument("--shard index must be below the shard count, e.g. 0/4 to 3/4");
+    }
+
+    // Rank count shoes deal suitless cards that can neither be replayed nor saved
+    if (options.shoeMode != ShoeMode::shoeCards && (!options.sideBetNames.empty() || !options.historyPath.empty() ||
+        !options.checkpointPath.empty() || !options.resumePath.empty()))
+    {
+        throw std::invalid_argument("Side bets, history and checkpoints need --shoe cards");
+    }
+
+    // The variant applies on top of the rules file, whichever came first
+    if (options.isEuropean)
+    {
+        options.rules = EuropeanBlackjack::toEuropeanRules(options.rules);
+    }
+
+    return options;
+}
+
+// The built-in chart is made for the default rules, other rules are played with the strategy computed for them
+BasicStrategy createStrategy(const std::string& strategyDirectory, const BlackjackRules& rules)
+{
+    if (!strategyDirectory.empty())
+    {
+        return BasicStrategy(StrategyTableFile::open(strategyDirectory, rules)->getData());
+    }
+
+    if (rules.getHash() == BlackjackRules().getHash())
+    {
+        return BasicStrategy();
+    }
+
+    std::unique_ptr<StrategyTableData> data(new StrategyTableData());
+
+    StrategyTableBuilder(rules).build(*data);
+
+    return BasicStrategy(*data);
+}
+
+void initSimulation(const SimulationOptions& options)
+{
+    Simulator simulator(options.tableCount, 4, 10, options.seed);
+    std::unique_ptr<HandHistoryWriter> historyWriter;
+
+    simulator.setRules(options.rules);
+    simulator.setStrategy(createStrategy(options.strategyDirectory, options.rules));
+    simulator.setShoeMode(options.shoeMode);
+
+    // Every box stakes the flat bet on each side bet as well, counted apart from the main game
+    std::vector<std::unique_ptr<AbstractSideBet>> sideBets;
+
+    for (auto& name : options.sideBetNames)
+    {
+        sideBets.push_back(createSideBet(name));
+        simulator.addSideBet(sideBets.back().get());
+    }
+
+    if (!options.historyPath.empty())
+    {
+        historyWriter.reset(new HandHistoryWriter(options.historyPath, options.rules));
+        simulator.setHandHistoryWriter(historyWriter.get());
+    }
+
+    std::unique_ptr<SimulationStatsWriter> statsWriter;
+
+    if (!options.statsPath.empty() || !options.progressPath.empty())
+    {
+        statsWriter.reset(new SimulationStatsWriter(options.statsPath, options.progressPath, options.statsInterval));
+        simulator.setStatsWriter(statsWriter.get());
+    }
+
+    if (!options.checkpointPath.empty())
+    {
+        simulator.setCheckpoint(options.checkpointPath, std::chrono::seconds(options.checkpointSeconds));
+    }
+
+    // Shard i of n plays its contiguous share of the shoe range
+    u64 firstShoe = options.firstShoe + options.shoeCount * options.shardIndex / options.shardCount;
+    u64 endShoe = options.firstShoe + options.shoeCount * (options.shardIndex + 1) / options.shardCount;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    if (!options.resumePath.empty())
+    {
+        // The shoe range and the seed come from the checkpoint
+        simulator.resume(options.resumePath);
+    }
+    else
+    {
+        simulator.run(firstShoe, endShoe - firstShoe);
+    }
+
+    std::chrono::duration<f64> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    const SimulationResult& result = simulator.getResult();
+
+    std::cout << "Tables: " << options.tableCount << std::endl;
+    result.printSummary(std::cout);
+    std::cout << "Hands per second: " << (u64) (result.getHandCount() / elapsed.count()) << std::endl;
+
+    ShoeComposition fullShoe;
+
+    fullShoe.reset(options.rules.deckCount);
+
+    for (u8 index = 0; index < sideBets.size(); index++)
+    {
+        std::cout << "Side bet " << (u16) index << ": " << sideBets[index]->getName()
+            << ", EV of a full shoe " << 100 * sideBets[index]->getExpectedValue(fullShoe) << "%"
+            << ", realized " << 100.0 * result.getSideBetNetResult(index) / result.getSideBetStake(index) << "%" << std::endl;
+    }
+
+    if (!options.outputPath.empty())
+    {
+        result.writeToFile(options.outputPath);
+    }
+}
+
+// Plays the same shoes under the American rules, with and without peek, and the European ones,
+// so both the throughput and the house edge of the variants can be compared side by side
+void initVariantComparison(const SimulationOptions& options)
+{
+    BlackjackRules peekRules = options.rules;
+    peekRules.dealerHoleCard = true;
+    peekRules.dealerPeeks = true;
+
+    BlackjackRules noPeekRules = options.rules;
+    noPeekRules.dealerHoleCard = true;
+    noPeekRules.dealerPeeks = false;
+
+    const std::vector<std::pair<std::string, BlackjackRules>> variants =
+    {
+        {"American, peek", peekRules},
+        {"American, no peek", noPeekRules},
+        {"European", EuropeanBlackjack::toEuropeanRules(options.rules)}
+    };
+
+    std::cout << "Seed: " << options.seed << ", shoes: " << options.shoeCount << ", tables: " << options.tableCount << std::endl;
+
+    for (const auto& variant : variants)
+    {
+        Simulator simulator(options.tableCount, 4, 10, options.seed);
+
+        simulator.setRules(variant.second);
+        simulator.setStrategy(createStrategy(options.strategyDirectory, variant.second));
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        simulator.run(options.firstShoe, options.shoeCount);
+
+        std::chrono::duration<f64> elapsed = std::chrono::steady_clock::now() - startTime;
+
+        const SimulationResult& result = simulator.getResult();
+
+        std::cout << variant.first << ": "
+            << (u64) (result.getHandCount() / elapsed.count()) << " hands/s, "
+            << "edge " << 100.0 * result.getNetResult() / result.getTotalBet() << "%, "
+            << "net per box and round " << result.getMeanNetResult() << " +/- " << result.getMeanNetResultHalfWidth() << " (95%)" << std::endl;
+    }
+}
+
+// Deals the same shoe range from each kind of shoe: first the bare cards up to the penetration,
+// then whole simulated rounds, so the cost of the shoe can be told apart from the cost of the game
+void initShoeComparison(const SimulationOptions& options)
+{
+    const std::vector<std::pair<std::string, ShoeMode>> shoeModes =
+    {
+        {"Cards", ShoeMode::shoeCards},
+        {"Rank counts", ShoeMode::shoeRankCounts},
+        {"Infinite deck", ShoeMode::shoeInfiniteDeck}
+    };
+
+    std::cout << "Seed: " << options.seed << ", shoes: " << options.shoeCount << ", decks: "
+        << (u16) options.rules.deckCount << std::endl;
+
+    for (const auto& shoeMode : shoeModes)
+    {
+        SimulationBlackjack table(1, 10);
+        u64 cardCount = 0;
+        u64 valueSum = 0;
+
+        table.setRunSeed(options.seed);
+        table.setShoeMode(shoeMode.second);
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        for (u64 shoeNumber = options.firstShoe; shoeNumber < options.firstShoe + options.shoeCount; shoeNumber++)
+        {
+            table.setNextShoeNumber(shoeNumber);
+
+            u16 dealtCount = table.createShoe(options.rules.deckCount).size() * options.rules.penetration;
+
+            table.shuffleShoe();
+
+            for (u16 index = 0; index < dealtCount; index++)
+            {
+                valueSum += table.getNextCard()->getCardValue();
+            }
+
+            cardCount += dealtCount;
+        }
+
+        std::chrono::duration<f64> dealElapsed = std::chrono::steady_clock::now() - startTime;
+
+        Simulator simulator(options.tableCount, 4, 10, options.seed);
+
+        simulator.setRules(options.rules);
+        simulator.setStrategy(createStrategy(options.strategyDirectory, options.rules));
+        simulator.setShoeMode(shoeMode.second);
+
+        startTime = std::chrono::steady_clock::now();
+
+        simulator.run(options.firstShoe, options.shoeCount);
+
+        std::chrono::duration<f64> simulationElapsed = std::chrono::steady_clock::now() - startTime;
+
+        const SimulationResult& result = simulator.getResult();
+
+        // The mean card value keeps the dealing loop from being optimized away
+        std::cout << shoeMode.first << ": "
+            << (u64) (cardCount / dealElapsed.count()) << " cards/s, "
+            << "mean card value " << (f64) valueSum / cardCount << ", "
+            << (u64) (result.getHandCount() / simulationElapsed.count()) << " hands/s, "
+            << "edge " << 100.0 * result.getNetResult() / result.getTotalBet() << "%" << std::endl;
+    }
+}
+
+void initMerge(int argc, char* argv[])
+{
+    std::vector<SimulationResult> results(argc - 2);
+
+    for (int argIndex = 2; argIndex < argc; argIndex++)
+    {
+        results[argIndex - 2].readFromFile(argv[argIndex]);
+    }
+
+    std::sort(results.begin(), results.end(), [](const SimulationResult& a, const SimulationResult& b)
+    {
+        return a.getFirstShoe() < b.getFirstShoe();
+    });
+
+    SimulationResult merged;
+
+    for (u64 index = 0; index < results.size(); index++)
+    {
+        // A shoe counted twice would bias the aggregate, gaps are fine
+        if (index > 0 && results[index].getFirstShoe() <
+            results[index - 1].getFirstShoe() + results[index - 1].getShoeCount())
+        {
+            throw std::invalid_argument("Shard shoe ranges overlap");
+        }
+
+        merged.merge(results[index]);
+    }
+
+    std::cout << "Files: " << results.size() << std::endl;
+    merged.printSummary(std::cout);
+}
+
+void initMessageCompilation(const std::string& sourcePath, const std::string& catalogPath)
+{
+    std::ifstream source(sourcePath);
+
+    if (!source)
+    {
+        throw std::invalid_argument("Can't open " + sourcePath);
+    }
+
+    std::vector<u8> compiledData;
+
+    try
+    {
+        compiledData = MessageCatalog::compile(source);
+    }
+    catch (const std::invalid_argument& exception)
+    {
+        throw std::invalid_argument(sourcePath + ": " + exception.what());
+    }
+
+    MessageCatalog::write(catalogPath, compiledData);
+
+    MessageCatalog catalog(catalogPath);
+
+    std::cout << "Catalog: " << catalogPath << std::endl;
+    std::cout << "Locales: " << catalog.getLocaleCount() << std::endl;
+    std::cout << "Messages: " << catalog.getMessageCount() << std::endl;
+    std::cout << "Bytes: " << compiledData.size() << std::endl;
+}
+
+void initHistoryStats(const std::string& path)
+{
+    HandHistoryReader reader(path);
+    HandHistoryRecord record;
+    u64 recordCount = 0;
+    u64 handCount = 0;
+    u64 actionCount = 0;
+    u64 totalBet = 0;
+    u64 totalPayout = 0;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    while (reader.next(record))
+    {
+        recordCount++;
+        handCount += record.getHandCount();
+        actionCount += record.getActionCount();
+        totalBet += record.getTotalBet();
+        totalPayout += record.getTotalPayout();
+    }
+
+    std::chrono::duration<f64> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    std::cout << "Rounds: " << recordCount << std::endl;
+    std::cout << "Bytes per round: " << (recordCount ? (f64) reader.getFileSize() / recordCount : 0) << std::endl;
+    std::cout << "Hands: " << handCount << std::endl;
+    std::cout << "Actions: " << actionCount << std::endl;
+    std::cout << "Total bet: " << totalBet << std::endl;
+    std::cout << "Total payout: " << totalPayout << std::endl;
+    std::cout << "Rounds per second: " << (u64) (recordCount / elapsed.count()) << std::endl;
+}
+
+void initStrategyTable(const std::string& directory, const BlackjackRules& rules)
+{
+    auto startTime = std::chrono::steady_clock::now();
+    auto table = StrategyTableFile::open(directory, rules);
+
+    std::chrono::duration<f64> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    const StrategyTableData& data = table->getData();
+    // By action index, lowercase when the fallback is standing: d - double or stand, r - surrender or stand
+    const char actionLetters[] = {'H', 'S', 'D', 'I', 'P', 'W', 'R', 'R'};
+
+    std::cout << "Table: " << StrategyTableFile::getPath(directory, rules) << std::endl;
+    std::cout << "Open time: " << elapsed.count() * 1000 << " ms" << std::endl;
+    std::cout << "Game EV: " << 100 * data.gameEv << "%" << std::endl;
+    rules.write(std::cout);
+
+    // Chart rows per player hand, columns per dealer upcard 2..10, A
+    for (u8 soft = 0; soft <= 1; soft++)
+    {
+        for (u8 total = soft ? 13 : 5; total <= (soft ? 20 : 17); total++)
+        {
+            std::cout << (soft ? "Soft " : "Hard ") << (u16) total << ": ";
+
+            for (u8 upcard = 2; upcard <= 11; upcard++)
+            {
+                u8 entry = data.handTable[soft][total][upcard];
+
+                char letter = actionLetters[entry & 0x0F];
+
+                std::cout << (char) ((entry & 0x0F) != standAction && (entry >> 4) == standAction ? std::tolower(letter) : letter);
+            }
+
+            std::cout << std::endl;
+        }
+    }
+
+    for (u8 cardValue = 2; cardValue <= 11; cardValue++)
+    {
+        std::cout << "Pair " << (u16) cardValue << ": ";
+
+        for (u8 upcard = 2; upcard <= 11; upcard++)
+        {
+            std::cout << (data.pairTable[cardValue][upcard] ? 'P' : '.');
+        }
+
+        std::cout << std::endl;
+    }
+}
+
+bool initReplay(const std::string& path)
+{
+    HandHistoryReader reader(path);
+    ReplayBlackjack replay;
+
+    replay.setRules(reader.getRules());
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    replay.replay(reader);
+
+    std::chrono::duration<f64> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    for (auto& mismatch : replay.getMismatches())
+    {
+        std::cout << mismatch << std::endl;
+    }
+
+    std::cout << "Rounds: " << replay.getRoundCount() << std::endl;
+    std::cout << "Hands: " << replay.getHandCount() << std::endl;
+    std::cout << "Mismatches: " << replay.getMismatchCount() << std::endl;
+    std::cout << "Rounds per second: " << (u64) (replay.getRoundCount() / elapsed.count()) << std::endl;
+
+    return replay.getMismatchCount() == 0;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string mode = argc > 1 ? argv[1] : "";
+    ConsoleOptions consoleOptions;
+    std::unique_ptr<MessageCatalog> messageCatalog;
+
+    try
+    {
+        if (mode == "--simulate")
+        {
+            initSimulation(parseSimulationOptions(argc, argv));
+
+            return 0;
+        }
+
+        if (mode == "--compare-variants")
+        {
+            initVariantComparison(parseSimulationOptions(argc, argv));
+
+            return 0;
+        }
+
+        if (mode == "--compare-shoes")
+        {
+            initShoeComparison(parseSimulationOptions(argc, argv));
+
+            return 0;
+        }
+
+        if (mode == "--merge")
+        {
+            initMerge(argc, argv);
+
+            return 0;
+        }
+
+        if (mode == "--strategy-table" && argc > 2)
+        {
+            initStrategyTable(argv[2], argc > 3 ? BlackjackRules::readFromFile(argv[3]) : BlackjackRules());
+
+            return 0;
+        }
+
+        if (mode == "--replay" && argc > 2)
+        {
+            return initReplay(argv[2]) ? 0 : 1;
+        }
+
+        if (mode == "--history-stats" && argc > 2)
+        {
+            initHistoryStats(argv[2]);
+
+            return 0;
+        }
+
+        if (mode == "--compile-messages" && argc > 3)
+        {
+            initMessageCompilation(argv[2], argv[3]);
+
+            return 0;
+        }
+
+        consoleOptions = parseConsoleOptions(argc, argv);
+        messageCatalog = MessageCatalog::open(consoleOptions.messagesPath);
+
+        if (!consoleOptions.locale.empty() && messageCatalog->findLocale(consoleOptions.locale) < 0)
+        {
+            throw std::invalid_argument("Unknown locale " + consoleOptions.locale);
+        }
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << std::endl;
+
+        return 1;
+    }
+
+    initConsoleApplication(consoleOptions, *messageCatalog);
 
     return 0;
 }
\ No newline at end of file
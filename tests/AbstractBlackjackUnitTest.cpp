@@ -4,6 +4,7 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -14,6 +15,58 @@
 #include "MockInputAdapter.h"
 #include "Card.h"
 #include "Box.h"
+#include "HitBlackjackAction.h"
+#include "StandBlackjackAction.h"
+#include "DoubleBlackjackAction.h"
+#include "InsuranceBlackjackAction.h"
+#include "SplitBlackjackAction.h"
+#include "SwitchHandBlackjackAction.h"
+#include "LateSurrenderBlackjackAction.h"
+#include "EarlySurrenderBlackjackAction.h"
+
+// A custom action derived from a built-in one, asked through its own isAvailable()
+class ThirdCardBlackjackAction: public HitBlackjackAction
+{
+public:
+    using HitBlackjackAction::HitBlackjackAction;
+
+    bool isAvailable(Box* currentBox) override
+    {
+        return currentBox->getHandCardsCount() == 3;
+    }
+
+    u8 getActionType() override
+    {
+        return AbstractBlackjackAction::customActionType;
+    }
+};
+
+class ActionMaskBlackjack: public MockAbstractBlackjack
+{
+public:
+    ActionMaskBlackjack()
+    {
+        this->addAction(new HitBlackjackAction(this));
+        this->addAction(new StandBlackjackAction(this));
+        this->addAction(new DoubleBlackjackAction(this));
+        this->addAction(new InsuranceBlackjackAction(this));
+        this->addAction(new SplitBlackjackAction(this));
+        this->addAction(new SwitchHandBlackjackAction(this));
+        this->addAction(new LateSurrenderBlackjackAction(this));
+        this->addAction(new EarlySurrenderBlackjackAction(this));
+        this->addAction(new ThirdCardBlackjackAction(this));
+    }
+
+    std::vector<AbstractBlackjackAction*>& getActions()
+    {
+        return this->actions;
+    }
+
+    void clearInsurances()
+    {
+        this->insuredBoxIndexes.clear();
+    }
+};
 
 MATCHER(CardEq, "")
 {
@@ -92,6 +145,74 @@ TEST(AbstractBlackjack, shuffleShoe)
     ASSERT_TRUE(cardEx1 != card1 || cardEx2 != card2 || cardEx3 != card3);
 }
 
+/**
+ * Testing PhiloxRng against the known-answer vectors of the reference implementation
+ */
+TEST(AbstractBlackjack, philoxRng)
+{
+    u32 result[4];
+
+    const u32 counter1[4] = {0, 0, 0, 0};
+    const u32 key1[2] = {0, 0};
+    PhiloxRng::generateBlock(counter1, key1, result);
+
+    EXPECT_THAT(result, testing::ElementsAre(0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8));
+
+    const u32 counter2[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+    const u32 key2[2] = {0xffffffff, 0xffffffff};
+    PhiloxRng::generateBlock(counter2, key2, result);
+
+    EXPECT_THAT(result, testing::ElementsAre(0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd));
+
+    const u32 counter3[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+    const u32 key3[2] = {0xa4093822, 0x299f31d0};
+    PhiloxRng::generateBlock(counter3, key3, result);
+
+    EXPECT_THAT(result, testing::ElementsAre(0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1));
+}
+
+/**
+ * Testing that shuffleShoe() reproduces any shoe from the run seed and shoe number alone
+ */
+TEST(AbstractBlackjack, shuffleShoeReproducible)
+{
+    MockAbstractBlackjack game1;
+    MockAbstractBlackjack game2;
+
+    game1.setRunSeed(2020);
+    game2.setRunSeed(2020);
+
+    // Shuffle shoes 0, 1 and 2 in the first game
+    game1.createShoe(6);
+    game1.shuffleShoe();
+    game1.createShoe(6);
+    game1.shuffleShoe();
+    game1.createShoe(6);
+    auto shoe2 = game1.shuffleShoe();
+
+    // Jump straight to shoe 2 in the second game
+    game2.setNextShoeNumber(2);
+    game2.createShoe(6);
+    auto replayedShoe2 = game2.shuffleShoe();
+
+    EXPECT_EQ(game1.getShoeNumber(), 2);
+    EXPECT_EQ(game2.getShoeNumber(), 2);
+    EXPECT_THAT(replayedShoe2, testing::Pointwise(CardEq(), shoe2));
+
+    // Another shoe number gives another order
+    game2.createShoe(6);
+    auto shoe3 = game2.shuffleShoe();
+
+    bool isSameOrder = true;
+
+    for (u16 index = 0; index < shoe3.size(); index++)
+    {
+        isSameOrder = isSameOrder && shoe3[index] == shoe2[index];
+    }
+
+    EXPECT_FALSE(isSameOrder);
+}
+
 /**
  * Testing createBoxes() method
  */
@@ -440,6 +561,693 @@ TEST(AbstractBlackjack, shouldShoeBeReassembled)
     EXPECT_TRUE(game.shouldShoeBeReassembled(playerCount));
 }
 
+/**
+ * Testing both appendToDecisionBatch() and evaluateActionMasks() methods
+ */
+TEST(AbstractBlackjack, evaluateActionMasks)
+{
+    MockAbstractBlackjack game;
+    MockInputHandler inputHandler;
+    MockDisplayHandler displayHandler;
+    Application app(game, inputHandler, displayHandler);
+
+    app.createPlayer("Test1", 500);
+    app.createPlayer("Test2", 500);
+
+    auto& boxes = game.createBoxes(app.getPlayers(), 2);
+
+    Card ace(CardFace::ace, CardSuit::club);
+    Card eight1(8, CardSuit::club);
+    Card eight2(8, CardSuit::heart);
+    Card ten(10, CardSuit::spade);
+    Card king(CardFace::king, CardSuit::spade);
+
+    game.getDealerBox().giveCard(&ace);
+    game.getDealerBox().giveCard(&ten);
+
+    boxes[0].setBet(100);
+    boxes[0].giveCard(&eight1);
+    boxes[0].giveCard(&eight2);
+
+    boxes[1].setBet(300);
+    boxes[1].giveCard(&ten);
+    boxes[1].giveCard(&king);
+
+    DecisionBatch batch;
+
+    game.appendToDecisionBatch(batch, boxes[0]);
+    game.appendToDecisionBatch(batch, boxes[1]);
+
+    AbstractBlackjack::evaluateActionMasks(batch);
+
+    // Check if facts of the hands are collected
+    EXPECT_EQ(batch.size(), 2);
+    EXPECT_EQ(batch.handValues[0], 16);
+    EXPECT_EQ(batch.pairValues[0], 8);
+    EXPECT_EQ(batch.pairValues[1], 0);
+    EXPECT_EQ(batch.dealerUpcards[0], 11);
+
+    // Pair of eights against an ace can be hit, stood, doubled, insured and split
+    EXPECT_EQ(batch.actionMasks[0], 1 << hitAction | 1 << standAction | 1 << doubleAction |
+        1 << insuranceAction | 1 << splitAction);
+
+    // 10 and K are not a pair, and the rest of the cash only covers the insurance
+    EXPECT_EQ(batch.actionMasks[1], 1 << hitAction | 1 << standAction | 1 << insuranceAction);
+}
+
+/**
+ * Testing that 10 and K are not a pair in the hand state, the action mask, the batch and the split action alike
+ */
+TEST(AbstractBlackjack, splitTenAndKing)
+{
+    ActionMaskBlackjack game;
+    MockInputHandler inputHandler;
+    MockDisplayHandler displayHandler;
+    Application app(game, inputHandler, displayHandler);
+
+    app.createPlayer("Test1", 500);
+    app.createPlayer("Test2", 500);
+
+    auto& boxes = game.createBoxes(app.getPlayers(), 2);
+    auto& actions = game.getActions();
+
+    Card six(6, CardSuit::club);
+    Card ten1(10, CardSuit::spade);
+    Card ten2(10, CardSuit::heart);
+    Card king(CardFace::king, CardSuit::spade);
+
+    game.getDealerBox().giveCard(&six);
+    game.getDealerBox().giveCard(&ten1);
+
+    boxes[0].setBet(100);
+    boxes[0].giveCard(&ten1);
+    boxes[0].giveCard(&king);
+
+    boxes[1].setBet(100);
+    boxes[1].giveCard(&ten1);
+    boxes[1].giveCard(&ten2);
+
+    // Both hands are the same hard 20 to the automaton, which doesn't know faces
+    EXPECT_EQ(boxes[0].getHandState(), boxes[1].getHandState());
+    EXPECT_EQ(game.getHandFacts(boxes[0]).pairValue, 0);
+    EXPECT_EQ(game.getHandFacts(boxes[1]).pairValue, 10);
+
+    DecisionBatch batch;
+
+    game.appendToDecisionBatch(batch, boxes[0]);
+    game.appendToDecisionBatch(batch, boxes[1]);
+
+    AbstractBlackjack::evaluateActionMasks(batch, game.getRules());
+
+    for (u8 boxIndex = 0; boxIndex < 2; boxIndex++)
+    {
+        bool isSplitAvailable = boxIndex == 1;
+
+        EXPECT_EQ(batch.actionMasks[boxIndex] >> splitAction & 1, isSplitAvailable);
+        EXPECT_EQ(game.getAvailableActionMask(boxes[boxIndex]) >> splitAction & 1, isSplitAvailable);
+        EXPECT_EQ(actions[splitAction]->isAvailable(&boxes[boxIndex]), isSplitAvailable);
+    }
+}
+
+/**
+ * Testing evaluateActionMasks() method with a rules policy and runtime rules
+ */
+TEST(AbstractBlackjack, evaluateActionMasksWithRules)
+{
+    using SplitLimitRules = RulesPolicy<6, true, 6, 5, DoubleRule::doubleAnyTwo, true, 2, false, SurrenderRule::surrenderNone, true, true>;
+
+    MockAbstractBlackjack game;
+    MockInputHandler inputHandler;
+    MockDisplayHandler displayHandler;
+    Application app(game, inputHandler, displayHandler);
+
+    app.createPlayer("Test1", 500);
+
+    auto& box = game.createBoxes(app.getPlayers(), 1)[0];
+
+    Card ace1(CardFace::ace, CardSuit::club);
+    Card ace2(CardFace::ace, CardSuit::heart);
+    Card ace3(CardFace::ace, CardSuit::spade);
+    Card six(6, CardSuit::diamond);
+    Card ten(10, CardSuit::spade);
+
+    game.getDealerBox().giveCard(&six);
+    game.getDealerBox().giveCard(&ten);
+
+    // Second hand of split aces, which drew another ace
+    box.setBet(100);
+    box.giveCard(&ace1);
+    box.giveCard(&ace2);
+    box.switchHand(2);
+    box.setBet(100);
+    box.giveCard(&ace3);
+    box.giveCard(&ten);
+    box.switchHand(1);
+    box.getHandCards()[1] = &ace3;
+
+    DecisionBatch batch;
+
+    game.appendToDecisionBatch(batch, box);
+
+    // Default rules: no double after split, aces can be resplit
+    AbstractBlackjack::evaluateActionMasks(batch, AmericanRules());
+
+    EXPECT_EQ(batch.actionMasks[0], 1 << hitAction | 1 << standAction | 1 << splitAction | 1 << switchHandAction);
+
+    // Double after split, but at most two hands and no resplit of aces
+    AbstractBlackjack::evaluateActionMasks(batch, SplitLimitRules());
+
+    EXPECT_EQ(batch.actionMasks[0], 1 << hitAction | 1 << standAction | 1 << doubleAction | 1 << switchHandAction);
+
+    // Check if runtime rules give the same masks as the policy they are made from
+    BlackjackRules rules = SplitLimitRules::toRules();
+
+    AbstractBlackjack::evaluateActionMasks(batch, rules);
+
+    EXPECT_EQ(batch.actionMasks[0], 1 << hitAction | 1 << standAction | 1 << doubleAction | 1 << switchHandAction);
+    EXPECT_TRUE(AmericanRules::toRules() == BlackjackRules());
+    EXPECT_NE(rules.getHash(), BlackjackRules().getHash());
+
+    // Blackjack pays 6 to 5
+    game.setRules(rules);
+
+    u32 winCash = game.payToPlayerForBlackjack(&box);
+
+    EXPECT_EQ(winCash, 120);
+}
+
+/**
+ * Testing getAvailableActionMask() and getAvailableActionIndexes() methods against isAvailable() of every action
+ */
+TEST(AbstractBlackjack, getAvailableActionMask)
+{
+    ActionMaskBlackjack game;
+    MockInputHandler inputHandler;
+    MockDisplayHandler displayHandler;
+    Application app(game, inputHandler, displayHandler);
+    BlackjackRules rules;
+    u32 comparedCount = 0;
+
+    app.createPlayer("Test1", 500);
+
+    auto& box = game.createBoxes(app.getPlayers(), 1)[0];
+    auto& dealerBox = game.getDealerBox();
+    auto& actions = game.getActions();
+    auto& player = box.getPlayer();
+
+    game.setRunSeed(42);
+
+    for (u16 round = 0; round < 3000; round++)
+    {
+        // Every rule an action depends on changes from round to round
+        rules.doubleRule = DoubleRule(round % 3);
+        rules.surrender = SurrenderRule(round / 3 % 3);
+        rules.doubleAfterSplit = round % 2 == 0;
+        rules.resplitAces = round % 5 < 2;
+        rules.maxSplitHands = 2 + round % 3;
+        rules.dealerPeeks = round % 7 == 0;
+        game.setRules(rules);
+
+        if (round % 10 == 0)
+        {
+            game.createShoe(6);
+            game.shuffleShoe();
+        }
+
+        box.resetBox();
+        dealerBox.resetBox();
+        game.clearInsurances();
+        player.increaseCash(500 - player.getCash());
+
+        // Bets up to the whole cash, so some actions can't be afforded
+        box.setBet(100 * (1 + round % 5));
+        box.giveCard(game.getNextCard());
+        box.giveCard(game.getNextCard());
+        dealerBox.giveCard(game.getNextCard());
+        dealerBox.giveCard(game.getNextCard());
+
+        for (u8 step = 0; step < 4 && box.getHandCardsValue() < 21; step++)
+        {
+            u32 availableMask = game.getAvailableActionMask(box);
+            std::vector<u8> availableIndexes = game.getAvailableActionIndexes(box);
+
+            for (u8 index = 0; index < actions.size(); index++)
+            {
+                bool isAvailable = actions[index]->isAvailable(&box);
+
+                ASSERT_EQ(availableMask >> index & 1, isAvailable) << "round " << round << ", action " << (u16) index;
+                ASSERT_EQ(std::count(availableIndexes.begin(), availableIndexes.end(), index), isAvailable);
+            }
+
+            comparedCount++;
+
+            // Split, insure or switch when they are offered, hit otherwise
+            u8 preferredAction = std::vector<u8>{splitAction, insuranceAction, switchHandAction, hitAction}[(round + step) % 4];
+
+            actions[availableMask >> preferredAction & 1 ? preferredAction : hitAction]->execute(&box);
+        }
+    }
+
+    EXPECT_GT(comparedCount, 5000);
+}
+
+/**
+ * Testing getActionMenu() method: one menu per set of available actions, with its option rows rendered once
+ */
+TEST(AbstractBlackjack, getActionMenu)
+{
+    ActionMaskBlackjack game;
+    MockInputHandler inputHandler;
+    MockDisplayHandler displayHandler;
+    Application app(game, inputHandler, displayHandler);
+
+    app.addMessageEntity("mes_id_info_option_name", new ADisplayEntity("{number}. {option}"));
+    app.createPlayer("Test1", 500);
+    app.createPlayer("Test2", 500);
+
+    auto& boxes = game.createBoxes(app.getPlayers(), 2);
+
+    Card ace(CardFace::ace, CardSuit::club);
+    Card six(6, CardSuit::club);
+    Card eight1(8, CardSuit::club);
+    Card eight2(8, CardSuit::heart);
+    Card eight3(8, CardSuit::spade);
+    Card eight4(8, CardSuit::diamond);
+    Card ten(10, CardSuit::club);
+
+    game.getDealerBox().giveCard(&six);
+    game.getDealerBox().giveCard(&ace);
+
+    for (auto& box : boxes)
+    {
+        box.setBet(100);
+    }
+
+    boxes[0].giveCard(&eight1);
+    boxes[0].giveCard(&eight2);
+    boxes[1].giveCard(&eight3);
+    boxes[1].giveCard(&eight4);
+
+    ActionMenu& pairMenu = game.getActionMenu(boxes[0]);
+
+    // Same actions, same menu
+    EXPECT_EQ(&game.getActionMenu(boxes[1]), &pairMenu);
+    EXPECT_EQ(pairMenu.getActionIndexes(), game.getAvailableActionIndexes(boxes[0]));
+    EXPECT_EQ(pairMenu.getActionNames(), game.getActionNames(pairMenu.getActionIndexes()));
+
+    std::string renderedOptions;
+
+    for (u8 index = 0; index < pairMenu.getActionNames().size(); index++)
+    {
+        renderedOptions += std::to_string(index + 1) + ". " + pairMenu.getActionNames()[index] + "\n";
+    }
+
+    EXPECT_EQ(pairMenu.getOptionParams()[1]->getValue(), renderedOptions);
+    EXPECT_EQ(pairMenu.getRequestParams()[2]->getValue(), std::to_string(pairMenu.getActionIndexes().size()));
+
+    boxes[1].giveCard(&ten);
+
+    // No pair and three cards, split and double are gone
+    ActionMenu& hardMenu = game.getActionMenu(boxes[1]);
+
+    EXPECT_NE(&hardMenu, &pairMenu);
+    EXPECT_EQ(hardMenu.getActionIndexes(), game.getAvailableActionIndexes(boxes[1]));
+    EXPECT_LT(hardMenu.getActionIndexes().size(), pairMenu.getActionIndexes().size());
+}
+
+/**
+ * Testing getInitialDealerCardCount() method and the round without a hole card
+ */
+TEST(AbstractBlackjack, getInitialDealerCardCount)
+{
+    MockAbstractBlackjack game;
+    MockInputHandler inputHandler;
+    MockDisplayHandler displayHandler;
+    Application app(game, inputHandler, displayHandler);
+
+    app.createPlayer("Test1", 500);
+
+    auto& boxes = game.createBoxes(app.getPlayers(), 1);
+
+    EXPECT_EQ(game.getInitialDealerCardCount(), 2);
+
+    BlackjackRules rules;
+    rules.dealerHoleCard = false;
+    game.setRules(rules);
+
+    EXPECT_EQ(game.getInitialDealerCardCount(), 1);
+
+    Card ace(CardFace::ace, CardSuit::club);
+    Card eight1(8, CardSuit::club);
+    Card eight2(8, CardSuit::heart);
+
+    game.getDealerBox().giveCard(&ace);
+
+    boxes[0].setBet(100);
+    boxes[0].giveCard(&eight1);
+    boxes[0].giveCard(&eight2);
+
+    DecisionBatch batch;
+
+    game.appendToDecisionBatch(batch, boxes[0]);
+
+    AbstractBlackjack::evaluateActionMasks(batch, game.getRules());
+
+    // Check if the ace upcard alone offers no insurance
+    EXPECT_EQ(batch.dealerUpcards[0], 11);
+    EXPECT_EQ(batch.actionMasks[0], 1 << hitAction | 1 << standAction | 1 << doubleAction | 1 << splitAction);
+}
+
+/**
+ * Testing settleHand() method
+ */
+TEST(AbstractBlackjack, settleHand)
+{
+    MockAbstractBlackjack game;
+    MockInputHandler inputHandler;
+    MockDisplayHandler displayHandler;
+    Application app(game, inputHandler, displayHandler);
+
+    app.createPlayer("Test1", 1000);
+
+    auto& box = game.createBoxes(app.getPlayers(), 1)[0];
+    auto& dealerBox = game.getDealerBox();
+    auto& player = box.getPlayer();
+    u32 winCash = 0;
+
+    Card ace(CardFace::ace, CardSuit::club);
+    Card nine(9, CardSuit::club);
+    Card ten(10, CardSuit::heart);
+    Card king(CardFace::king, CardSuit::spade);
+    Card six(6, CardSuit::diamond);
+
+    box.setBet(100);
+    box.giveCard(&ten);
+    box.giveCard(&king);
+    dealerBox.giveCard(&ace);
+    dealerBox.giveCard(&nine);
+
+    // 20 against dealer's soft 20 is a tie and the bet is returned
+    EXPECT_EQ(game.settleHand(&box, 0, winCash), HandResult::handTie);
+    EXPECT_EQ(player.getCash(), 1000);
+
+    box.resetBox();
+    dealerBox.resetBox();
+
+    box.setBet(100);
+    box.giveCard(&ace);
+    box.giveCard(&king);
+    dealerBox.giveCard(&ten);
+    dealerBox.giveCard(&six);
+
+    // Blackjack pays 3 to 2
+    EXPECT_EQ(game.settleHand(&box, 0, winCash), HandResult::handBlackjack);
+    EXPECT_EQ(winCash, 150);
+    EXPECT_EQ(player.getCash(), 1150);
+
+    box.resetBox();
+
+    box.setBet(100);
+    box.giveCard(&ten);
+    box.giveCard(&six);
+    box.giveCard(&king);
+
+    // Busted hand loses its bet whatever the dealer has
+    EXPECT_EQ(game.settleHand(&box, 0, winCash), HandResult::handOvertake);
+    EXPECT_EQ(player.getCash(), 1050);
+
+    box.resetBox();
+
+    box.setBet(100);
+    box.giveCard(&ace);
+    box.giveCard(&king);
+    dealerBox.giveCard(&king);
+
+    // Blackjack still pays 3 to 2 when the dealer draws to a bust
+    EXPECT_EQ(game.settleHand(&box, 0, winCash), HandResult::handBlackjack);
+    EXPECT_EQ(winCash, 150);
+    EXPECT_EQ(player.getCash(), 1200);
+}
+
+/**
+ * Testing settleHand() method for surrendered hands
+ */
+TEST(AbstractBlackjack, settleSurrender)
+{
+    MockAbstractBlackjack game;
+    MockInputHandler inputHandler;
+    MockDisplayHandler displayHandler;
+    Application app(game, inputHandler, displayHandler);
+
+    app.createPlayer("Test1", 1000);
+
+    auto& box = game.createBoxes(app.getPlayers(), 1)[0];
+    auto& dealerBox = game.getDealerBox();
+    auto& player = box.getPlayer();
+    BlackjackRules rules;
+    u32 winCash = 0;
+
+    Card ace(CardFace::ace, CardSuit::club);
+    Card ten(10, CardSuit::heart);
+    Card king(CardFace::king, CardSuit::spade);
+    Card six(6, CardSuit::diamond);
+    Card seven(7, CardSuit::diamond);
+
+    rules.surrender = SurrenderRule::surrenderLate;
+    game.setRules(rules);
+
+    box.setBet(100);
+    box.giveCard(&ten);
+    box.giveCard(&six);
+    dealerBox.giveCard(&ten);
+    dealerBox.giveCard(&seven);
+    game.addSurrenderedBoxIndex(0);
+
+    // Half of the bet comes back, though 16 would have lost anyway
+    EXPECT_TRUE(game.hasSurrenderedBoxIndex(0));
+    EXPECT_EQ(game.settleHand(&box, 0, winCash), HandResult::handSurrender);
+    EXPECT_EQ(winCash, 0);
+    EXPECT_EQ(player.getCash(), 950);
+
+    box.resetBox();
+    dealerBox.resetBox();
+
+    box.setBet(100);
+    box.giveCard(&ten);
+    box.giveCard(&six);
+    dealerBox.giveCard(&ace);
+    dealerBox.giveCard(&king);
+
+    // Late surrender is void against a dealer blackjack
+    EXPECT_EQ(game.settleHand(&box, 0, winCash), HandResult::handBlackjackLose);
+    EXPECT_EQ(player.getCash(), 850);
+
+    box.resetBox();
+
+    rules.surrender = SurrenderRule::surrenderEarly;
+    game.setRules(rules);
+
+    box.setBet(100);
+    box.giveCard(&ten);
+    box.giveCard(&six);
+
+    // Early surrender holds against it
+    EXPECT_EQ(game.settleHand(&box, 0, winCash), HandResult::handSurrender);
+    EXPECT_EQ(player.getCash(), 800);
+
+    // Check if surrender is offered on the first two cards only, under its own rule
+    DecisionBatch batch;
+
+    game.appendToDecisionBatch(batch, box);
+    box.giveCard(&seven);
+    game.appendToDecisionBatch(batch, box);
+
+    AbstractBlackjack::evaluateActionMasks(batch, rules);
+
+    EXPECT_EQ(batch.actionMasks[0] >> earlySurrenderAction & 1, 1);
+    EXPECT_EQ(batch.actionMasks[0] >> lateSurrenderAction & 1, 0);
+    EXPECT_EQ(batch.actionMasks[1] >> earlySurrenderAction & 1, 0);
+
+    // The compiled American rules offer none
+    AbstractBlackjack::evaluateActionMasks(batch);
+
+    EXPECT_EQ(batch.actionMasks[0] >> earlySurrenderAction & 1, 0);
+}
+
+/**
+ * Testing insurance and even money taken before the dealer peeks
+ */
+TEST(AbstractBlackjack, settleInsuranceUnderPeek)
+{
+    ActionMaskBlackjack game;
+    MockInputHandler inputHandler;
+    MockDisplayHandler displayHandler;
+    Application app(game, inputHandler, displayHandler);
+
+    app.createPlayer("Test1", 1000);
+    app.createPlayer("Test2", 1000);
+
+    auto& boxes = game.createBoxes(app.getPlayers(), 2);
+    auto& dealerBox = game.getDealerBox();
+    BlackjackRules rules;
+    u32 winCash = 0;
+
+    Card ace1(CardFace::ace, CardSuit::club);
+    Card ace2(CardFace::ace, CardSuit::heart);
+    Card king1(CardFace::king, CardSuit::spade);
+    Card king2(CardFace::king, CardSuit::diamond);
+    Card ten(10, CardSuit::heart);
+    Card six(6, CardSuit::diamond);
+    Card nine(9, CardSuit::club);
+
+    rules.dealerPeeks = true;
+    game.setRules(rules);
+
+    boxes[0].setBet(100);
+    boxes[0].giveCard(&ten);
+    boxes[0].giveCard(&six);
+    boxes[1].setBet(100);
+    boxes[1].giveCard(&ace2);
+    boxes[1].giveCard(&king2);
+    dealerBox.giveCard(&ace1);
+    dealerBox.giveCard(&king1);
+
+    DecisionBatch batch;
+
+    game.appendToDecisionBatch(batch, boxes[0]);
+
+    AbstractBlackjack::evaluateActionMasks(batch, rules);
+
+    // Check if insurance is offered before the peek and not among the actions played after it
+    EXPECT_TRUE(game.canInsureBox(boxes[0]));
+    EXPECT_TRUE(game.canInsureBox(boxes[1]));
+    EXPECT_EQ(batch.actionMasks[0] >> insuranceAction & 1, 0);
+
+    game.insureBox(boxes[0]);
+    game.insureBox(boxes[1]);
+
+    EXPECT_FALSE(game.canInsureBox(boxes[0]));
+    EXPECT_EQ(boxes[0].getPlayer().getCash(), 850);
+    EXPECT_EQ(boxes[1].getPlayer().getCash(), 850);
+
+    // The insurance pays 2 to 1 and makes up for the lost bet
+    EXPECT_EQ(game.settleHand(&boxes[0], 0, winCash), HandResult::handBlackjackInsured);
+    EXPECT_EQ(boxes[0].getPlayer().getCash(), 1000);
+
+    // An insured blackjack is even money
+    EXPECT_EQ(game.settleHand(&boxes[1], 1, winCash), HandResult::handEvenMoney);
+    EXPECT_EQ(winCash, 100);
+    EXPECT_EQ(boxes[1].getPlayer().getCash(), 1100);
+
+    for (auto& box : boxes)
+    {
+        box.resetBox();
+    }
+
+    dealerBox.resetBox();
+    game.clearInsurances();
+
+    boxes[0].setBet(100);
+    boxes[0].giveCard(&ten);
+    boxes[0].giveCard(&six);
+    boxes[1].setBet(100);
+    boxes[1].giveCard(&ace2);
+    boxes[1].giveCard(&king2);
+    dealerBox.giveCard(&ace1);
+    dealerBox.giveCard(&nine);
+
+    game.insureBox(boxes[0]);
+    game.insureBox(boxes[1]);
+
+    // Without a dealer blackjack the insurances are lost and the original bets play on
+    game.collectInsurances();
+
+    EXPECT_EQ(boxes[0].getBet(), 100);
+    EXPECT_EQ(game.settleHand(&boxes[0], 0, winCash), HandResult::handLose);
+    EXPECT_EQ(boxes[0].getPlayer().getCash(), 850);
+
+    // Blackjack paid 3 to 2 less the insurance is even money as well
+    EXPECT_EQ(game.settleHand(&boxes[1], 1, winCash), HandResult::handBlackjack);
+    EXPECT_EQ(boxes[1].getPlayer().getCash(), 1200);
+
+    // Odd bets are insured with half of them rounded down
+    EXPECT_EQ(AbstractBlackjack::getUninsuredBet(7), 5);
+    EXPECT_EQ(AbstractBlackjack::getUninsuredBet(150), 100);
+}
+
+/**
+ * Testing writeSnapshot() and readSnapshot() methods
+ */
+TEST(AbstractBlackjack, snapshot)
+{
+    MockAbstractBlackjack game;
+    MockInputHandler inputHandler;
+    MockDisplayHandler displayHandler;
+    Application app(game, inputHandler, displayHandler);
+
+    app.createPlayer("Test1", 500);
+    app.createPlayer("Test2", 300);
+
+    game.setRunSeed(42);
+    game.setNextShoeNumber(7);
+    game.createShoe(1);
+    game.shuffleShoe();
+    game.createBoxes(app.getPlayers(), 2);
+    game.getBoxes()[0].setBet(100);
+    game.getBoxes()[1].setBet(50);
+    game.dealCardsToBoxes(2);
+    game.dealCardsToDealer(2);
+    game.addInsuredBoxIndex(1);
+
+    SnapshotWriter writer;
+
+    game.writeSnapshot(writer);
+
+    // Restored into a table without players, as when a game is resumed
+    MockAbstractBlackjack restoredGame;
+    Application restoredApp(restoredGame, inputHandler, displayHandler);
+    SnapshotReader reader(writer.getData());
+
+    restoredGame.readSnapshot(reader);
+
+    EXPECT_TRUE(reader.isFinished());
+    EXPECT_EQ(restoredGame.getRunSeed(), 42);
+    EXPECT_EQ(restoredGame.getShoeNumber(), 7);
+    ASSERT_EQ(restoredApp.getPlayers().size(), 2);
+    EXPECT_EQ(restoredApp.getPlayer(0).getName(), "Test1");
+    EXPECT_EQ(restoredApp.getPlayer(0).getCash(), 400);
+    EXPECT_EQ(restoredApp.getPlayer(1).getCash(), 250);
+    EXPECT_TRUE(restoredGame.hasInsuredBoxIndex(1));
+    EXPECT_FALSE(restoredGame.hasInsuredBoxIndex(0));
+
+    ASSERT_EQ(restoredGame.getBoxes().size(), 2);
+
+    for (u8 boxIndex = 0; boxIndex < 2; boxIndex++)
+    {
+        auto& box = game.getBoxes()[boxIndex];
+        auto& restoredBox = restoredGame.getBoxes()[boxIndex];
+
+        EXPECT_EQ(&restoredBox.getPlayer(), &restoredApp.getPlayer(boxIndex));
+        EXPECT_EQ(restoredBox.getBet(), box.getBet());
+        EXPECT_EQ(restoredBox.getHandCardsValue(), box.getHandCardsValue());
+        EXPECT_TRUE(*restoredBox.getHandCards()[1] == *box.getHandCards()[1]);
+    }
+
+    EXPECT_TRUE(*restoredGame.getDealerCards()[0] == *game.getDealerCards()[0]);
+
+    // Check if the restored table deals on exactly as the original one
+    for (u8 cardNumber = 0; cardNumber < 10; cardNumber++)
+    {
+        EXPECT_TRUE(*restoredGame.getNextCard() == *game.getNextCard());
+    }
+
+    // Check if a truncated snapshot is rejected
+    std::vector<u8> truncated(writer.getData().begin(), writer.getData().end() - 1);
+    SnapshotReader truncatedReader(truncated);
+
+    EXPECT_THROW(restoredGame.readSnapshot(truncatedReader), std::runtime_error);
+}
+
 // Commented because Gmock is fucked up
 //
 //class MockPlayer: public Player
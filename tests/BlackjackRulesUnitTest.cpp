@@ -0,0 +1,111 @@
+#ifndef __BLACKJACK_RULES_UNIT_TEST_CPP_INCLUDED__
+#define __BLACKJACK_RULES_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <sstream>
+#include <stdexcept>
+
+#include "BlackjackRules.h"
+#include "RulesPolicy.h"
+
+/**
+ * Testing read() method
+ */
+TEST(BlackjackRules, read)
+{
+    std::istringstream stream(
+        "# Downtown shoe game\n"
+        "deck_count = 8\n"
+        "dealer_hits_soft_17 = true\n"
+        "\n"
+        "blackjack_payout = 6:5   # short pay\n"
+        "double = 10-11\n"
+        "double_after_split = yes\n"
+        "max_split_hands = 4\n"
+        "resplit_aces = false\n"
+        "surrender = late\n"
+        "dealer_peeks = true\n"
+        "penetration = 0.8\n");
+
+    BlackjackRules rules = BlackjackRules::read(stream);
+
+    EXPECT_EQ(rules.deckCount, 8);
+    EXPECT_TRUE(rules.dealerHitsSoft17);
+    EXPECT_EQ(rules.blackjackPayoutNumerator, 6);
+    EXPECT_EQ(rules.blackjackPayoutDenominator, 5);
+    EXPECT_EQ(rules.doubleRule, DoubleRule::doubleTenToEleven);
+    EXPECT_TRUE(rules.doubleAfterSplit);
+    EXPECT_EQ(rules.maxSplitHands, 4);
+    EXPECT_FALSE(rules.resplitAces);
+    EXPECT_EQ(rules.surrender, SurrenderRule::surrenderLate);
+    EXPECT_TRUE(rules.dealerPeeks);
+    EXPECT_FLOAT_EQ(rules.penetration, 0.8);
+
+    EXPECT_FALSE(rules.isDoubleAllowed(9));
+    EXPECT_TRUE(rules.isDoubleAllowed(10));
+    EXPECT_TRUE(rules.isDoubleAllowed(11));
+
+    // Check if written rules read back the same
+    std::stringstream written;
+
+    rules.write(written);
+
+    EXPECT_TRUE(BlackjackRules::read(written) == rules);
+
+    // Check if an empty file keeps the defaults, which are the compiled American rules
+    std::istringstream empty("");
+
+    EXPECT_TRUE(BlackjackRules::read(empty) == AmericanRules::toRules());
+
+    // Check if a table without a hole card reads as the compiled European rules
+    std::istringstream european("hole_card = false\n");
+
+    EXPECT_TRUE(BlackjackRules::read(european) == EuropeanRules::toRules());
+    EXPECT_NE(EuropeanRules::toRules().getHash(), AmericanRules::toRules().getHash());
+}
+
+/**
+ * Testing read() method with invalid entries
+ */
+TEST(BlackjackRules, readInvalid)
+{
+    const char* invalidFiles[] = {
+        "deck_count = 0\n",
+        "deck_count = six\n",
+        "blackjack_payout = 3\n",
+        "double = 9-10\n",
+        "max_split_hands = 17\n",
+        "surrender = always\n",
+        "dealer_peeks = maybe\n",
+        "penetration = 1.5\n",
+        "dealer_stands_on = 17\n",
+        "dealer_peeks = true\nhole_card = false\n",
+        "dealer_peeks = true\nsurrender = early\n",
+        "deck_count\n"
+    };
+
+    for (auto content : invalidFiles)
+    {
+        std::istringstream stream(content);
+
+        EXPECT_THROW(BlackjackRules::read(stream), std::invalid_argument) << content;
+    }
+
+    // Check if the line of the bad entry is named
+    std::istringstream stream("deck_count = 6\nsurrender = always\n");
+
+    try
+    {
+        BlackjackRules::read(stream);
+
+        FAIL();
+    }
+    catch (const std::invalid_argument& exception)
+    {
+        EXPECT_THAT(exception.what(), ::testing::HasSubstr("line 2"));
+    }
+}
+
+#endif // __BLACKJACK_RULES_UNIT_TEST_CPP_INCLUDED__
\ No newline at end of file
@@ -142,6 +142,34 @@ TEST(Box, getHandCardsValue)
     // Check if cards sum value corresponding expected value
     EXPECT_EQ(box.getHandCardsValue(), 21);
 
+    box.resetBox();
+
+    Card card9(9, CardSuit::club);
+
+    box.giveCard(&card6);
+    box.giveCard(&card6);
+    box.giveCard(&card9);
+
+    // Check if two aces make soft 21 with a nine
+    EXPECT_EQ(box.getHandCardsValue(), 21);
+    EXPECT_TRUE(box.isHandSoft());
+
+    box.giveCard(&card8);
+
+    // Check if the aces turn hard and any bust is valued 22
+    EXPECT_EQ(box.getHandCardsValue(), 17);
+    EXPECT_FALSE(box.isHandSoft());
+
+    box.giveCard(&card3);
+
+    EXPECT_EQ(box.getHandCardsValue(), 22);
+    EXPECT_TRUE(box.hasOvertake());
+
+    // Check if taking the last card back restores the previous value
+    box.removeLastCard();
+
+    EXPECT_EQ(box.getHandCardsValue(), 17);
+
 
 
     // Dealer test case
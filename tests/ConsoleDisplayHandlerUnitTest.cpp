@@ -0,0 +1,176 @@
+#ifndef __CONSOLE_DISPLAY_HANDLER_UNIT_TEST_CPP_INCLUDED__
+#define __CONSOLE_DISPLAY_HANDLER_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ConsoleDisplayHandler.h"
+
+// Publishes into the render queue with no renderer thread, the test takes the frames out itself
+class QueuedConsoleDisplayHandler: public ConsoleDisplayHandler
+{
+public:
+    explicit QueuedConsoleDisplayHandler(RenderBackpressure backpressure)
+        : ConsoleDisplayHandler(false, backpressure)
+    {
+        this->asyncRendering = true;
+    }
+
+    ~QueuedConsoleDisplayHandler()
+    {
+        // Nothing renders the queue, the base destructor must not wait for it
+        this->takeEvents();
+        this->asyncRendering = false;
+    }
+
+    void show(const std::string& text, bool pause)
+    {
+        std::string cache = text;
+
+        this->publish(cache, pause);
+    }
+
+    void fillQueue()
+    {
+        for (u16 index = 0; index < ConsoleDisplayHandler::renderQueueCapacity; index++)
+        {
+            this->show("frame " + std::to_string(index), false);
+        }
+    }
+
+    u16 getQueueSize() const
+    {
+        return this->renderQueue.size();
+    }
+
+    ConsoleRenderEvent takeEvent()
+    {
+        ConsoleRenderEvent event = *this->renderQueue.front();
+
+        this->renderQueue.pop();
+
+        return event;
+    }
+
+    std::vector<ConsoleRenderEvent> takeEvents()
+    {
+        std::vector<ConsoleRenderEvent> events;
+
+        while (!this->renderQueue.empty())
+        {
+            events.push_back(this->takeEvent());
+        }
+
+        return events;
+    }
+};
+
+// Shows a frame against the full queue and frees slots once the frame has had time to get through.
+// Returns true when the frame waited for those slots.
+static bool showBlocked(QueuedConsoleDisplayHandler& displayHandler, const std::string& text, bool pause, u8 slotCount = 1)
+{
+    std::atomic<bool> shown{false};
+    bool blocked = false;
+
+    std::thread renderer([&displayHandler, &shown, &blocked, slotCount]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        blocked = !shown;
+
+        for (u8 slot = 0; slot < slotCount; slot++)
+        {
+            displayHandler.takeEvent();
+        }
+    });
+
+    displayHandler.show(text, pause);
+    shown = true;
+
+    renderer.join();
+
+    return blocked;
+}
+
+/**
+ * Testing RenderBackpressure::block with a full render queue
+ */
+TEST(ConsoleDisplayHandler, block)
+{
+    QueuedConsoleDisplayHandler displayHandler(RenderBackpressure::block);
+
+    displayHandler.fillQueue();
+
+    EXPECT_TRUE(showBlocked(displayHandler, "blocked", false));
+    EXPECT_EQ(displayHandler.getQueueSize(), 64);
+    EXPECT_EQ(displayHandler.getDroppedEventCount(), 0);
+    EXPECT_EQ(displayHandler.takeEvents().back().text, "blocked");
+}
+
+/**
+ * Testing RenderBackpressure::drop with a full render queue
+ */
+TEST(ConsoleDisplayHandler, drop)
+{
+    QueuedConsoleDisplayHandler displayHandler(RenderBackpressure::drop);
+
+    displayHandler.fillQueue();
+    displayHandler.show("dropped", false);
+
+    EXPECT_EQ(displayHandler.getQueueSize(), 64);
+    EXPECT_EQ(displayHandler.getDroppedEventCount(), 1);
+
+    // Check if a frame waiting for the player waits for a slot instead
+    EXPECT_TRUE(showBlocked(displayHandler, "paused", true));
+    EXPECT_EQ(displayHandler.getDroppedEventCount(), 1);
+
+    auto events = displayHandler.takeEvents();
+
+    EXPECT_EQ(events.back().text, "paused");
+    EXPECT_TRUE(events.back().pause);
+    EXPECT_EQ(events[events.size() - 2].text, "frame 63");
+}
+
+/**
+ * Testing RenderBackpressure::coalesce with a full render queue
+ */
+TEST(ConsoleDisplayHandler, coalesce)
+{
+    QueuedConsoleDisplayHandler displayHandler(RenderBackpressure::coalesce);
+
+    displayHandler.fillQueue();
+
+    // The newest pending frame replaces the older one
+    displayHandler.show("replaced", false);
+    displayHandler.show("pending", false);
+
+    EXPECT_EQ(displayHandler.getQueueSize(), 64);
+    EXPECT_EQ(displayHandler.getDroppedEventCount(), 1);
+
+    // A free slot takes the pending frame first, the new one is pending then
+    displayHandler.takeEvent();
+    displayHandler.show("paused", true);
+
+    EXPECT_EQ(displayHandler.getDroppedEventCount(), 1);
+
+    // Check if a frame is not coalesced into a pending frame that pauses, but waits for it to get through
+    EXPECT_TRUE(showBlocked(displayHandler, "after pause", false, 2));
+    EXPECT_EQ(displayHandler.getDroppedEventCount(), 1);
+
+    auto events = displayHandler.takeEvents();
+
+    ASSERT_EQ(events.size(), 64);
+    EXPECT_EQ(events[61].text, "pending");
+    EXPECT_FALSE(events[61].pause);
+    EXPECT_EQ(events[62].text, "paused");
+    EXPECT_TRUE(events[62].pause);
+    EXPECT_EQ(events[63].text, "after pause");
+    EXPECT_FALSE(events[63].pause);
+}
+
+#endif // __CONSOLE_DISPLAY_HANDLER_UNIT_TEST_CPP_INCLUDED__
\ No newline at end of file
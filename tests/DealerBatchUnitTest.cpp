@@ -0,0 +1,194 @@
+#ifndef __DEALER_BATCH_UNIT_TEST_CPP_INCLUDED__
+#define __DEALER_BATCH_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <vector>
+
+#include "MockAbstractBlackjack.h"
+#include "DealerBatch.h"
+#include "HandState.h"
+
+class DealerBatchBlackjack: public MockAbstractBlackjack
+{
+public:
+    std::vector<Player> players;
+
+    DealerBatchBlackjack()
+    {
+        this->createBoxes(this->players, 0);
+    }
+
+    const std::vector<Card>& getShoe() const
+    {
+        return this->shoe;
+    }
+
+    u16 getShoeIndex() const
+    {
+        return this->shoeIndex;
+    }
+};
+
+// Dealer hands played by AbstractBlackjack::drawDealerCards(), with the lanes the kernels get for them
+struct DealerBatchReference
+{
+    DealerBatch batch;
+
+    std::vector<u8> drawCounts;
+
+    std::vector<u8> states;
+};
+
+static void fillReference(DealerBatchReference& reference, bool hitsSoft17, u8 initialCardCount, u16 laneCount)
+{
+    DealerBatchBlackjack blackjack;
+    BlackjackRules rules;
+
+    rules.dealerHitsSoft17 = hitsSoft17;
+    blackjack.setRules(rules);
+    blackjack.setRunSeed(42);
+    blackjack.createShoe(6);
+    blackjack.shuffleShoe();
+
+    while (reference.batch.size() < laneCount)
+    {
+        if (blackjack.getShoeIndex() > 250)
+        {
+            blackjack.createShoe(6);
+            blackjack.shuffleShoe();
+        }
+
+        Box& dealerBox = blackjack.getDealerBox();
+        std::vector<u8> ranks;
+
+        blackjack.dealCardsToDealer(initialCardCount);
+
+        for (u16 index = blackjack.getShoeIndex(); index < blackjack.getShoe().size(); index++)
+        {
+            Card card = blackjack.getShoe()[index];
+
+            ranks.push_back(HandState::getRank(card.getCardValue()));
+        }
+
+        reference.batch.appendLane(dealerBox.getHandState(), ranks.data(), ranks.size());
+
+        u16 shoeIndex = blackjack.getShoeIndex();
+
+        blackjack.drawDealerCards();
+
+        reference.drawCounts.push_back(blackjack.getShoeIndex() - shoeIndex);
+        reference.states.push_back(dealerBox.getHandState());
+
+        dealerBox.resetBox();
+    }
+}
+
+static void assertKernelsMatch(bool hitsSoft17, u8 initialCardCount)
+{
+    // Not a multiple of any vector width, the last lanes go through the scalar loop
+    DealerBatchReference reference;
+
+    fillReference(reference, hitsSoft17, initialCardCount, 5003);
+
+    for (auto kernel : {DealerKernel::dealerKernelScalar, DealerKernel::dealerKernelAvx2, DealerKernel::dealerKernelAvx512})
+    {
+        if (!DealerBatch::isKernelSupported(kernel))
+        {
+            continue;
+        }
+
+        DealerBatch batch = reference.batch;
+
+        DealerBatch::drawOut(batch, hitsSoft17, kernel);
+
+        for (u16 lane = 0; lane < batch.size(); lane++)
+        {
+            ASSERT_EQ(batch.getDrawCount(lane), reference.drawCounts[lane]) << "kernel " << kernel << ", lane " << lane;
+            ASSERT_EQ(batch.getState(lane), reference.states[lane]) << "kernel " << kernel << ", lane " << lane;
+        }
+    }
+}
+
+TEST(DealerBatchTest, kernelsMatchDealerStandingOnSoft17)
+{
+    assertKernelsMatch(false, 2);
+}
+
+TEST(DealerBatchTest, kernelsMatchDealerHittingSoft17)
+{
+    assertKernelsMatch(true, 2);
+}
+
+TEST(DealerBatchTest, kernelsMatchDealerWithoutHoleCard)
+{
+    assertKernelsMatch(false, 1);
+}
+
+TEST(DealerBatchTest, vectorKernelsMatchScalarKernel)
+{
+    for (bool hitsSoft17 : {false, true})
+    {
+        // Every lane count up to two AVX-512 vectors, so each vector width ends on a scalar tail of every length
+        DealerBatchReference reference;
+
+        fillReference(reference, hitsSoft17, 2, 33);
+
+        for (u16 laneCount = 1; laneCount <= reference.batch.size(); laneCount++)
+        {
+            DealerBatch scalarBatch;
+
+            for (u16 lane = 0; lane < laneCount; lane++)
+            {
+                u8 ranks[DealerBatch::maxDrawCount];
+
+                for (u8 index = 0; index < DealerBatch::maxDrawCount; index++)
+                {
+                    ranks[index] = (lane * 7 + index * 3) % HandState::rankCount;
+                }
+
+                scalarBatch.appendLane(reference.batch.getState(lane), ranks, DealerBatch::maxDrawCount);
+            }
+
+            DealerBatch initialBatch = scalarBatch;
+
+            DealerBatch::drawOut(scalarBatch, hitsSoft17, DealerKernel::dealerKernelScalar);
+
+            for (auto kernel : {DealerKernel::dealerKernelAvx2, DealerKernel::dealerKernelAvx512})
+            {
+                if (!DealerBatch::isKernelSupported(kernel))
+                {
+                    continue;
+                }
+
+                DealerBatch batch = initialBatch;
+
+                DealerBatch::drawOut(batch, hitsSoft17, kernel);
+
+                for (u16 lane = 0; lane < laneCount; lane++)
+                {
+                    ASSERT_EQ(batch.getDrawCount(lane), scalarBatch.getDrawCount(lane))
+                        << "kernel " << kernel << ", " << laneCount << " lanes, lane " << lane;
+                    ASSERT_EQ(batch.getState(lane), scalarBatch.getState(lane))
+                        << "kernel " << kernel << ", " << laneCount << " lanes, lane " << lane;
+                }
+            }
+        }
+    }
+}
+
+TEST(DealerBatchTest, shortShoeIsPaddedWithTens)
+{
+    DealerBatch batch;
+    u8 twos[] = {0, 0};
+
+    // Two 2s after a single 2 leave the dealer on 6, two 10s from the padding then bust the hand
+    batch.appendLane(HandState::getNext(HandState::empty, 0), twos, 2);
+    DealerBatch::drawOut(batch, false);
+
+    ASSERT_EQ(batch.getDrawCount(0), 4);
+    ASSERT_EQ(batch.getState(0), HandState::bust);
+}
+
+#endif
\ No newline at end of file
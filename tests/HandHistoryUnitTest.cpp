@@ -0,0 +1,127 @@
+#ifndef __HAND_HISTORY_UNIT_TEST_CPP_INCLUDED__
+#define __HAND_HISTORY_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include "HandHistoryReader.h"
+#include "HandHistoryWriter.h"
+
+/**
+ * Testing encodeCard() and decodeCard() methods
+ */
+TEST(HandHistory, cardCoding)
+{
+    Card ace(CardFace::ace, CardSuit::spade);
+    Card two(2, CardSuit::club);
+
+    EXPECT_TRUE(HandHistoryRecord::decodeCard(HandHistoryRecord::encodeCard(ace)) == ace);
+    EXPECT_TRUE(HandHistoryRecord::decodeCard(HandHistoryRecord::encodeCard(two)) == two);
+}
+
+/**
+ * Testing HandHistoryWriter and HandHistoryReader round trip
+ */
+TEST(HandHistory, writeRead)
+{
+    const std::string path = "hand_history_unit_test.bin";
+
+    std::remove(path.c_str());
+
+    HandHistoryRound round;
+
+    round.seed = 0x123456789ABCDEF0;
+    round.shoeNumber = 42;
+    round.shoeIndex = 117;
+    round.insuredBoxMask = 2;
+    round.initialBets = {10, 20};
+    round.actions = {{0, 1, 0}, {0, 1, 1}, {1, 1, 3}, {0, 1, handHistoryInsuranceCollected}, {1, 2, 1}};
+    round.dealerCards = {0x4E, 0x1A};
+
+    HandHistoryHand firstHand;
+
+    firstHand.boxIndex = 0;
+    firstHand.handNumber = 1;
+    firstHand.result = 1;
+    firstHand.bet = 10;
+    firstHand.payout = 0;
+    firstHand.cards = {0x12, 0x23, 0x3D};
+
+    HandHistoryHand secondHand;
+
+    secondHand.boxIndex = 1;
+    secondHand.handNumber = 1;
+    secondHand.result = 3;
+    secondHand.bet = 20;
+    secondHand.payout = 40;
+    secondHand.cards = {0x1A, 0x2A};
+
+    round.hands = {firstHand, secondHand};
+
+    BlackjackRules rules;
+
+    rules.deckCount = 2;
+    rules.blackjackPayoutNumerator = 6;
+    rules.blackjackPayoutDenominator = 5;
+
+    // Two writers on the same path append to one log
+    {
+        HandHistoryWriter writer(path, rules);
+
+        writer.write(round);
+
+        EXPECT_EQ(writer.getRecordCount(), 1);
+    }
+
+    round.shoeIndex = 130;
+
+    {
+        HandHistoryWriter writer(path, rules);
+
+        writer.write(round);
+    }
+
+    // Check if rounds of other rules are not appended to the log
+    EXPECT_THROW(HandHistoryWriter(path, BlackjackRules()), std::runtime_error);
+
+    HandHistoryReader reader(path);
+    HandHistoryRecord record;
+    HandHistoryRound decoded;
+
+    EXPECT_TRUE(reader.getRules() == rules);
+
+    ASSERT_TRUE(reader.next(record));
+
+    // Check if the record fits in a few dozen bytes and is read in place
+    EXPECT_EQ(record.getSize(), HandHistoryRecord::headerSize + 2 * 4 + 2 + 5 * 2 + 2 * HandHistoryRecord::handHeaderSize + 5);
+    EXPECT_EQ(record.getSeed(), 0x123456789ABCDEF0);
+    EXPECT_EQ(record.getShoeNumber(), 42);
+    EXPECT_EQ(record.getShoeIndex(), 117);
+    EXPECT_EQ(record.getInsuredBoxMask(), 2);
+    EXPECT_EQ(record.getInitialBet(1), 20);
+    EXPECT_EQ(record.getDealerCard(0), 0x4E);
+    EXPECT_EQ(record.getAction(3).action, handHistoryInsuranceCollected);
+    EXPECT_EQ(record.getAction(4).handNumber, 2);
+    EXPECT_EQ(record.getTotalBet(), 30);
+    EXPECT_EQ(record.getTotalPayout(), 40);
+
+    record.decode(decoded);
+
+    EXPECT_TRUE(decoded.actions == round.actions);
+    EXPECT_EQ(decoded.hands.size(), 2);
+    EXPECT_EQ(decoded.hands[0].cards, firstHand.cards);
+    EXPECT_EQ(decoded.hands[1].payout, 40);
+    EXPECT_EQ(decoded.hands[1].result, 3);
+
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.getShoeIndex(), 130);
+    EXPECT_FALSE(reader.next(record));
+
+    std::remove(path.c_str());
+}
+
+#endif // __HAND_HISTORY_UNIT_TEST_CPP_INCLUDED__
\ No newline at end of file
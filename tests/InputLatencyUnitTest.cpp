@@ -0,0 +1,82 @@
+#ifndef __INPUT_LATENCY_UNIT_TEST_CPP_INCLUDED__
+#define __INPUT_LATENCY_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <sstream>
+#include <string>
+
+#include "InputLatencyHistogram.h"
+#include "InputLatencyRecorder.h"
+
+/**
+ * Testing record() and getValueAtPercentile() methods
+ */
+TEST(InputLatencyHistogram, percentiles)
+{
+    InputLatencyHistogram histogram;
+
+    // Check if an empty histogram reports zeros
+    EXPECT_EQ(histogram.getCount(), 0);
+    EXPECT_EQ(histogram.getValueAtPercentile(50), 0);
+
+    // Check if small values are exact
+    for (u64 value = 0; value < 10; value++)
+    {
+        histogram.record(value);
+    }
+
+    EXPECT_EQ(histogram.getValueAtPercentile(50), 4);
+    EXPECT_EQ(histogram.getValueAtPercentile(100), 9);
+
+    // Check if large values stay within 1/16 of themselves
+    histogram.reset();
+
+    for (u64 value = 1; value <= 1000; value++)
+    {
+        histogram.record(value * 1000000);
+    }
+
+    for (f64 percent : {10.0, 50.0, 90.0, 99.0})
+    {
+        f64 expectedValue = percent * 10 * 1000000;
+
+        EXPECT_NEAR(histogram.getValueAtPercentile(percent), expectedValue, expectedValue / 16);
+    }
+
+    EXPECT_EQ(histogram.getValueAtPercentile(100), 1000000000);
+    EXPECT_EQ(histogram.getMax(), 1000000000);
+    EXPECT_DOUBLE_EQ(histogram.getMean(), 500500000.0);
+
+    // Check if values beyond the range are clamped
+    histogram.record((u64) 1 << 50);
+
+    EXPECT_EQ(histogram.getMax(), InputLatencyHistogram::maxValue);
+    EXPECT_EQ(histogram.getValueAtPercentile(100), InputLatencyHistogram::maxValue);
+}
+
+/**
+ * Testing record() and printSummary() methods
+ */
+TEST(InputLatencyRecorder, summary)
+{
+    InputLatencyRecorder& recorder = InputLatencyRecorder::getInstance();
+
+    recorder.reset();
+    recorder.record(InputKind::inputBet, InputPhase::inputPhaseWait, 2000000);
+    recorder.record(InputKind::inputBet, InputPhase::inputPhaseRetries, 1);
+
+    EXPECT_EQ(recorder.getHistogram(InputKind::inputBet, InputPhase::inputPhaseWait).getCount(), 1);
+
+    // Check if only the requested kinds are listed
+    std::ostringstream output;
+    recorder.printSummary(output);
+    std::string text = output.str();
+
+    EXPECT_NE(text.find("bet         | wait       |        1 |    2.000"), std::string::npos);
+    EXPECT_NE(text.find("bet         | retries    |        1 |    1.000"), std::string::npos);
+    EXPECT_EQ(text.find("action"), std::string::npos);
+}
+
+#endif
\ No newline at end of file
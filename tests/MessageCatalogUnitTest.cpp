@@ -0,0 +1,142 @@
+#ifndef __MESSAGE_CATALOG_UNIT_TEST_CPP_INCLUDED__
+#define __MESSAGE_CATALOG_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "Application.h"
+#include "MessageCatalog.h"
+
+#include "MockAbstractBlackjack.h"
+#include "MockDisplayHandler.h"
+#include "MockInputHandler.h"
+
+static const char* const catalogSource =
+    "# Two locales\n"
+    "[en]\n"
+    "mes_id_info_option_name line = {number}. {option}\n"
+    "mes_id_info_choose_option inline = Choose {optionName}:\n"
+    "mes_id_info_game_result_win pause = Player {name} win!\n"
+    "\n"
+    "[de]\n"
+    "mes_id_info_game_result_win pause = Spieler {name} gewinnt!\n"
+    "mes_id_info_option_name line = {number}) {option}\n"
+    "mes_id_info_choose_option inline = {optionName} wählen:\n";
+
+static std::unique_ptr<MessageCatalog> compileCatalog(const std::string& source)
+{
+    std::istringstream stream(source);
+
+    return MessageCatalog::compileToMemory(stream);
+}
+
+/**
+ * Testing MessageCatalog::compile() method and the lookups
+ */
+TEST(MessageCatalog, compile)
+{
+    auto catalog = compileCatalog(catalogSource);
+
+    ASSERT_EQ(catalog->getLocaleCount(), 2);
+    ASSERT_EQ(catalog->getMessageCount(), 3);
+
+    EXPECT_EQ(catalog->findLocale("en"), 0);
+    EXPECT_EQ(catalog->findLocale("de"), 1);
+    EXPECT_EQ(catalog->findLocale("fr"), -1);
+    EXPECT_EQ(catalog->getLocaleName(1), "de");
+
+    // Ids are sorted, the templates of every locale follow them whatever order they were written in
+    s32 winIndex = catalog->findMessage("mes_id_info_game_result_win");
+    s32 optionIndex = catalog->findMessage("mes_id_info_option_name");
+
+    ASSERT_GE(winIndex, 0);
+    ASSERT_GE(optionIndex, 0);
+    EXPECT_EQ(catalog->findMessage("mes_id_unknown"), -1);
+    EXPECT_EQ(catalog->getMessageId(winIndex), "mes_id_info_game_result_win");
+    EXPECT_LT(catalog->getMessageId(0), catalog->getMessageId(1));
+    EXPECT_LT(catalog->getMessageId(1), catalog->getMessageId(2));
+
+    EXPECT_EQ(catalog->getTemplate(0, winIndex), "Player {name} win!");
+    EXPECT_EQ(catalog->getTemplate(1, winIndex), "Spieler {name} gewinnt!");
+    EXPECT_EQ(catalog->getTemplate(1, optionIndex), "{number}) {option}");
+    EXPECT_EQ(catalog->getLayout(0, winIndex), MessageLayout::messagePause);
+    EXPECT_EQ(catalog->getLayout(0, optionIndex), MessageLayout::messageLine);
+    EXPECT_EQ(catalog->getLayout(1, catalog->findMessage("mes_id_info_choose_option")), MessageLayout::messageInline);
+
+    // Check if broken catalogs are rejected
+    EXPECT_THROW(compileCatalog("mes_id_info_option_name line = {number}\n"), std::invalid_argument);
+    EXPECT_THROW(compileCatalog("[en]\nmes_id_info_option_name bold = {number}\n"), std::invalid_argument);
+    EXPECT_THROW(compileCatalog("[en]\nmes_id_info_option_name = {number}\n"), std::invalid_argument);
+    EXPECT_THROW(compileCatalog("[en]\nmes_id_a line = a\nmes_id_a line = b\n"), std::invalid_argument);
+    EXPECT_THROW(compileCatalog("[en]\nmes_id_a line = a\n[de]\nmes_id_b line = b\n"), std::invalid_argument);
+    EXPECT_THROW(compileCatalog("# nothing\n"), std::invalid_argument);
+}
+
+/**
+ * Testing MessageCatalog::write() and the mapping of a compiled catalog
+ */
+TEST(MessageCatalog, file)
+{
+    std::string path = "message-catalog-test.bjmc";
+    std::istringstream source(catalogSource);
+
+    MessageCatalog::write(path, MessageCatalog::compile(source));
+
+    {
+        auto catalog = MessageCatalog::open(path);
+
+        EXPECT_EQ(catalog->getLocaleCount(), 2);
+        EXPECT_EQ(catalog->getTemplate(1, catalog->findMessage("mes_id_info_game_result_win")), "Spieler {name} gewinnt!");
+    }
+
+    // Check if a file cut short is rejected
+    std::istringstream truncatedSource(catalogSource);
+    std::vector<u8> compiledData = MessageCatalog::compile(truncatedSource);
+
+    compiledData.resize(compiledData.size() - 4);
+    MessageCatalog::write(path, compiledData);
+
+    EXPECT_THROW(MessageCatalog{path}, std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+/**
+ * Testing Application::setLocale() method with the messages of a catalog
+ */
+TEST(MessageCatalog, applicationLocale)
+{
+    MockAbstractBlackjack game;
+    MockInputHandler inputHandler;
+    MockDisplayHandler displayHandler;
+    Application app(game, inputHandler, displayHandler);
+    auto catalog = compileCatalog(catalogSource);
+
+    std::vector<std::vector<ADisplayMessageParam*>> messageParamList = {{
+        new ADisplayMessageParam("id", "mes_id_info_game_result_win"),
+        new ADisplayMessageParam("name", "Test1")
+    }};
+
+    app.addMessageEntity("mes_id_info_shoe_is_reassembled", new ADisplayEntity("Shoe has been reassembled."));
+    app.setMessageCatalog(catalog.get());
+
+    EXPECT_EQ(app.renderMessages(messageParamList), "Player Test1 win!\n");
+
+    app.setLocale("de");
+
+    EXPECT_EQ(app.renderMessages(messageParamList), "Spieler Test1 gewinnt!\n");
+    EXPECT_THROW(app.setLocale("fr"), std::invalid_argument);
+
+    // Messages the catalog lacks come from the added entities
+    EXPECT_EQ(app.getMessageEntity("mes_id_info_shoe_is_reassembled")->getDisplayEntity(), "Shoe has been reassembled.");
+    EXPECT_THROW(app.getMessageEntity("mes_id_unknown"), std::out_of_range);
+
+    AbstractBlackjack::clearMessageParamList(messageParamList);
+}
+
+#endif // __MESSAGE_CATALOG_UNIT_TEST_CPP_INCLUDED__
\ No newline at end of file
@@ -0,0 +1,100 @@
+#ifndef __METRICS_UNIT_TEST_CPP_INCLUDED__
+#define __METRICS_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "MetricsRegistry.h"
+#include "MetricsServer.h"
+
+/**
+ * Testing increment(), observe() and writePrometheus() methods
+ */
+TEST(MetricsRegistry, recordFromThreads)
+{
+    MetricsRegistry& metrics = MetricsRegistry::getInstance();
+
+    u64 roundCount = metrics.getCounter(MetricCounter::metricRounds);
+    u64 latencyCount = metrics.getHistogramCount(MetricHistogram::metricDecisionLatency);
+
+    // Check if the shards of every thread are summed up
+    std::thread first([&metrics]() {
+        for (u32 index = 0; index < 1000; index++)
+        {
+            metrics.increment(MetricCounter::metricRounds);
+        }
+    });
+    std::thread second([&metrics]() {
+        metrics.increment(MetricCounter::metricRounds, 500);
+        metrics.observe(MetricHistogram::metricDecisionLatency, 3000);
+    });
+
+    first.join();
+    second.join();
+
+    metrics.observe(MetricHistogram::metricDecisionLatency, 100);
+
+    EXPECT_EQ(metrics.getCounter(MetricCounter::metricRounds), roundCount + 1500);
+    EXPECT_EQ(metrics.getHistogramCount(MetricHistogram::metricDecisionLatency), latencyCount + 2);
+
+    // Check if the text exposition has every metric and cumulative buckets
+    std::ostringstream output;
+    metrics.writePrometheus(output);
+    std::string text = output.str();
+
+    EXPECT_NE(text.find("# TYPE bj2020_rounds_total counter\nbj2020_rounds_total " + std::to_string(roundCount + 1500) + "\n"), std::string::npos);
+    EXPECT_NE(text.find("bj2020_eliminated_players_total "), std::string::npos);
+    EXPECT_NE(text.find("# TYPE bj2020_decision_latency_seconds histogram\n"), std::string::npos);
+    EXPECT_NE(text.find("bj2020_decision_latency_seconds_bucket{le=\"1.024e-06\"} " + std::to_string(latencyCount + 1) + "\n"), std::string::npos);
+    EXPECT_NE(text.find("bj2020_decision_latency_seconds_bucket{le=\"4.096e-06\"} " + std::to_string(latencyCount + 2) + "\n"), std::string::npos);
+    EXPECT_NE(text.find("bj2020_decision_latency_seconds_bucket{le=\"+Inf\"} " + std::to_string(latencyCount + 2) + "\n"), std::string::npos);
+    EXPECT_NE(text.find("bj2020_round_duration_seconds_count "), std::string::npos);
+}
+
+/**
+ * Testing start(), getPort() and stop() methods
+ */
+TEST(MetricsServer, scrape)
+{
+    MetricsRegistry::getInstance().increment(MetricCounter::metricSplits);
+
+    MetricsServer server(0);
+    server.start();
+
+    // Check if a scrape of /metrics gets the registry
+    int clientSocket = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(server.getPort());
+
+    ASSERT_EQ(connect(clientSocket, (sockaddr*) &address, sizeof(address)), 0);
+
+    std::string request = "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    send(clientSocket, request.data(), request.size(), 0);
+
+    std::string response;
+    char buffer[1024];
+
+    for (ssize_t readSize; (readSize = recv(clientSocket, buffer, sizeof(buffer), 0)) > 0;)
+    {
+        response.append(buffer, readSize);
+    }
+
+    close(clientSocket);
+    server.stop();
+
+    EXPECT_EQ(response.compare(0, 15, "HTTP/1.1 200 OK"), 0);
+    EXPECT_NE(response.find("bj2020_splits_total "), std::string::npos);
+}
+
+#endif
\ No newline at end of file
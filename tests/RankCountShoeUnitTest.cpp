@@ -0,0 +1,124 @@
+#ifndef __RANK_COUNT_SHOE_UNIT_TEST_CPP_INCLUDED__
+#define __RANK_COUNT_SHOE_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <stdexcept>
+
+#include "MockAbstractBlackjack.h"
+#include "RankCountShoe.h"
+#include "HandState.h"
+
+TEST(RankCountShoeTest, drawsEveryCardOfTheShoe)
+{
+    RankCountShoe shoe;
+    u16 drawnCounts[HandState::rankCount] = {};
+
+    shoe.reset(6, false, 42, 0);
+
+    ASSERT_EQ(shoe.getRemainingCount(), 312);
+    ASSERT_EQ(shoe.getRankCount(8), 96);
+    ASSERT_EQ(shoe.getRankCount(HandState::aceRank), 24);
+
+    for (u16 index = 0; index < 312; index++)
+    {
+        drawnCounts[shoe.drawRank()]++;
+    }
+
+    for (u8 rank = 0; rank < HandState::rankCount; rank++)
+    {
+        ASSERT_EQ(drawnCounts[rank], rank == 8 ? 96 : 24);
+        ASSERT_EQ(shoe.getRankCount(rank), 0);
+    }
+
+    ASSERT_EQ(shoe.getRemainingCount(), 0);
+    ASSERT_THROW(shoe.drawRank(), std::out_of_range);
+}
+
+TEST(RankCountShoeTest, streamIsReproducible)
+{
+    RankCountShoe shoe;
+    RankCountShoe sameShoe;
+    RankCountShoe otherShoe;
+    u16 differenceCount = 0;
+
+    shoe.reset(1, false, 42, 7);
+    sameShoe.reset(1, false, 42, 7);
+    otherShoe.reset(1, false, 42, 8);
+
+    for (u8 index = 0; index < 52; index++)
+    {
+        u8 rank = shoe.drawRank();
+
+        ASSERT_EQ(rank, sameShoe.drawRank());
+        differenceCount += rank != otherShoe.drawRank();
+    }
+
+    ASSERT_GT(differenceCount, 0);
+}
+
+TEST(RankCountShoeTest, infiniteDeckKeepsItsProbabilities)
+{
+    RankCountShoe shoe;
+    u32 drawnCounts[HandState::rankCount] = {};
+    u32 drawCount = 1300000;
+
+    shoe.reset(1, true, 42, 0);
+
+    // Far more cards than the deck has, the counters never run down
+    for (u32 index = 0; index < drawCount; index++)
+    {
+        drawnCounts[shoe.drawRank()]++;
+    }
+
+    ASSERT_TRUE(shoe.isInfiniteDeck());
+    ASSERT_EQ(shoe.getRemainingCount(), 52);
+
+    for (u8 rank = 0; rank < HandState::rankCount; rank++)
+    {
+        // 1/13 or 4/13 of the draws, within about five standard deviations
+        u32 expected = rank == 8 ? 400000 : 100000;
+
+        ASSERT_NEAR(drawnCounts[rank], expected, rank == 8 ? 2700 : 1500);
+    }
+}
+
+TEST(RankCountShoeTest, rankCardsHaveTheRankValue)
+{
+    for (u8 rank = 0; rank < HandState::rankCount; rank++)
+    {
+        Card card = RankCountShoe::getRankCard(rank);
+
+        ASSERT_EQ(HandState::getRank(card.getCardValue()), rank);
+    }
+}
+
+TEST(RankCountShoeTest, blackjackDealsFromRankCounts)
+{
+    MockAbstractBlackjack blackjack;
+    u16 tenCount = 0;
+
+    blackjack.setShoeMode(ShoeMode::shoeRankCounts);
+    blackjack.setRunSeed(42);
+
+    std::vector<Card>& shoe = blackjack.createShoe(2);
+
+    ASSERT_EQ(shoe.size(), 104);
+
+    blackjack.shuffleShoe();
+
+    for (u8 index = 0; index < 104; index++)
+    {
+        Card* card = blackjack.getNextCard();
+
+        // Dealt cards stay in place, boxes keep pointing at them
+        ASSERT_EQ(card, &shoe[index]);
+        tenCount += card->getCardValue() == 10;
+    }
+
+    ASSERT_EQ(tenCount, 32);
+    ASSERT_THROW(blackjack.getNextCard(), std::out_of_range);
+}
+
+#endif
\ No newline at end of file
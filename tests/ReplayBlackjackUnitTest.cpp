@@ -0,0 +1,187 @@
+#ifndef __REPLAY_BLACKJACK_UNIT_TEST_CPP_INCLUDED__
+#define __REPLAY_BLACKJACK_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <cstdio>
+#include <string>
+
+#include "BasicStrategy.h"
+#include "HandHistoryReader.h"
+#include "HandHistoryWriter.h"
+#include "ReplayBlackjack.h"
+#include "SimulationBlackjack.h"
+#include "StrategyTable.h"
+
+// Late surrender under a hole card check, so that the bots surrender, split, double and are offered insurance
+static BlackjackRules getReplayRules()
+{
+    BlackjackRules rules;
+
+    rules.dealerHitsSoft17 = true;
+    rules.doubleAfterSplit = true;
+    rules.surrender = SurrenderRule::surrenderLate;
+    rules.dealerPeeks = true;
+
+    return rules;
+}
+
+// Plays simulated rounds into a hand history log, the bots take every insurance and even money they are offered
+static void recordRounds(const std::string& path, const BlackjackRules& rules, u64 roundCount)
+{
+    StrategyTableData data;
+
+    StrategyTableBuilder(rules).build(data);
+
+    BasicStrategy strategy(data);
+    HandHistoryWriter writer(path, rules);
+    SimulationBlackjack table(5, 10);
+    DecisionBatch batch;
+
+    table.setRules(rules);
+    table.setRunSeed(7);
+    table.setHandHistoryWriter(&writer);
+    table.prepareGame();
+
+    for (u64 roundNumber = 0; roundNumber < roundCount; roundNumber++)
+    {
+        if (table.needsNewShoe())
+        {
+            table.startShoe();
+        }
+
+        table.beginRound();
+
+        bool isInsured = false;
+
+        for (auto& box : table.getBoxes())
+        {
+            if (table.canInsureBox(box))
+            {
+                table.insureBox(box);
+                isInsured = true;
+            }
+        }
+
+        if (isInsured && !table.getDealerBox().hasBlackjack())
+        {
+            table.collectInsurances();
+        }
+
+        while (true)
+        {
+            batch.clear();
+
+            table.appendPendingHands(batch);
+
+            if (batch.size() == 0)
+            {
+                break;
+            }
+
+            AbstractBlackjack::evaluateActionMasks(batch, rules);
+            strategy.decideBatch(batch);
+
+            table.applyDecisions(batch, 0, batch.size());
+        }
+
+        table.finishRound();
+    }
+}
+
+// Counts the recorded actions of the given type
+static u64 countActions(const std::string& path, u8 actionType)
+{
+    HandHistoryReader reader(path);
+    HandHistoryRecord record;
+    u64 actionCount = 0;
+
+    while (reader.next(record))
+    {
+        for (u8 index = 0; index < record.getActionCount(); index++)
+        {
+            actionCount += record.getAction(index).action == actionType;
+        }
+    }
+
+    return actionCount;
+}
+
+/**
+ * Testing replay of simulated rounds with splits, doubles, insurance and surrender
+ */
+TEST(ReplayBlackjack, replaySimulatedRounds)
+{
+    const std::string path = "replay_blackjack_unit_test.bin";
+
+    std::remove(path.c_str());
+
+    recordRounds(path, getReplayRules(), 2000);
+
+    EXPECT_GT(countActions(path, splitAction), 0);
+    EXPECT_GT(countActions(path, doubleAction), 0);
+    EXPECT_GT(countActions(path, insuranceAction), 0);
+    EXPECT_GT(countActions(path, lateSurrenderAction), 0);
+
+    HandHistoryReader reader(path);
+    ReplayBlackjack replay;
+
+    replay.setRules(reader.getRules());
+    replay.replay(reader);
+
+    EXPECT_EQ(replay.getRoundCount(), 2000);
+    EXPECT_EQ(replay.getMismatchCount(), 0);
+
+    std::remove(path.c_str());
+}
+
+/**
+ * Testing replay of a log with one corrupted payout
+ */
+TEST(ReplayBlackjack, replayCorruptedPayout)
+{
+    const std::string path = "replay_blackjack_unit_test.bin";
+    const std::string corruptedPath = "replay_blackjack_unit_test_corrupted.bin";
+
+    std::remove(path.c_str());
+    std::remove(corruptedPath.c_str());
+
+    recordRounds(path, getReplayRules(), 200);
+
+    // The records are copied over with one chip more paid on the first hand of the hundredth round
+    {
+        HandHistoryReader reader(path);
+        HandHistoryWriter writer(corruptedPath, reader.getRules());
+        HandHistoryRecord record;
+        HandHistoryRound round;
+
+        while (reader.next(record))
+        {
+            record.decode(round);
+
+            if (writer.getRecordCount() == 99)
+            {
+                round.hands[0].payout++;
+            }
+
+            writer.write(round);
+        }
+    }
+
+    HandHistoryReader reader(corruptedPath);
+    ReplayBlackjack replay;
+
+    replay.setRules(reader.getRules());
+    replay.replay(reader);
+
+    EXPECT_EQ(replay.getRoundCount(), 200);
+    EXPECT_EQ(replay.getMismatchCount(), 1);
+    ASSERT_EQ(replay.getMismatches().size(), 1);
+    EXPECT_THAT(replay.getMismatches()[0], ::testing::StartsWith("Round 100: hand 0/1 pays"));
+
+    std::remove(path.c_str());
+    std::remove(corruptedPath.c_str());
+}
+
+#endif // __REPLAY_BLACKJACK_UNIT_TEST_CPP_INCLUDED__
\ No newline at end of file
@@ -0,0 +1,260 @@
+#ifndef __SHUFFLE_QUALITY_UNIT_TEST_CPP_INCLUDED__
+#define __SHUFFLE_QUALITY_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "MockAbstractBlackjack.h"
+#include "PhiloxRng.h"
+#include "Card.h"
+
+// Statistical checks of AbstractBlackjack::shuffleShoe(). The run seed is fixed, so every run sees the same
+// shoes and a pass or fail is reproducible; BJ2020_SHUFFLE_COUNT scales the number of shuffles.
+
+class ShuffleQualityBlackjack: public MockAbstractBlackjack
+{
+public:
+    void setShoe(const std::vector<Card>& cards)
+    {
+        this->shoe = cards;
+        this->shoeIndex = 0;
+    }
+};
+
+static u64 getShuffleCount(u64 defaultCount)
+{
+    const char* scale = std::getenv("BJ2020_SHUFFLE_COUNT");
+
+    return scale ? defaultCount * std::strtoull(scale, nullptr, 10) / 1000000 : defaultCount;
+}
+
+// Wilson-Hilferty approximation of the chi-square quantile, z = 4.75 leaves about one in a million
+static f64 getChiSquareLimit(u64 degreesOfFreedom, f64 z = 4.75)
+{
+    f64 term = 2.0 / (9.0 * degreesOfFreedom);
+
+    return degreesOfFreedom * std::pow(1.0 - term + z * std::sqrt(term), 3);
+}
+
+// Index of the card in a fresh single-deck shoe
+static u8 getCardIndex(const Card& card)
+{
+    return (card.getCardSuit() - 1) * 13 + card.getCardNumber() - 2;
+}
+
+// Lexicographic rank of a permutation of distinct card numbers
+static u16 getPermutationRank(const std::vector<Card>& cards)
+{
+    u16 rank = 0;
+
+    for (u8 index = 0; index < cards.size(); index++)
+    {
+        u16 smallerCount = 0;
+
+        for (u8 next = index + 1; next < cards.size(); next++)
+        {
+            smallerCount += cards[next].getCardNumber() < cards[index].getCardNumber();
+        }
+
+        rank = rank * (cards.size() - index) + smallerCount;
+    }
+
+    return rank;
+}
+
+static f64 getPermutationChiSquare(const std::vector<u64>& counts, u64 shuffleCount)
+{
+    f64 expected = (f64) shuffleCount / counts.size();
+    f64 chiSquare = 0;
+
+    for (u64 count : counts)
+    {
+        chiSquare += (count - expected) * (count - expected) / expected;
+    }
+
+    return chiSquare;
+}
+
+/**
+ * Testing that every card of a single deck is equally likely at every position
+ */
+TEST(ShuffleQuality, positionBias)
+{
+    ShuffleQualityBlackjack game;
+    u64 shuffleCount = getShuffleCount(1000000);
+    std::vector<u64> counts(52 * 52, 0);
+
+    game.setRunSeed(2020);
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (u64 shuffle = 0; shuffle < shuffleCount; shuffle++)
+    {
+        game.createShoe(1);
+
+        auto& shoe = game.shuffleShoe();
+
+        for (u8 position = 0; position < 52; position++)
+        {
+            counts[getCardIndex(shoe[position]) * 52 + position]++;
+        }
+    }
+
+    std::chrono::duration<f64> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    std::cout << "Single-deck shuffles per second: " << (u64) (shuffleCount / elapsed.count()) << std::endl;
+
+    f64 expected = shuffleCount / 52.0;
+    f64 deviationLimit = 6 * std::sqrt(expected * (1 - 1 / 52.0));
+    f64 chiSquare = 0;
+    f64 maxDeviation = 0;
+
+    for (u64 count : counts)
+    {
+        chiSquare += (count - expected) * (count - expected) / expected;
+        maxDeviation = std::max(maxDeviation, std::abs(count - expected));
+    }
+
+    // Rows and columns both sum to the shuffle count
+    EXPECT_LT(chiSquare, getChiSquareLimit(51 * 51));
+    EXPECT_LT(maxDeviation, deviationLimit);
+}
+
+/**
+ * Testing that all orders of a small shoe are equally likely, and that the test catches a biased shuffle
+ */
+TEST(ShuffleQuality, permutationUniformity)
+{
+    ShuffleQualityBlackjack game;
+    u64 shuffleCount = getShuffleCount(1200000);
+    std::vector<Card> cards;
+
+    for (u8 cardNumber = 2; cardNumber <= 6; cardNumber++)
+    {
+        cards.emplace_back(cardNumber, CardSuit::heart);
+    }
+
+    game.setRunSeed(2021);
+
+    std::vector<u64> counts(120, 0);
+
+    for (u64 shuffle = 0; shuffle < shuffleCount; shuffle++)
+    {
+        game.setShoe(cards);
+        counts[getPermutationRank(game.shuffleShoe())]++;
+    }
+
+    EXPECT_LT(getPermutationChiSquare(counts, shuffleCount), getChiSquareLimit(119));
+
+    // The naive shuffle that swaps every card with any position favours some orders, the same test must reject it
+    PhiloxRng rng(2021, 0);
+
+    counts.assign(120, 0);
+
+    for (u64 shuffle = 0; shuffle < shuffleCount; shuffle++)
+    {
+        std::vector<Card> naiveCards = cards;
+
+        for (u8 index = 0; index < naiveCards.size(); index++)
+        {
+            std::swap(naiveCards[index], naiveCards[rng.nextBounded(naiveCards.size())]);
+        }
+
+        counts[getPermutationRank(naiveCards)]++;
+    }
+
+    EXPECT_GT(getPermutationChiSquare(counts, shuffleCount), getChiSquareLimit(119));
+}
+
+/**
+ * Testing that cards dealt one after another from six-deck shoes are not correlated
+ */
+TEST(ShuffleQuality, serialCorrelation)
+{
+    ShuffleQualityBlackjack game;
+    u64 shoeCount = getShuffleCount(100000);
+    const u16 shoeSize = 6 * 52;
+    const u8 maxLag = 5;
+
+    // Ranks of neighbouring cards, and the sums of value products at every lag
+    std::vector<u64> transitionCounts(13 * 13, 0);
+    f64 lagSums[maxLag + 1] = {};
+    std::vector<u8> values(shoeSize);
+    std::vector<u8> ranks(shoeSize);
+
+    game.setRunSeed(2022);
+
+    for (u64 shoe = 0; shoe < shoeCount; shoe++)
+    {
+        game.createShoe(6);
+        game.shuffleShoe();
+
+        for (u16 position = 0; position < shoeSize; position++)
+        {
+            Card* card = game.getNextCard();
+
+            values[position] = card->getCardValue();
+            ranks[position] = card->getCardNumber() - 2;
+        }
+
+        for (u16 position = 0; position + 1 < shoeSize; position++)
+        {
+            transitionCounts[ranks[position] * 13 + ranks[position + 1]]++;
+        }
+
+        for (u8 lag = 1; lag <= maxLag; lag++)
+        {
+            for (u16 position = 0; position + lag < shoeSize; position++)
+            {
+                lagSums[lag] += values[position] * values[position + lag];
+            }
+        }
+    }
+
+    // Drawing without replacement: a rank follows itself a little less often than another one
+    f64 chiSquare = 0;
+
+    for (u8 rank = 0; rank < 13; rank++)
+    {
+        for (u8 nextRank = 0; nextRank < 13; nextRank++)
+        {
+            f64 expected = shoeCount * 24.0 * (24.0 - (rank == nextRank)) / shoeSize;
+            f64 count = transitionCounts[rank * 13 + nextRank];
+
+            chiSquare += (count - expected) * (count - expected) / expected;
+        }
+    }
+
+    EXPECT_LT(chiSquare, getChiSquareLimit(12 * 12));
+
+    // Every shoe holds the same values, so their mean and variance are known exactly
+    f64 mean = 0;
+    f64 variance = 0;
+
+    for (u8 value : values)
+    {
+        mean += value;
+        variance += value * value;
+    }
+
+    mean /= shoeSize;
+    variance = variance / shoeSize - mean * mean;
+
+    for (u8 lag = 1; lag <= maxLag; lag++)
+    {
+        f64 pairCount = (f64) shoeCount * (shoeSize - lag);
+        f64 correlation = (lagSums[lag] / pairCount - mean * mean) / variance;
+
+        // For a uniformly random order the correlation at any lag is -1 / (N - 1)
+        EXPECT_NEAR(correlation, -1.0 / (shoeSize - 1), 5 / std::sqrt(pairCount)) << "lag " << (u16) lag;
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,157 @@
+#ifndef __SIDE_BET_UNIT_TEST_CPP_INCLUDED__
+#define __SIDE_BET_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <vector>
+
+#include "Card.h"
+#include "ShoeComposition.h"
+#include "PerfectPairsSideBet.h"
+#include "TwentyOnePlusThreeSideBet.h"
+#include "LuckyLadiesSideBet.h"
+
+// Expected value by enumerating every ordered deal of the player's two cards and the dealer's first cardCount cards
+f64 enumerateExpectedValue(const AbstractSideBet& sideBet, ShoeComposition composition, u8 dealerCardCount)
+{
+    std::vector<Card> cards;
+
+    for (u8 cardNumber = 2; cardNumber <= 14; cardNumber++)
+    {
+        for (u8 suit = 1; suit <= 4; suit++)
+        {
+            cards.emplace_back(cardNumber, CardSuit(suit));
+        }
+    }
+
+    f64 weightSum = 0;
+    f64 returnSum = 0;
+
+    for (auto& card1 : cards)
+    {
+        for (auto& card2 : cards)
+        {
+            for (auto& card3 : cards)
+            {
+                for (auto& card4 : cards)
+                {
+                    if (dealerCardCount == 1 && &card4 != &cards[0])
+                    {
+                        break;
+                    }
+
+                    const Card* deal[4] = {&card1, &card2, &card3, &card4};
+                    f64 weight = 1;
+                    u8 dealtCount = dealerCardCount + 2;
+
+                    // Copies of a card left when it is drawn again
+                    for (u8 index = 0; index < dealtCount; index++)
+                    {
+                        s32 count = composition.getCount(deal[index]->getCardNumber(), deal[index]->getCardSuit());
+
+                        for (u8 previous = 0; previous < index; previous++)
+                        {
+                            count -= *deal[previous] == *deal[index];
+                        }
+
+                        weight *= count > 0 ? count : 0;
+                    }
+
+                    if (weight == 0)
+                    {
+                        continue;
+                    }
+
+                    u16 payout = sideBet.getPayout(card1, card2, card3, dealerCardCount == 2 ? card4 : card3);
+
+                    weightSum += weight;
+                    returnSum += weight * (payout > 0 ? payout : -1.0);
+                }
+            }
+        }
+    }
+
+    return returnSum / weightSum;
+}
+
+/**
+ * Testing getPayout() methods
+ */
+TEST(SideBet, getPayout)
+{
+    PerfectPairsSideBet perfectPairs;
+    TwentyOnePlusThreeSideBet twentyOnePlusThree;
+    LuckyLadiesSideBet luckyLadies;
+
+    Card queenHeart(CardFace::queen, CardSuit::heart);
+    Card queenDiamond(CardFace::queen, CardSuit::diamond);
+    Card queenClub(CardFace::queen, CardSuit::club);
+    Card kingHeart(CardFace::king, CardSuit::heart);
+    Card jackHeart(CardFace::jack, CardSuit::heart);
+    Card aceSpade(CardFace::ace, CardSuit::spade);
+    Card twoSpade(2, CardSuit::spade);
+    Card threeSpade(3, CardSuit::spade);
+    Card nineSpade(9, CardSuit::spade);
+    Card fiveClub(5, CardSuit::club);
+
+    EXPECT_EQ(perfectPairs.getPayout(queenHeart, queenHeart, fiveClub, fiveClub), 25);
+    EXPECT_EQ(perfectPairs.getPayout(queenHeart, queenDiamond, fiveClub, fiveClub), 12);
+    EXPECT_EQ(perfectPairs.getPayout(queenHeart, queenClub, fiveClub, fiveClub), 6);
+    EXPECT_EQ(perfectPairs.getPayout(queenHeart, kingHeart, fiveClub, fiveClub), 0);
+
+    EXPECT_EQ(twentyOnePlusThree.getPayout(queenHeart, queenHeart, queenHeart, fiveClub), 100);
+    EXPECT_EQ(twentyOnePlusThree.getPayout(queenHeart, kingHeart, jackHeart, fiveClub), 40);
+    EXPECT_EQ(twentyOnePlusThree.getPayout(queenHeart, queenDiamond, queenClub, fiveClub), 30);
+    EXPECT_EQ(twentyOnePlusThree.getPayout(aceSpade, threeSpade, twoSpade, fiveClub), 40);
+    EXPECT_EQ(twentyOnePlusThree.getPayout(queenClub, kingHeart, aceSpade, fiveClub), 10);
+    EXPECT_EQ(twentyOnePlusThree.getPayout(nineSpade, twoSpade, aceSpade, fiveClub), 5);
+    EXPECT_EQ(twentyOnePlusThree.getPayout(kingHeart, aceSpade, twoSpade, fiveClub), 0);
+
+    EXPECT_EQ(luckyLadies.getPayout(queenHeart, queenHeart, aceSpade, kingHeart), 1000);
+    EXPECT_EQ(luckyLadies.getPayout(queenHeart, queenHeart, fiveClub, kingHeart), 125);
+    EXPECT_EQ(luckyLadies.getPayout(kingHeart, kingHeart, fiveClub, fiveClub), 19);
+    EXPECT_EQ(luckyLadies.getPayout(kingHeart, queenHeart, fiveClub, fiveClub), 9);
+    EXPECT_EQ(luckyLadies.getPayout(aceSpade, nineSpade, fiveClub, fiveClub), 9);
+    EXPECT_EQ(luckyLadies.getPayout(queenClub, queenDiamond, fiveClub, fiveClub), 4);
+    EXPECT_EQ(luckyLadies.getPayout(queenClub, nineSpade, fiveClub, fiveClub), 0);
+}
+
+/**
+ * Testing getExpectedValue() methods against an enumeration of every deal
+ */
+TEST(SideBet, getExpectedValue)
+{
+    PerfectPairsSideBet perfectPairs;
+    TwentyOnePlusThreeSideBet twentyOnePlusThree;
+    LuckyLadiesSideBet luckyLadies;
+    ShoeComposition composition;
+
+    composition.reset(2);
+
+    // A shoe short of small cards and of one queen of hearts
+    for (u8 suit = 1; suit <= 4; suit++)
+    {
+        composition.remove(Card(2, CardSuit(suit)));
+        composition.remove(Card(5, CardSuit(suit)));
+    }
+
+    composition.remove(Card(CardFace::queen, CardSuit::heart));
+    composition.remove(Card(7, CardSuit::heart));
+
+    EXPECT_EQ(composition.getTotalCount(), 94);
+    EXPECT_EQ(composition.getRankCount(2), 4);
+    EXPECT_EQ(composition.getSuitCount(CardSuit::heart), 22);
+
+    EXPECT_NEAR(perfectPairs.getExpectedValue(composition), enumerateExpectedValue(perfectPairs, composition, 1), 1e-9);
+    EXPECT_NEAR(twentyOnePlusThree.getExpectedValue(composition), enumerateExpectedValue(twentyOnePlusThree, composition, 1), 1e-9);
+    EXPECT_NEAR(luckyLadies.getExpectedValue(composition), enumerateExpectedValue(luckyLadies, composition, 2), 1e-9);
+
+    // Check the house edges of a full eight-deck shoe
+    composition.reset(8);
+
+    EXPECT_NEAR(perfectPairs.getExpectedValue(composition), -0.0410, 0.0005);
+    EXPECT_NEAR(twentyOnePlusThree.getExpectedValue(composition), -0.0370, 0.0005);
+}
+
+#endif // __SIDE_BET_UNIT_TEST_CPP_INCLUDED__
\ No newline at end of file
@@ -0,0 +1,150 @@
+#ifndef __SIMULATION_RESULT_UNIT_TEST_CPP_INCLUDED__
+#define __SIMULATION_RESULT_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "SimulationResult.h"
+
+/**
+ * Testing merge() method
+ */
+TEST(SimulationResult, merge)
+{
+    SimulationResult whole;
+    SimulationResult firstShard;
+    SimulationResult secondShard;
+
+    whole.setShoeRange(7, 0, 2);
+    firstShard.setShoeRange(7, 0, 1);
+    secondShard.setShoeRange(7, 1, 1);
+
+    // The same observations split between two shards
+    s32 netResults[] = {10, -10, 15, 0, -20, 10};
+    s8 trueCounts[] = {0, 1, -2, 12, 0, -15};
+
+    for (u8 index = 0; index < 6; index++)
+    {
+        whole.addRound();
+        whole.addHands(1, 10);
+        whole.addBoxRound(trueCounts[index], netResults[index]);
+
+        SimulationResult& shard = index < 4 ? firstShard : secondShard;
+
+        shard.addRound();
+        shard.addHands(1, 10);
+        shard.addBoxRound(trueCounts[index], netResults[index]);
+    }
+
+    SimulationResult merged;
+
+    merged.merge(secondShard);
+    merged.merge(firstShard);
+
+    // Check if merged shards are the same as one run over all shoes
+    EXPECT_EQ(merged.getSeed(), 7);
+    EXPECT_EQ(merged.getFirstShoe(), 0);
+    EXPECT_EQ(merged.getShoeCount(), 2);
+    EXPECT_EQ(merged.getRoundCount(), 6);
+    EXPECT_EQ(merged.getHandCount(), 6);
+    EXPECT_EQ(merged.getTotalBet(), 60);
+    EXPECT_EQ(merged.getNetResult(), 5);
+
+    std::ostringstream mergedSummary;
+    std::ostringstream wholeSummary;
+
+    merged.printSummary(mergedSummary);
+    whole.printSummary(wholeSummary);
+
+    EXPECT_EQ(mergedSummary.str(), wholeSummary.str());
+
+    // Check if results of different seeds are rejected
+    SimulationResult otherSeed;
+
+    otherSeed.setShoeRange(8, 2, 1);
+
+    EXPECT_THROW(merged.merge(otherSeed), std::invalid_argument);
+}
+
+/**
+ * Testing writeToFile() and readFromFile() methods
+ */
+TEST(SimulationResult, fileRoundTrip)
+{
+    const std::string path = "simulation_result_unit_test.bin";
+    SimulationResult result;
+
+    result.setShoeRange(42, 100, 50);
+    result.addRound();
+    result.addHands(2, 20);
+    result.addBoxRound(3, -20);
+    result.addBoxRound(-4, 15);
+
+    result.writeToFile(path);
+
+    SimulationResult loaded;
+
+    loaded.readFromFile(path);
+
+    std::ostringstream resultSummary;
+    std::ostringstream loadedSummary;
+
+    result.printSummary(resultSummary);
+    loaded.printSummary(loadedSummary);
+
+    // Check if every statistic survives the round trip
+    EXPECT_EQ(loaded.getSeed(), 42);
+    EXPECT_EQ(loaded.getFirstShoe(), 100);
+    EXPECT_EQ(loaded.getShoeCount(), 50);
+    EXPECT_EQ(loaded.getNetResult(), -5);
+    EXPECT_EQ(loadedSummary.str(), resultSummary.str());
+
+    // Check if a file of another format is rejected
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+        file << "not a simulation result";
+    }
+
+    EXPECT_THROW(loaded.readFromFile(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+/**
+ * Testing subtract() method
+ */
+TEST(SimulationResult, subtract)
+{
+    SimulationResult earlier;
+    SimulationResult later;
+
+    earlier.addRound();
+    earlier.addHands(1, 10);
+    earlier.addBoxRound(2, 10);
+    earlier.addAction(1);
+
+    later = earlier;
+    later.addRound();
+    later.addHands(2, 20);
+    later.addBoxRound(-3, -20);
+    later.addAction(0);
+    later.addAction(2);
+
+    later.subtract(earlier);
+
+    // Check if only the observations after the earlier state remain
+    EXPECT_EQ(later.getRoundCount(), 1);
+    EXPECT_EQ(later.getHandCount(), 2);
+    EXPECT_EQ(later.getTotalBet(), 20);
+    EXPECT_EQ(later.getBoxRoundCount(), 1);
+    EXPECT_EQ(later.getNetResult(), -20);
+    EXPECT_EQ(later.getMeanNetResult(), -20);
+}
+
+#endif // __SIMULATION_RESULT_UNIT_TEST_CPP_INCLUDED__
\ No newline at end of file
@@ -0,0 +1,141 @@
+#ifndef __SIMULATOR_UNIT_TEST_CPP_INCLUDED__
+#define __SIMULATOR_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include "EuropeanBlackjack.h"
+#include "PerfectPairsSideBet.h"
+#include "Simulator.h"
+#include "StrategyTable.h"
+
+// Player edge of the rules in percent of the total bet, simulated and as computed by StrategyTableBuilder
+struct VariantEdge
+{
+    f64 simulatedEdge = 0;
+
+    f64 tableEdge = 0;
+};
+
+static VariantEdge getVariantEdge(const BlackjackRules& rules, u64 shoeCount)
+{
+    StrategyTableData data;
+    VariantEdge edge;
+
+    StrategyTableBuilder(rules).build(data);
+
+    Simulator simulator(4, 4, 10, 42);
+
+    simulator.setRules(rules);
+    simulator.setStrategy(BasicStrategy(data));
+    simulator.run(0, shoeCount);
+
+    const SimulationResult& result = simulator.getResult();
+
+    edge.simulatedEdge = 100.0 * result.getNetResult() / result.getTotalBet();
+    edge.tableEdge = 100.0 * data.gameEv;
+
+    return edge;
+}
+
+/**
+ * Testing the variants of --compare-variants against the expected values of --strategy-table
+ */
+TEST(Simulator, variantEdges)
+{
+    BlackjackRules peekRules;
+    BlackjackRules noPeekRules;
+
+    peekRules.dealerPeeks = true;
+
+    VariantEdge peek = getVariantEdge(peekRules, 20000);
+    VariantEdge noPeek = getVariantEdge(noPeekRules, 20000);
+    VariantEdge european = getVariantEdge(EuropeanBlackjack::toEuropeanRules(noPeekRules), 20000);
+
+    // A hole card check saves the doubled and split stakes, without a hole card they are lost just the same
+    EXPECT_GT(peek.tableEdge, noPeek.tableEdge);
+    EXPECT_DOUBLE_EQ(european.tableEdge, noPeek.tableEdge);
+    EXPECT_GT(peek.simulatedEdge, noPeek.simulatedEdge);
+
+    // A six deck shoe plays a little better than the infinite deck of the tables, twenty thousand shoes are
+    // within a few tenths of a percent
+    for (auto& edge : {peek, noPeek, european})
+    {
+        EXPECT_NEAR(edge.simulatedEdge, edge.tableEdge, 0.5);
+        EXPECT_LT(edge.simulatedEdge, 0);
+    }
+}
+
+/**
+ * Testing that resume() refuses a checkpoint of other rules, strategy or side bets
+ */
+TEST(Simulator, resumeChecksConfig)
+{
+    const std::string path = "simulator_unit_test.bjck";
+    PerfectPairsSideBet sideBet;
+    BlackjackRules rules;
+
+    std::remove(path.c_str());
+
+    {
+        Simulator simulator(2, 4, 10, 42);
+
+        simulator.setRules(rules);
+        simulator.setCheckpoint(path, std::chrono::milliseconds(0));
+        simulator.run(0, 4);
+    }
+
+    BlackjackRules otherRules = rules;
+    BlackjackRules europeanRules = EuropeanBlackjack::toEuropeanRules(rules);
+    BlackjackRules otherPenetration = rules;
+
+    otherRules.blackjackPayoutNumerator = 6;
+    otherRules.blackjackPayoutDenominator = 5;
+    otherPenetration.penetration = 0.5;
+
+    for (auto& resumedRules : {otherRules, europeanRules, otherPenetration})
+    {
+        Simulator simulator(2, 4, 10, 42);
+
+        simulator.setRules(resumedRules);
+
+        EXPECT_THROW(simulator.resume(path), std::invalid_argument);
+    }
+
+    {
+        Simulator simulator(2, 4, 10, 42);
+        StrategyTableData data;
+
+        StrategyTableBuilder(rules).build(data);
+
+        simulator.setRules(rules);
+        simulator.setStrategy(BasicStrategy(data));
+
+        EXPECT_THROW(simulator.resume(path), std::invalid_argument);
+    }
+
+    {
+        Simulator simulator(2, 4, 10, 42);
+
+        simulator.setRules(rules);
+        simulator.addSideBet(&sideBet);
+
+        EXPECT_THROW(simulator.resume(path), std::invalid_argument);
+    }
+
+    // Check if the same configuration resumes
+    Simulator simulator(2, 4, 10, 42);
+
+    simulator.setRules(rules);
+
+    EXPECT_NO_THROW(simulator.resume(path));
+    EXPECT_GT(simulator.getResult().getHandCount(), 0);
+
+    std::remove(path.c_str());
+}
+
+#endif // __SIMULATOR_UNIT_TEST_CPP_INCLUDED__
\ No newline at end of file
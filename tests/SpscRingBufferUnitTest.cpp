@@ -0,0 +1,106 @@
+#ifndef __SPSC_RING_BUFFER_UNIT_TEST_CPP_INCLUDED__
+#define __SPSC_RING_BUFFER_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <thread>
+
+#include "SpscRingBuffer.h"
+
+/**
+ * Testing acquireSlot(), commitSlot(), front() and pop() methods
+ */
+TEST(SpscRingBuffer, pushPop)
+{
+    SpscRingBuffer<u32, 4> buffer;
+
+    // Check if new buffer is empty
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.front(), nullptr);
+
+    for (u32 value = 1; value <= 4; value++)
+    {
+        auto* slot = buffer.acquireSlot();
+
+        ASSERT_NE(slot, nullptr);
+
+        *slot = value;
+        buffer.commitSlot();
+    }
+
+    // Check if full buffer refuses new slots
+    EXPECT_EQ(buffer.size(), 4);
+    EXPECT_EQ(buffer.acquireSlot(), nullptr);
+
+    // Check if values come out in FIFO order
+    for (u32 value = 1; value <= 4; value++)
+    {
+        auto* slot = buffer.front();
+
+        ASSERT_NE(slot, nullptr);
+        EXPECT_EQ(*slot, value);
+
+        buffer.pop();
+    }
+
+    EXPECT_TRUE(buffer.empty());
+}
+
+/**
+ * Testing producer and consumer on different threads
+ */
+TEST(SpscRingBuffer, producerConsumer)
+{
+    SpscRingBuffer<u32, 8> buffer;
+    const u32 eventCount = 100000;
+    u64 consumedSum = 0;
+
+    std::thread consumer([&buffer, &consumedSum, eventCount]() {
+        u32 consumed = 0;
+        u32 expected = 1;
+
+        while (consumed < eventCount)
+        {
+            auto* slot = buffer.front();
+
+            if (slot == nullptr)
+            {
+                std::this_thread::yield();
+
+                continue;
+            }
+
+            // Order must be preserved across threads
+            if (*slot == expected)
+            {
+                consumedSum += *slot;
+            }
+
+            expected++;
+            consumed++;
+
+            buffer.pop();
+        }
+    });
+
+    for (u32 value = 1; value <= eventCount; value++)
+    {
+        u32* slot;
+
+        while ((slot = buffer.acquireSlot()) == nullptr)
+        {
+            std::this_thread::yield();
+        }
+
+        *slot = value;
+        buffer.commitSlot();
+    }
+
+    consumer.join();
+
+    EXPECT_EQ(consumedSum, (u64) eventCount * (eventCount + 1) / 2);
+    EXPECT_TRUE(buffer.empty());
+}
+
+#endif // __SPSC_RING_BUFFER_UNIT_TEST_CPP_INCLUDED__
\ No newline at end of file
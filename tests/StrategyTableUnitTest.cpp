@@ -0,0 +1,125 @@
+#ifndef __STRATEGY_TABLE_UNIT_TEST_CPP_INCLUDED__
+#define __STRATEGY_TABLE_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+
+#include "DecisionBatch.h"
+#include "StrategyTableFile.h"
+
+/**
+ * Testing StrategyTableBuilder::build() method
+ */
+TEST(StrategyTable, build)
+{
+    BlackjackRules rules;
+    std::unique_ptr<StrategyTableData> data(new StrategyTableData());
+
+    StrategyTableBuilder(rules).build(*data);
+
+    // Check well-known basic strategy decisions, upcard 11 is an ace
+    EXPECT_EQ(data->handTable[false][16][10] & 0x0F, hitAction);
+    EXPECT_EQ(data->handTable[false][16][6] & 0x0F, standAction);
+    EXPECT_EQ(data->handTable[false][11][6] & 0x0F, doubleAction);
+    EXPECT_EQ(data->handTable[false][11][6] >> 4, hitAction);
+    EXPECT_EQ(data->handTable[true][18][6], doubleAction | standAction << 4);
+    EXPECT_EQ(data->handTable[false][8][5] & 0x0F, hitAction);
+    EXPECT_TRUE(data->pairTable[11][6]);
+    EXPECT_TRUE(data->pairTable[8][9]);
+    EXPECT_FALSE(data->pairTable[10][6]);
+    EXPECT_FALSE(data->pairTable[5][6]);
+
+    // Standing on 20 against a 6 is a strong favourite, standing on 16 against a 10 is not
+    EXPECT_GT(data->standEv[false][20][6], 0.6);
+    EXPECT_LT(data->standEv[false][16][10], -0.5);
+
+    // The house keeps a small edge
+    EXPECT_LT(data->gameEv, 0);
+    EXPECT_GT(data->gameEv, -0.02);
+
+    // Check if a better payout for blackjack raises the game value by the blackjack chance
+    BlackjackRules evenMoneyRules;
+    std::unique_ptr<StrategyTableData> evenMoneyData(new StrategyTableData());
+
+    evenMoneyRules.blackjackPayoutNumerator = 1;
+    evenMoneyRules.blackjackPayoutDenominator = 1;
+
+    StrategyTableBuilder(evenMoneyRules).build(*evenMoneyData);
+
+    EXPECT_NE(evenMoneyRules.getHash(), rules.getHash());
+    EXPECT_LT(evenMoneyData->gameEv, data->gameEv - 0.02);
+}
+
+/**
+ * Testing StrategyTableBuilder::build() method with surrender
+ */
+TEST(StrategyTable, buildSurrender)
+{
+    BlackjackRules rules;
+    BlackjackRules lateRules;
+    BlackjackRules earlyRules;
+    std::unique_ptr<StrategyTableData> data(new StrategyTableData());
+    std::unique_ptr<StrategyTableData> lateData(new StrategyTableData());
+    std::unique_ptr<StrategyTableData> earlyData(new StrategyTableData());
+
+    lateRules.surrender = SurrenderRule::surrenderLate;
+    lateRules.dealerPeeks = true;
+    earlyRules.surrender = SurrenderRule::surrenderEarly;
+
+    StrategyTableBuilder(rules).build(*data);
+    StrategyTableBuilder(lateRules).build(*lateData);
+    StrategyTableBuilder(earlyRules).build(*earlyData);
+
+    // Hard 16 against a 10 is given up, or hit where surrender isn't offered
+    EXPECT_EQ(data->handTable[false][16][10] & 0x0F, hitAction);
+    EXPECT_EQ(lateData->handTable[false][16][10], lateSurrenderAction | hitAction << 4);
+    EXPECT_EQ(earlyData->handTable[false][16][10] & 0x0F, earlySurrenderAction);
+
+    // Hard 16 against a 6 and hard 11 against a 10 are still played on
+    EXPECT_EQ(lateData->handTable[false][16][6] & 0x0F, standAction);
+    EXPECT_EQ(lateData->handTable[false][11][10] & 0x0F, doubleAction);
+
+    // Early surrender gives up anything weak against an ace, a peeking dealer leaves half of the bet
+    EXPECT_EQ(earlyData->handTable[false][14][11] & 0x0F, earlySurrenderAction);
+    EXPECT_FLOAT_EQ(earlyData->surrenderEv[11], -0.5);
+    EXPECT_LT(lateData->surrenderEv[11], -0.5);
+    EXPECT_FLOAT_EQ(data->surrenderEv[11], -1);
+
+    // Each surrender option is worth something to the player, early more than late
+    EXPECT_GT(lateData->gameEv, data->gameEv);
+    EXPECT_GT(earlyData->gameEv, lateData->gameEv);
+}
+
+/**
+ * Testing StrategyTableFile::open() method
+ */
+TEST(StrategyTable, file)
+{
+    BlackjackRules rules;
+    std::string path = StrategyTableFile::getPath(".", rules);
+
+    std::remove(path.c_str());
+
+    // First open builds the table, the second one only maps it
+    auto builtTable = StrategyTableFile::open(".", rules);
+    auto mappedTable = StrategyTableFile::open(".", rules);
+
+    EXPECT_EQ(mappedTable->getData().rulesHash, rules.getHash());
+    EXPECT_EQ(mappedTable->getData().gameEv, builtTable->getData().gameEv);
+    EXPECT_EQ(mappedTable->getData().handTable[false][11][6], builtTable->getData().handTable[false][11][6]);
+
+    // Check if a table of other rules is rejected
+    BlackjackRules otherRules;
+
+    otherRules.dealerHitsSoft17 = true;
+
+    EXPECT_THROW(StrategyTableFile(path, otherRules), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+#endif // __STRATEGY_TABLE_UNIT_TEST_CPP_INCLUDED__
\ No newline at end of file
@@ -0,0 +1,141 @@
+#ifndef __STRUCTURED_DISPLAY_HANDLER_UNIT_TEST_CPP_INCLUDED__
+#define __STRUCTURED_DISPLAY_HANDLER_UNIT_TEST_CPP_INCLUDED__
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Application.h"
+#include "StructuredDisplayHandler.h"
+#include "DisplayMessageParamDealerCards.h"
+#include "DisplayMessageParamPlayerCards.h"
+#include "DisplayMessageParamOptions.h"
+
+#include "MockAbstractBlackjack.h"
+#include "MockInputHandler.h"
+
+struct StructuredDisplayCards
+{
+    Card ace{CardFace::ace, CardSuit::spade};
+    Card nine{9, CardSuit::club};
+    Card eight1{8, CardSuit::heart};
+    Card eight2{8, CardSuit::diamond};
+    Card king{CardFace::king, CardSuit::club};
+
+    std::vector<Card*> dealerCards = {&ace, &nine};
+
+    std::vector<std::vector<Card*>> playerCards = {{&eight1, &king}, {&eight2}};
+};
+
+static std::vector<std::vector<ADisplayMessageParam*>> createMessages(StructuredDisplayCards& cards)
+{
+    return {
+        {
+            new ADisplayMessageParam("id", "mes_id_info_dealer_cards"),
+            new DisplayMessageParamDealerCards("cards", "", cards.dealerCards, true)
+        },
+        {
+            new ADisplayMessageParam("id", "mes_id_info_player_cards"),
+            new ADisplayMessageParam("name", "Bob \"007\""),
+            new DisplayMessageParamPlayerCards("cards", "", cards.playerCards, 2)
+        },
+        {
+            new ADisplayMessageParam("id", "mes_id_info_action_menu"),
+            new DisplayMessageParamOptions("options", "1. Hit\n2. Stand\n", {"Hit", "Stand"})
+        },
+        {
+            new ADisplayMessageParam("id", "mes_id_info_game_result_win"),
+            new ADisplayMessageParam("name", "007"),
+            new ADisplayMessageParam("winCash", "150")
+        }
+    };
+}
+
+/**
+ * Testing StructuredDisplayHandler with line-delimited JSON
+ */
+TEST(StructuredDisplayHandler, json)
+{
+    std::ostringstream stream;
+    StructuredDisplayHandler displayHandler(stream, StructuredFormat::structuredJson);
+    MockAbstractBlackjack game;
+    MockInputHandler inputHandler;
+    Application app(game, inputHandler, displayHandler);
+    StructuredDisplayCards cards;
+
+    auto messageParamList = createMessages(cards);
+
+    // Entities are looked up as for the console, their templates are never used
+    for (auto messageId : {"mes_id_info_dealer_cards", "mes_id_info_player_cards", "mes_id_info_action_menu", "mes_id_info_game_result_win"})
+    {
+        app.addMessageEntity(messageId, new ADisplayEntity("unused"));
+    }
+
+    app.displayMessages(messageParamList);
+    app.displayMessage(messageParamList.back());
+
+    EXPECT_EQ(stream.str(),
+        "{\"event\":1,\"messages\":["
+            "{\"id\":\"mes_id_info_dealer_cards\",\"fields\":{\"cards\":[{\"rank\":14,\"suit\":\"spade\"},null]}},"
+            "{\"id\":\"mes_id_info_player_cards\",\"fields\":{\"name\":\"Bob \\\"007\\\"\",\"cards\":{\"currentHand\":2,\"hands\":["
+                "[{\"rank\":8,\"suit\":\"heart\"},{\"rank\":13,\"suit\":\"club\"}],[{\"rank\":8,\"suit\":\"diamond\"}]]}}},"
+            "{\"id\":\"mes_id_info_action_menu\",\"fields\":{\"options\":[\"Hit\",\"Stand\"]}},"
+            "{\"id\":\"mes_id_info_game_result_win\",\"fields\":{\"name\":\"007\",\"winCash\":150}}]}\n"
+        "{\"event\":2,\"messages\":["
+            "{\"id\":\"mes_id_info_game_result_win\",\"fields\":{\"name\":\"007\",\"winCash\":150}}]}\n");
+    EXPECT_EQ(displayHandler.getEventCount(), 2);
+
+    AbstractBlackjack::clearMessageParamList(messageParamList);
+}
+
+/**
+ * Testing StructuredDisplayHandler with binary frames
+ */
+TEST(StructuredDisplayHandler, binary)
+{
+    std::ostringstream stream;
+    StructuredDisplayHandler displayHandler(stream, StructuredFormat::structuredBinary);
+    StructuredDisplayCards cards;
+
+    auto messageParamList = createMessages(cards);
+
+    displayHandler.displayBatch({}, {messageParamList[0], messageParamList[3]});
+
+    std::string frame = stream.str();
+    u32 frameSize;
+    u64 eventNumber;
+    u16 messageCount;
+
+    ASSERT_GT(frame.size(), 14);
+
+    std::memcpy(&frameSize, frame.data(), sizeof(frameSize));
+    std::memcpy(&eventNumber, frame.data() + 4, sizeof(eventNumber));
+    std::memcpy(&messageCount, frame.data() + 12, sizeof(messageCount));
+
+    EXPECT_EQ(frameSize, frame.size() - 4);
+    EXPECT_EQ(eventNumber, 1);
+    EXPECT_EQ(messageCount, 2);
+
+    // The dealer cards are not transformed here, so the second one is still visible
+    std::string dealerMessage = std::string("\x18\0", 2) + "mes_id_info_dealer_cards" + "\x01" +
+        std::string("\x05\0", 2) + "cards" + "\x02" + "\x02" + "\x0E\x04" + "\x09\x01";
+
+    EXPECT_EQ(frame.substr(14, dealerMessage.size()), dealerMessage);
+
+    // A whole number is written as s64
+    s64 winCash;
+    u64 winCashOffset = frame.size() - sizeof(winCash);
+
+    std::memcpy(&winCash, frame.data() + winCashOffset, sizeof(winCash));
+
+    EXPECT_EQ(winCash, 150);
+    EXPECT_EQ(frame[winCashOffset - 1], StructuredFieldType::fieldInteger);
+
+    AbstractBlackjack::clearMessageParamList(messageParamList);
+}
+
+#endif // __STRUCTURED_DISPLAY_HANDLER_UNIT_TEST_CPP_INCLUDED__
\ No newline at end of file